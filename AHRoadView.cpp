@@ -20,6 +20,19 @@
    #define new DEBUG_NEW
 #endif
 
+// DPI change notifications (Windows 8.1 and Windows 10 1607)
+#ifndef WM_DPICHANGED
+   #define WM_DPICHANGED               0x02E0
+#endif
+#ifndef WM_DPICHANGED_AFTERPARENT
+   #define WM_DPICHANGED_AFTERPARENT   0x02E3
+#endif
+
+// Posted for each published road model
+static const UINT WM_RV_MODEL_PUBLISHED   = WM_APP + 1;
+// Timer running the rebuild left pending by the last AH burst when no further message comes
+static const UINT_PTR TIMER_PENDING_REBUILD = 1;
+
 // Maths constants
 static const double  PI             = 3.14159265358979;
 // Constants for Arc direction and side (lane transition)
@@ -75,6 +88,10 @@ static int     ROAD_LINES_GAP                = 2;     // Gap between continuous
 
 static int     VERTICAL_ROAD_EXTENT          = 80;    // Percentage of the Plug-in window dedicated to the road, the rest will contain the scale 
 static int     ARROW_CENTER_FROM_START       = 35;    // Position of the center of the traffic flow dir. arrows with respect to start of segment
+static DWORD   STAGE_DUMP_INTERVAL_MS        = 10000; // Period of the dump of the stage latencies in Debug mode
+static DWORD   HUD_REFRESH_MS                = 500;   // Period of the formatting of the performance overlay
+static int     HUD_LINES                     = 3;
+static int     HUD_LINE_HEIGHT               = 16;
 
 static float   m_fCrossingWidthFactorSame    = 1;     // Width factor for each possible crossing road size
 static float   m_fCrossingWidthFactorSmall   = 0.5;
@@ -140,6 +157,21 @@ CAHRoadView::CAHRoadView(const Context& ctx)
    
    // Debug Mode (prints out LinkIds on segment transition areas)
    m_bDebug               = getProfileBool(_T("Debug"),false);
+   m_szStageStatsPath     = getProfileText(_T("Stage Stats File"), _T("RoadViewStages.txt")).c_str();
+   m_bShowHud             = getProfileBool(_T("Performance HUD"), true);
+
+   // Recording of the Horizon for replays (empty = no recording)
+   m_szHorizonRecordPath  = getProfileText(_T("Horizon Record File"), _T("")).c_str();
+   if (!m_szHorizonRecordPath.IsEmpty())
+   {
+      m_recorder.open(m_szHorizonRecordPath);
+   }
+
+   // Max number of road model rebuilds per second (0 = one per AH message)
+   m_scheduler.setMaxRate(getProfileInt(_T("Max Rebuild Rate"), 10));
+
+   // Memory of the rasterized Traffic Signs, in KB
+   m_signAtlas.setMaxBytes(getProfileInt(_T("Sign Cache KB"), RVSignAtlas::DEFAULT_MAX_BYTES / 1024) * 1024);
 
    // Get INI Color parameters
    COLOR_BACK             = getProfileColor("RGB Back",     RGB(255, 255, 255));
@@ -173,6 +205,49 @@ CAHRoadView::CAHRoadView(const Context& ctx)
 
    // Load the Car bitmap from the resources
    VERIFY(carNT.LoadBitmap(IDB_NTCAR));
+
+   // Styles of the display list, and the painting elements drawing them with GDI
+   m_displayList.setStyle(RVDisplayList::STYLE_ROAD,            COLOR_ROAD,             RVStyle::PATTERN_SOLID, 1);
+   m_displayList.setStyle(RVDisplayList::STYLE_LINES,           COLOR_LINES,            RVStyle::PATTERN_SOLID, 3);
+   m_displayList.setStyle(RVDisplayList::STYLE_LINES_DASH,      COLOR_LINES,            RVStyle::PATTERN_DASH,  3);
+   m_displayList.setStyle(RVDisplayList::STYLE_ARROW,           COLOR_ARROW,            RVStyle::PATTERN_SOLID, 1);
+   m_displayList.setStyle(RVDisplayList::STYLE_COMPLEX,         COLOR_COMPLEX,          RVStyle::PATTERN_HATCH, 1);
+   m_displayList.setStyle(RVDisplayList::STYLE_AREA_ROUNDABOUT, COLOR_AREA_ROUNDABOUT,  RVStyle::PATTERN_SOLID, 1);
+   m_displayList.setStyle(RVDisplayList::STYLE_AREA_TUNNEL,     COLOR_AREA_TUNNEL,      RVStyle::PATTERN_SOLID, 1);
+   m_displayList.setStyle(RVDisplayList::STYLE_AREA_SIGNS,      COLOR_AREA_SIGNS,       RVStyle::PATTERN_SOLID, 1);
+   m_displayList.setStyle(RVDisplayList::STYLE_POLE,            COLOR_SCALE,            RVStyle::PATTERN_SOLID, 1);
+   m_displayList.setStyle(RVDisplayList::STYLE_POLE_DOTTED,     COLOR_SCALE,            RVStyle::PATTERN_DOT,   1);
+   m_displayList.setStyle(RVDisplayList::STYLE_DEBUG,           COLOR_DEBUG,            RVStyle::PATTERN_SOLID, 1);
+   m_nextDisplayList.setStyles(m_displayList);     // Laid out and diffed before being swapped in
+
+   m_gdiBackend.setPen  (RVDisplayList::STYLE_ROAD,             &penRoad);
+   m_gdiBackend.setBrush(RVDisplayList::STYLE_ROAD,             &brushRoad);
+   m_gdiBackend.setPen  (RVDisplayList::STYLE_LINES,            &penLines);
+   m_gdiBackend.setPen  (RVDisplayList::STYLE_LINES_DASH,       &penLinesDash);
+   m_gdiBackend.setPen  (RVDisplayList::STYLE_ARROW,            &penArrow);
+   m_gdiBackend.setBrush(RVDisplayList::STYLE_ARROW,            &brushArrow);
+   m_gdiBackend.setBrush(RVDisplayList::STYLE_COMPLEX,          &brushComplex);
+   m_gdiBackend.setBrush(RVDisplayList::STYLE_AREA_ROUNDABOUT,  &brushAreaRoundabout);
+   m_gdiBackend.setBrush(RVDisplayList::STYLE_AREA_TUNNEL,      &brushAreaTunnel);
+   m_gdiBackend.setBrush(RVDisplayList::STYLE_AREA_SIGNS,       &brushAreaTS);
+   m_gdiBackend.setSigns(ts);
+   m_gdiBackend.setAtlas(&m_signAtlas);
+   m_gdiBackend.setFont (&fontText);
+
+   m_pModel = NULL;
+   m_nInvalidLayers = LAYER_ALL;
+   m_nStaticLengthCM = 0;
+   m_nLayoutStartLanes = 0;
+   m_nLayoutTravelCM = 0;
+   m_nLayoutTravelEpoch = 0;
+   memset(&m_paintStats, 0, sizeof(m_paintStats));
+
+   // The extraction and paint stages are timed in Debug mode only
+   m_stageStats.setEnabled(m_bDebug != FALSE);
+   m_builder.setStageStats(&m_stageStats);
+   m_nLastStageDumpMs = GetTickCount();
+   m_hud.nLastMs = 0;
+   m_hud.nLastRebuilds = 0;
 };
 
 CAHRoadView::~CAHRoadView(void)
@@ -219,20 +294,37 @@ bool CAHRoadView::canBeDestroyed(const char* /*szPlugInTitles*/)
 // AH Listener
 
 
+// The road model is built here, where the Horizon is consistent, and handed over to OnPaint() through m_models.
+// Bursts of messages are coalesced by m_scheduler: only the newest Horizon is built, at most at the max rebuild rate.
+// A rebuild left pending by the last message of a burst is run by OnTimer(). Both hold m_rebuildLock, so that the
+// builder and the writer side of m_models are never used by two threads at once.
+
 Sint16 CAHRoadView::onClearMsg(const MASSIVE::AHClearMsg& /*msg*/)
 {
-   m_tsAreas.RemoveAll();
-   getPathInfos();
-   getTSAreas();
+   if (m_recorder.isOpen())
+   {
+      m_recorder.record(RVHorizonSnapshot::MSG_CLEAR, 0, GetTickCount(), *this);
+   }
+   std::lock_guard<std::mutex> lock(m_rebuildLock);
+   if (m_scheduler.onMessage(true, GetTickCount()))
+   {
+      rebuildModel();
+   }
    return MASSIVE::OK;
 };
 
 
 Sint16 CAHRoadView::onPositionChangedMsg(const MASSIVE::AHPositionChangedMsg& /*msg*/)
 {
-   m_tsAreas.RemoveAll();
-   getPathInfos();
-   getTSAreas();
+   if (m_recorder.isOpen())
+   {
+      m_recorder.record(RVHorizonSnapshot::MSG_POSITION_CHANGED, 0, GetTickCount(), *this);
+   }
+   std::lock_guard<std::mutex> lock(m_rebuildLock);
+   if (m_scheduler.onMessage(false, GetTickCount()))
+   {
+      rebuildModel();
+   }
    return MASSIVE::OK;
 };
 
@@ -240,24 +332,43 @@ Sint16 CAHRoadView::onRootLinkMsg(const MASSIVE::AHRootLinkMsg& msg)
 {
 	// The Root link of the Horizon has changed. The ID is in the msg
 
-   ADAS::HorizonContainer* ahc = context.ahc;
-   ADAS::HorizonLinks &hl = ahc->getLinks();
-	ADAS::HorizonLink &link = hl.getLinkById(msg.nId);
-   ADAS::HorizonAttributes&  pts = ahc->getAttributes();
-
-   m_bIsInCity = link.isInCity() ? true : false;
-
-   m_nSpeedOnRootLink = getSpeedOnLink(msg.nId, pts); // This part modified by sdrehe 05/2005 to account for ADAS Speed Limits
+   if (m_recorder.isOpen())
+   {
+      m_recorder.record(RVHorizonSnapshot::MSG_ROOT_LINK, msg.nId, GetTickCount(), *this);
+   }
+   std::lock_guard<std::mutex> lock(m_rebuildLock);
+   m_builder.setRootLink(*this, msg.nId);
    
    // Set the scale if Auto-Scale has been set in INI
    if (m_bAutoScale)
    {  
-      m_nDisplayedLengthCM = link.isInCity() ? m_nCityInScale : m_nCityOutScale;
+      m_nDisplayedLengthCM = m_builder.getModel().bIsInCity ? m_nCityInScale : m_nCityOutScale;
    }
+   publishModel();
 
    return MASSIVE::OK;
 };
 
+// Runs the pending rebuild on the current Horizon and publishes the model
+void CAHRoadView::rebuildModel()
+{
+   bool bFullRebuild = m_scheduler.beginRebuild(GetTickCount());
+   m_builder.scanHorizon(*this, bFullRebuild);
+
+   RVUpdateStats& stats = m_builder.getStats();
+   stats.nMessages = m_scheduler.getMessages();
+   stats.nRebuilds = m_scheduler.getRebuilds();
+   stats.nCoalescedMessages = m_scheduler.getCoalesced();
+   publishModel();
+};
+
+void CAHRoadView::publishModel()
+{
+   m_builder.getStats().nRepaints++;
+   m_builder.publish(m_models);
+   PostMessage(WM_RV_MODEL_PUBLISHED);
+};
+
 //////////////
 // VP Listener
 
@@ -284,8 +395,12 @@ BEGIN_MESSAGE_MAP(CAHRoadView, CEHPlugIn)
    ON_WM_SIZE()
    ON_WM_MOUSEWHEEL()
    ON_WM_DESTROY()
+   ON_WM_TIMER()
    ON_COMMAND(ID_CONFIGURE, &CAHRoadView::OnConfigure)
    ON_WM_CONTEXTMENU()
+   ON_MESSAGE(WM_DPICHANGED, &CAHRoadView::OnDpiChanged)
+   ON_MESSAGE(WM_DPICHANGED_AFTERPARENT, &CAHRoadView::OnDpiChanged)
+   ON_MESSAGE(WM_RV_MODEL_PUBLISHED, &CAHRoadView::OnModelPublished)
 END_MESSAGE_MAP()
 
 int CAHRoadView::OnCreate(LPCREATESTRUCT lpCreateStruct)
@@ -293,13 +408,15 @@ int CAHRoadView::OnCreate(LPCREATESTRUCT lpCreateStruct)
    if (CEHPlugIn::OnCreate(lpCreateStruct) == -1)
       return -1;
 
-   m_bIsInCity = false;
-   m_bIsCurrentSpeed = false;
    m_nDisplayedLengthCM = m_bAutoScale ? m_nCityOutScale : 100000;
-   m_nStartNbOfLanes = 1;
    m_nLineLength = 7;
    m_nLineGapLength = 10;
-   m_nMaxLanes = 1;
+
+   // Rebuilds left pending by the rate limit
+   if (m_scheduler.getMinIntervalMs() > 0)
+   {
+      SetTimer(TIMER_PENDING_REBUILD, m_scheduler.getMinIntervalMs(), NULL);
+   }
 
    return 0;
 };
@@ -307,12 +424,135 @@ int CAHRoadView::OnCreate(LPCREATESTRUCT lpCreateStruct)
 
 void CAHRoadView::OnDestroy()
 {
+   KillTimer(TIMER_PENDING_REBUILD);
+   m_staticLayer.release();
+   m_frameLayer.release();
+   m_signAtlas.clear();
+   m_gdiBackend.releaseObjects();
    CEHPlugIn::OnDestroy();
 };
 
 void CAHRoadView::OnSize(UINT nType, int cx, int cy)
 {
    CEHPlugIn::OnSize(nType, cx, cy);
+   m_staticLayer.release();         // Recreated with the new size by the next paint
+   m_frameLayer.release();
+   m_arcCache.clear();              // New lane width
+   m_gdiBackend.releaseObjects();   // Pens of the sign poles, sized by the window
+};
+
+// Runs the rebuild left pending by the last AH burst once the min interval has elapsed, from the newest Horizon
+void CAHRoadView::OnTimer(UINT_PTR nIDEvent)
+{
+   if (nIDEvent != TIMER_PENDING_REBUILD)
+   {
+      CEHPlugIn::OnTimer(nIDEvent);
+      return;
+   }
+   std::lock_guard<std::mutex> lock(m_rebuildLock);
+   if (m_scheduler.isDue(GetTickCount()))
+   {
+      rebuildModel();
+   }
+};
+
+LRESULT CAHRoadView::OnDpiChanged(WPARAM /*wParam*/, LPARAM /*lParam*/)
+{
+   m_staticLayer.release();
+   m_frameLayer.release();
+   m_arcCache.clear();
+   m_gdiBackend.releaseObjects();
+   m_signAtlas.clear();             // Sprites compatible with the window at the old DPI
+   invalidateLayers(LAYER_ALL);
+   return 0;
+};
+
+// Lays the new road model out and invalidates only the rectangles where it is painted differently than the frame
+// layer. The layout is kept for the next paint, which re-renders the frame layer in these rectangles only.
+// When the car has driven a few pixels along the same path, the road strip of the frame layer is scrolled by them
+// first: the previous layout is moved as well, so that only what did not move with the road (and the band scrolled
+// in, and the hatched fills) is painted again.
+LRESULT CAHRoadView::OnModelPublished(WPARAM /*wParam*/, LPARAM /*lParam*/)
+{
+   // Already picked up by a paint
+   if (!m_models.hasNewModel())
+   {
+      return 0;
+   }
+
+   CRect rect;
+   GetClientRect(rect);
+   CSize size = rect.Size();
+   m_paintStats.nModelUpdates++;
+
+   // A whole repaint is due anyway: the model is laid out by the paint
+   if (!m_frameLayer.isValid() || !m_staticLayer.isValid() || (m_nInvalidLayers != 0) ||
+       (m_frameLayer.getSize() != size) || (m_nStaticLengthCM != m_nDisplayedLengthCM))
+   {
+      Invalidate();
+      return 0;
+   }
+
+   int wCar = getCarWidth(size);
+   int nPreviousStartLanes = m_nLayoutStartLanes;
+   Sint32 nPreviousTravelCM = m_nLayoutTravelCM;
+   Uint32 nPreviousTravelEpoch = m_nLayoutTravelEpoch;
+   layoutDynamicLayer(m_nextDisplayList, size, wCar);
+
+   CRect rectStrip = getRoadStrip(size, wCar);
+   int dx = MulDiv(nPreviousTravelCM, rectStrip.Width(), m_nDisplayedLengthCM) - MulDiv(m_nLayoutTravelCM, rectStrip.Width(), m_nDisplayedLengthCM);
+   if ((m_nLayoutTravelEpoch == nPreviousTravelEpoch) && (dx != 0) && (abs(dx) < rectStrip.Width() / 2))
+   {
+      RVRect strip = { rectStrip.left, rectStrip.top, rectStrip.right, rectStrip.bottom };
+      m_frameLayer.getDC().ScrollDC(dx, 0, rectStrip, rectStrip, NULL, NULL);
+      m_dirtyRegion.scroll(strip, dx);
+      m_dirtyRegion.addChanges(m_displayList, m_nextDisplayList, strip, false);
+      m_displayList.translate(dx);
+      m_dirtyRegion.addChanges(m_displayList, m_nextDisplayList, strip, true);
+      m_dirtyRegion.addHatched(m_displayList, strip);
+      RVRect rectExposed = strip;              // Band scrolled in, not painted yet
+      if (dx < 0)
+      {
+         rectExposed.nLeft = strip.nRight + dx;
+      }
+      else
+      {
+         rectExposed.nRight = strip.nLeft + dx;
+      }
+      m_dirtyRegion.add(rectExposed);
+      InvalidateRect(rectStrip, FALSE);       // The scrolled strip is blitted by the next paint
+      m_paintStats.nScrolls++;
+   }
+   else
+   {
+      m_dirtyRegion.addChanges(m_displayList, m_nextDisplayList);
+   }
+   m_displayList.swap(m_nextDisplayList);
+
+   // The car (its position follows the number of lanes) and the debug counters are not in the display list
+   if (m_nLayoutStartLanes != nPreviousStartLanes)
+   {
+      RVRect rectCar = { MARGIN_LEFT, 0, MARGIN_LEFT + wCar, size.cy };
+      m_dirtyRegion.add(rectCar);
+   }
+   if (m_bDebug)
+   {
+      RVRect rectDebug = { 0, size.cy - MARGIN_BOTTOM - 4 * 16, size.cx, size.cy };   // The 4 lines of paintDebugStats()
+      m_dirtyRegion.add(rectDebug);
+      if (m_bShowHud)
+      {
+         RVRect rectHud = { 0, MARGIN_TOP, size.cx, MARGIN_TOP + HUD_LINES * HUD_LINE_HEIGHT };
+         m_dirtyRegion.add(rectHud);
+      }
+   }
+   m_dirtyRegion.clip(size.cx, size.cy);
+
+   for (size_t i = 0; i < m_dirtyRegion.getSize(); i++)
+   {
+      const RVRect& rectDirty = m_dirtyRegion.getRect(i);
+      InvalidateRect(CRect(rectDirty.nLeft, rectDirty.nTop, rectDirty.nRight, rectDirty.nBottom), FALSE);
+   }
+   return 0;
 };
 
 BOOL CAHRoadView::OnEraseBkgnd(CDC* pDC)
@@ -323,21 +563,46 @@ BOOL CAHRoadView::OnEraseBkgnd(CDC* pDC)
 
 void CAHRoadView::OnPaint()
 {
+   LARGE_INTEGER nStart;
+   QueryPerformanceCounter(&nStart);
+
    CPaintDC dc(this);
    CRect rect;
    GetClientRect(rect);
    CSize size = rect.Size();
 
-   CDC dcMem;
-   dcMem.CreateCompatibleDC(&dc);
-      CBitmap bitmap; 
-      bitmap.CreateCompatibleBitmap(&dc, size.cx, size.cy);
-         CBitmap* pOldBitmap = dcMem.SelectObject(&bitmap);
-            paintAll(dcMem, size);
-            dc.BitBlt(0, 0, size.cx, size.cy, &dcMem, 0, 0, SRCCOPY);
-         dcMem.SelectObject(pOldBitmap);
-      bitmap.DeleteObject();
-   dcMem.DeleteDC();
+   // The layers are kept from one paint to the next, only the invalid ones (or parts) are painted again.
+   // Only the invalidated part of the window is blitted.
+   paintAll(dc, size);
+   CRect rectPaint(dc.m_ps.rcPaint);
+   dc.BitBlt(rectPaint.left, rectPaint.top, rectPaint.Width(), rectPaint.Height(), &m_frameLayer.getDC(), rectPaint.left, rectPaint.top, SRCCOPY);
+
+   // Frame time (shown in Debug mode with the next frame)
+   LARGE_INTEGER nEnd;
+   LARGE_INTEGER nFrequency;
+   QueryPerformanceCounter(&nEnd);
+   QueryPerformanceFrequency(&nFrequency);
+   m_paintStats.fLastMs = (double) (nEnd.QuadPart - nStart.QuadPart) * 1000.0 / (double) nFrequency.QuadPart;
+   m_paintStats.fAvgMs = (m_paintStats.nFrames == 0) ? m_paintStats.fLastMs : (0.9 * m_paintStats.fAvgMs + 0.1 * m_paintStats.fLastMs);
+   m_paintStats.nFrames++;
+
+   // Stage latencies, dumped periodically to compare drives
+   if (m_stageStats.isEnabled())
+   {
+      m_stageStats.record(RVStageStats::STAGE_FRAME, (Uint32) (m_paintStats.fLastMs * 1000.0), 0);
+      DWORD nNowMs = GetTickCount();
+      if (!m_szStageStatsPath.IsEmpty() && (nNowMs - m_nLastStageDumpMs >= STAGE_DUMP_INTERVAL_MS))
+      {
+         m_stageStats.dump(m_szStageStatsPath);
+         m_nLastStageDumpMs = nNowMs;
+      }
+   }
+};
+
+void CAHRoadView::invalidateLayers(UINT nLayers)
+{
+   m_nInvalidLayers |= nLayers;
+   Invalidate();
 };
 
 // Changes the scale length which is used in paintScale(), called in turn by paintAll() which is called by OnPaint()
@@ -353,7 +618,7 @@ BOOL CAHRoadView::OnMouseWheel(UINT /*nFlags*/, short zDelta, CPoint /*pt*/)
       m_nDisplayedLengthCM += 10000; 
    };
    
-   Invalidate();
+   invalidateLayers(LAYER_ALL);     // The road is scaled as well
    return TRUE;
 };
 
@@ -361,19 +626,251 @@ BOOL CAHRoadView::OnMouseWheel(UINT /*nFlags*/, short zDelta, CPoint /*pt*/)
 ///////////
 // Painting
 
+// The static layer is only painted again if it is invalid or the scale has changed (the scale may be set by the
+// Auto-Scale in the AH listener). The frame layer is a copy of the static layer with the dynamic layer painted over
+// it: it is painted again as a whole if one of them is invalid, else only in the dirty region left by the new road
+// models (see OnModelPublished()). A paint without any change (window uncovered) only blits the frame layer.
 void CAHRoadView::paintAll(CDC& dc, const CSize& sizeCanvas)
+{
+   if (m_nInvalidLayers & LAYER_STATIC)
+   {
+      m_staticLayer.invalidate();
+   }
+   if (m_nInvalidLayers & LAYER_DYNAMIC)
+   {
+      m_frameLayer.invalidate();
+   }
+   m_nInvalidLayers = 0;
+
+   int wCar = getCarWidth(sizeCanvas);
+
+   bool bStaticChanged = m_staticLayer.prepare(dc, sizeCanvas) || !m_staticLayer.isValid() || (m_nStaticLengthCM != m_nDisplayedLengthCM);
+   if (bStaticChanged)
+   {
+      m_staticLayer.beginRender();
+      paintStaticLayer(m_staticLayer.getDC(), sizeCanvas, wCar);
+      m_staticLayer.endRender();
+      m_nStaticLengthCM = m_nDisplayedLengthCM;
+   }
+   else
+   {
+      m_staticLayer.countHit();
+   }
+
+   if (m_frameLayer.prepare(dc, sizeCanvas) || !m_frameLayer.isValid() || bStaticChanged)
+   {
+      m_frameLayer.beginRender();
+      layoutDynamicLayer(m_displayList, sizeCanvas, wCar);
+      renderFrameLayer(sizeCanvas, NULL);
+      m_frameLayer.endRender();
+      m_dirtyRegion.clear();
+      m_paintStats.fRepaintedPixels += (double) sizeCanvas.cx * sizeCanvas.cy;
+   }
+   else if (!m_dirtyRegion.isEmpty())
+   {
+      m_frameLayer.beginRender();
+      renderFrameLayer(sizeCanvas, &m_dirtyRegion);
+      m_frameLayer.endRender();
+      m_paintStats.fRepaintedPixels += m_dirtyRegion.getArea();
+      m_dirtyRegion.clear();
+   }
+   else
+   {
+      m_frameLayer.countHit();
+   }
+};
+
+// Paints the static layer and the dynamic layer over it into the frame layer, clipped to the region if given
+void CAHRoadView::renderFrameLayer(const CSize& sizeCanvas, const RVDirtyRegion* pRegion)
+{
+   CDC& dcFrame = m_frameLayer.getDC();
+   CRgn rgnClip;
+   if (pRegion != NULL)
+   {
+      rgnClip.CreateRectRgn(0, 0, 0, 0);
+      for (size_t i = 0; i < pRegion->getSize(); i++)
+      {
+         const RVRect& rect = pRegion->getRect(i);
+         CRgn rgnRect;
+         rgnRect.CreateRectRgn(rect.nLeft, rect.nTop, rect.nRight, rect.nBottom);
+         rgnClip.CombineRgn(&rgnClip, &rgnRect, RGN_OR);
+      }
+      dcFrame.SelectClipRgn(&rgnClip);
+   }
+
+   dcFrame.BitBlt(0, 0, sizeCanvas.cx, sizeCanvas.cy, &m_staticLayer.getDC(), 0, 0, SRCCOPY);
+   paintDynamicLayer(dcFrame, sizeCanvas);
+
+   if (pRegion != NULL)
+   {
+      dcFrame.SelectClipRgn(NULL);
+   }
+};
+
+void CAHRoadView::paintStaticLayer(CDC& dc, const CSize& sizeCanvas, int wCar)
 {
    paintBackground(dc, sizeCanvas);
-   int wCar = paintCar(dc, sizeCanvas);
    paintScale(dc, sizeCanvas, wCar);
-   
-   if (paintRoad(dc, sizeCanvas, wCar))
+};
+
+// Lays the latest road model out into the display list. The model is not modified by the AH listener until the next
+// acquire().
+void CAHRoadView::layoutDynamicLayer(RVDisplayList& dl, const CSize& sizeCanvas, int wCar)
+{
+   m_pModel = &m_models.acquire();
+   m_nLayoutStartLanes = m_pModel->nStartNbOfLanes;
+   m_nLayoutTravelCM = m_pModel->nTravelCM;
+   m_nLayoutTravelEpoch = m_pModel->nTravelEpoch;
+
+   RVStageTimer timer(&m_stageStats, RVStageStats::STAGE_LAYOUT);
+   dl.clear();
+   paintRootLinkSigns(dl, sizeCanvas, wCar);
+   bool bRoad;
    {
-      paintSigns(dc, sizeCanvas, wCar);
+      RVStageTimer timerRoad(&m_stageStats, RVStageStats::STAGE_PAINT_ROAD);
+      size_t nFirst = dl.getSize();
+      bRoad = paintRoad(dl, sizeCanvas, wCar);
+      timerRoad.addItems((Uint32) (dl.getSize() - nFirst));
+   }
+   if (bRoad)
+   {
+      RVStageTimer timerSigns(&m_stageStats, RVStageStats::STAGE_PAINT_SIGNS);
+      size_t nFirst = dl.getSize();
+      paintSigns(dl, sizeCanvas, wCar);
+      timerSigns.addItems((Uint32) (dl.getSize() - nFirst));
    };
-  
+   timer.addItems((Uint32) dl.getSize());
 };
 
+void CAHRoadView::paintDynamicLayer(CDC& dc, const CSize& sizeCanvas)
+{
+   paintCar(dc, sizeCanvas);
+   {
+      RVStageTimer timer(&m_stageStats, RVStageStats::STAGE_REPLAY);
+      timer.addItems((Uint32) m_displayList.getSize());
+      m_gdiBackend.replay(dc, m_displayList);
+   }
+
+   if (m_bDebug)
+   {
+      paintDebugStats(dc, sizeCanvas);
+      if (m_bShowHud)
+      {
+         paintHud(dc, sizeCanvas);
+      }
+   }
+};
+
+// In Debug mode, show how the road model has been updated (full rebuilds vs. incremental updates) and painted.
+// The counters are those of the frame being painted, they are updated with the next road model.
+void CAHRoadView::paintDebugStats(CDC& dc, const CSize& sizeCanvas)
+{
+   const RVLayer::Stats& staticStats = m_staticLayer.getStats();
+   const RVLayer::Stats& frameStats = m_frameLayer.getStats();
+
+   CString szStats;
+   szStats.Format(_T("full %u / incr %u (classified %u, reused %u) - links %u hits / %u misses"), m_pModel->stats.nFullRebuilds, m_pModel->stats.nIncrementalUpdates,
+                  m_pModel->stats.nClassifiedAttrs, m_pModel->stats.nReusedAttrs, m_pModel->stats.nLinkCacheHits, m_pModel->stats.nLinkCacheMisses);
+   CString szMessages;
+   szMessages.Format(_T("msgs %u / rebuilds %u / coalesced %u / repaints %u - paint %.2f ms (avg %.2f ms) at %dx%d - %u primitives / %u GDI calls / %u selects / %u new objects"),
+                     m_pModel->stats.nMessages, m_pModel->stats.nRebuilds, m_pModel->stats.nCoalescedMessages, m_pModel->stats.nRepaints,
+                     m_paintStats.fLastMs, m_paintStats.fAvgMs, sizeCanvas.cx, sizeCanvas.cy,
+                     (Uint32) m_displayList.getSize(), m_gdiBackend.getStats().nCalls, m_gdiBackend.getStats().nSelects, m_gdiBackend.getStats().nCreated);
+   CString szLayers;
+   szLayers.Format(_T("static %u renders / %u hits (%.2f ms) - dynamic %u renders / %u hits (%.2f ms) - %u surfaces - %u px / update - %u scrolls"),
+                   staticStats.nRenders, staticStats.nHits, staticStats.fLastRenderMs,
+                   frameStats.nRenders, frameStats.nHits, frameStats.fLastRenderMs,
+                   staticStats.nSurfaces + frameStats.nSurfaces,
+                   (m_paintStats.nModelUpdates > 0) ? (Uint32) (m_paintStats.fRepaintedPixels / m_paintStats.nModelUpdates) : 0,
+                   m_paintStats.nScrolls);
+   const RVSignAtlas::Stats& signStats = m_signAtlas.getStats();
+   Uint32 nSignDraws = signStats.nHits + signStats.nMisses;
+   CString szSigns;
+   szSigns.Format(_T("signs %u hits / %u misses (%u%%) - %u sprites / %u evicted - %u of %u KB"),
+                  signStats.nHits, signStats.nMisses, (nSignDraws > 0) ? (Uint32) ((100.0 * signStats.nHits) / nSignDraws) : 0,
+                  signStats.nSprites, signStats.nEvictions, signStats.nBytes / 1024, m_signAtlas.getMaxBytes() / 1024);
+   CRect rectStats(0, sizeCanvas.cy - MARGIN_BOTTOM - 16, sizeCanvas.cx - MARGIN_RIGHT, sizeCanvas.cy);
+   CRect rectMessages(rectStats);
+   rectMessages.OffsetRect(0, -16);
+   CRect rectLayers(rectMessages);
+   rectLayers.OffsetRect(0, -16);
+   CRect rectSigns(rectLayers);
+   rectSigns.OffsetRect(0, -16);
+   CFont* pOldFont = dc.SelectObject(&fontScale);
+      COLORREF OldColor = dc.SetTextColor(COLOR_DEBUG);
+         dc.DrawText(szStats, rectStats, DT_RIGHT | DT_BOTTOM | DT_SINGLELINE);
+         dc.DrawText(szMessages, rectMessages, DT_RIGHT | DT_BOTTOM | DT_SINGLELINE);
+         dc.DrawText(szLayers, rectLayers, DT_RIGHT | DT_BOTTOM | DT_SINGLELINE);
+         dc.DrawText(szSigns, rectSigns, DT_RIGHT | DT_BOTTOM | DT_SINGLELINE);
+      dc.SetTextColor(OldColor);
+   dc.SelectObject(pOldFont);
+};
+
+
+// The road and the signs above it, between the car and the right margin, above the scale. Only the background of the
+// static layer is under it, which looks the same once scrolled.
+CRect CAHRoadView::getRoadStrip(const CSize& sizeCanvas, int wCar)
+{
+   int xRoad = MARGIN_LEFT + wCar + CAR_ROAD_GAP;
+   int yScale = min((int) (sizeCanvas.cy * (VERTICAL_ROAD_EXTENT / 100.0)), sizeCanvas.cy - 30);   // Same place as in paintScale()
+   return CRect(xRoad, 0, sizeCanvas.cx - MARGIN_RIGHT, yScale);
+};
+
+// The performance overlay is drawn for each frame, but only formatted again every HUD_REFRESH_MS: it costs three
+// DrawText() per frame.
+void CAHRoadView::paintHud(CDC& dc, const CSize& sizeCanvas)
+{
+   DWORD nNowMs = GetTickCount();
+   if (m_hud.szLines[0].IsEmpty() || (nNowMs - m_hud.nLastMs >= HUD_REFRESH_MS))
+   {
+      updateHud(nNowMs);
+   }
+   CRect rectLine(MARGIN_LEFT, MARGIN_TOP, sizeCanvas.cx - MARGIN_RIGHT, MARGIN_TOP + HUD_LINE_HEIGHT);
+   CFont* pOldFont = dc.SelectObject(&fontScale);
+      COLORREF OldColor = dc.SetTextColor(COLOR_DEBUG);
+      int nOldBkMode = dc.SetBkMode(TRANSPARENT);
+         for (int i = 0; i < HUD_LINES; i++)
+         {
+            dc.DrawText(m_hud.szLines[i], rectLine, DT_LEFT | DT_TOP | DT_SINGLELINE);
+            rectLine.OffsetRect(0, HUD_LINE_HEIGHT);
+         }
+      dc.SetBkMode(nOldBkMode);
+      dc.SetTextColor(OldColor);
+   dc.SelectObject(pOldFont);
+};
+
+// Frame and extraction times from the stage latencies, rebuild rate, size of the model and hit rates of the caches
+void CAHRoadView::updateHud(DWORD nNowMs)
+{
+   RVStageStats::Summary frame = m_stageStats.getSummary(RVStageStats::STAGE_FRAME);
+   RVStageStats::Summary scan = m_stageStats.getSummary(RVStageStats::STAGE_SCAN_HORIZON);
+   const RVUpdateStats& stats = m_pModel->stats;
+
+   double fRebuildsPerS = 0.0;
+   if ((m_hud.nLastMs != 0) && (nNowMs != m_hud.nLastMs))
+   {
+      fRebuildsPerS = (stats.nRebuilds - m_hud.nLastRebuilds) * 1000.0 / (nNowMs - m_hud.nLastMs);
+   }
+   m_hud.nLastMs = nNowMs;
+   m_hud.nLastRebuilds = stats.nRebuilds;
+
+   const RVSignAtlas::Stats& signStats = m_signAtlas.getStats();
+   Uint32 nLinks = stats.nLinkCacheHits + stats.nLinkCacheMisses;
+   Uint32 nAttrs = stats.nReusedAttrs + stats.nClassifiedAttrs;
+   Uint32 nSigns = signStats.nHits + signStats.nMisses;
+   Uint32 nArcs = m_arcCache.getHits() + m_arcCache.getMisses();
+
+   m_hud.szLines[0].Format(_T("frame %.2f ms (avg %.2f, p95 %.2f, max %.2f) - extraction p50 %.2f / p95 %.2f ms"),
+                           m_paintStats.fLastMs, m_paintStats.fAvgMs, frame.nP95Us / 1000.0, frame.nMaxUs / 1000.0,
+                           scan.nP50Us / 1000.0, scan.nP95Us / 1000.0);
+   m_hud.szLines[1].Format(_T("%.1f rebuilds/s - %u attributes - %u signs - %u TS areas"),
+                           fRebuildsPerS, stats.nAttributes, (Uint32) m_pModel->signs.size(), (Uint32) m_pModel->tsAreas.size());
+   m_hud.szLines[2].Format(_T("hits: links %u%% - TS classes %u%% - sprites %u%% - arcs %u%%"),
+                           (nLinks > 0) ? (Uint32) ((100.0 * stats.nLinkCacheHits) / nLinks) : 0,
+                           (nAttrs > 0) ? (Uint32) ((100.0 * stats.nReusedAttrs) / nAttrs) : 0,
+                           (nSigns > 0) ? (Uint32) ((100.0 * signStats.nHits) / nSigns) : 0,
+                           (nArcs > 0) ? (Uint32) ((100.0 * m_arcCache.getHits()) / nArcs) : 0);
+};
 
 void CAHRoadView::paintBackground(CDC& dc, const CSize& sizeCanvas)
 {
@@ -399,7 +896,7 @@ int CAHRoadView::paintCar(CDC& dc, const CSize& sizeCanvas)
       int h1 = bitmap.bmHeight;
       if (sizeCanvas.cx > w * 3)
       {
-         y = nRoadCenter - (h1/2) + (m_nStartNbOfLanes * nLaneWidth / 2);
+         y = nRoadCenter - (h1/2) + (m_pModel->nStartNbOfLanes * nLaneWidth / 2);
          CDC memDC;
          memDC.CreateCompatibleDC(&dc);
             CBitmap* pOldBitmap = memDC.SelectObject(&car);
@@ -412,6 +909,16 @@ int CAHRoadView::paintCar(CDC& dc, const CSize& sizeCanvas)
    return 0;
 };
 
+int CAHRoadView::getCarWidth(const CSize& sizeCanvas)
+{
+   BITMAP bitmap;
+   if ((carNT.GetBitmap(&bitmap) != 0) && (sizeCanvas.cx > bitmap.bmWidth * 3))
+   {
+      return bitmap.bmWidth;
+   }
+   return 0;
+};
+
 void CAHRoadView::paintScale(CDC& dc, const CSize& sizeCanvas, int wCar)
 {
    int xScale = MARGIN_LEFT + wCar + CAR_ROAD_GAP;
@@ -439,26 +946,33 @@ void CAHRoadView::paintScale(CDC& dc, const CSize& sizeCanvas, int wCar)
       dc.DrawText(szCenter,  rectText, DT_CENTER  | DT_TOP);
       dc.DrawText(szZero,  rectText, DT_LEFT  | DT_TOP);
    dc.SelectObject(pOldFont);
+};
+
+void CAHRoadView::paintRootLinkSigns(RVDisplayList& dl, const CSize& sizeCanvas, int wCar)
+{
+   int yScale = min((int) (sizeCanvas.cy * (VERTICAL_ROAD_EXTENT / 100.0)), sizeCanvas.cy - 30);   // Same place as in paintScale()
+   int hScale = (int) (sizeCanvas.cy * ((100.0 - VERTICAL_ROAD_EXTENT) / 200.0) - MARGIN_BOTTOM);
+   hScale = max(hScale,15);
 
    // Paint the City Sign on the left of the Scale if appropriate
-   if (m_bIsInCity)
+   if (m_pModel->bIsInCity)
    {
-      ts->draw(&dc, CRect(CPoint(MARGIN_LEFT, yScale), CSize(wCar, 2*hScale)), TrafficSign::tsUrbanArea, 0, 0, false); // tsCityBW 
+      dl.sign(MARGIN_LEFT, yScale, MARGIN_LEFT + wCar, yScale + 2*hScale, TrafficSign::tsUrbanArea, 0, 0, false); // tsCityBW 
    }
 
    // In Debug mode, paint the Speed Limit Sign of the Root Link on the top left. Speed Limit corresponds to ADAS Speed if available.
-   if ((m_nSpeedOnRootLink > 0) && (m_bShowSpeed))
+   if ((m_pModel->nSpeedOnRootLink > 0) && (m_bShowSpeed))
    {
-      TrafficSign::Sign speedSign = (m_nSpeedOnRootLink < 997) ?
-            (m_bIsCurrentSpeed ? TrafficSign::tsSpeedLimit : TrafficSign::tsExpectedSpeedLimit) :
+      TrafficSign::Sign speedSign = (m_pModel->nSpeedOnRootLink < 997) ?
+            (m_pModel->bIsCurrentSpeed ? TrafficSign::tsSpeedLimit : TrafficSign::tsExpectedSpeedLimit) :
             TrafficSign::tsSpeedLimitEnd;
-      ts->draw(&dc, CRect(CPoint(MARGIN_LEFT, MARGIN_TOP), CSize(wCar, int(2.5*hScale))), speedSign, m_nSpeedOnRootLink, 0, false);
-      //CString szADAS = m_bIsCurrentSpeed ? (_T("Current")) : (_T("Expctd"));
+      dl.sign(MARGIN_LEFT, MARGIN_TOP, MARGIN_LEFT + wCar, MARGIN_TOP + int(2.5*hScale), speedSign, m_pModel->nSpeedOnRootLink, 0, false);
+      //CString szADAS = m_pModel->bIsCurrentSpeed ? (_T("Current")) : (_T("Expctd"));
       //dc.DrawText(szADAS, CRect(CPoint(MARGIN_LEFT, MARGIN_TOP + int(2.5*hScale)), CSize(wCar, hScale)) , DT_CENTER  | DT_TOP);
    }
 };
 
-bool CAHRoadView::paintRoad(CDC& dc, const CSize& sizeCanvas, int wCar)
+bool CAHRoadView::paintRoad(RVDisplayList& dl, const CSize& sizeCanvas, int wCar)
 {
    int   xRoad     = MARGIN_LEFT + wCar + CAR_ROAD_GAP;
    int   yRoad     = (int) (sizeCanvas.cy * ((VERTICAL_ROAD_EXTENT / 100.0) / 4.0));
@@ -471,8 +985,8 @@ bool CAHRoadView::paintRoad(CDC& dc, const CSize& sizeCanvas, int wCar)
    
    int   nPreviousTransitionWidthPixels   = 0;
    int   nNextTransitionWidthPixels       = 0;
-   int   nNextNbOfLanes                   = m_nStartNbOfLanes;            // We got the start nb of lanes from getPathInfos()
-   int   nCurrentNbOfLanes                = m_nStartNbOfLanes;
+   int   nNextNbOfLanes                   = m_pModel->nStartNbOfLanes;            // We got the start nb of lanes from getPathInfos()
+   int   nCurrentNbOfLanes                = m_pModel->nStartNbOfLanes;
    bool  bThereWasALaneChange             = false;
    float fNextSizeOfCrossing              = 0.0;
    float fPreviousSizeOfCrossing          = 0.0;
@@ -483,33 +997,33 @@ bool CAHRoadView::paintRoad(CDC& dc, const CSize& sizeCanvas, int wCar)
    // paint the Areas rectangles first (in the background of the Road)
    if (m_bShowTunnels || m_bShowRoundabouts)
    {
-      paintAreas(dc, rectRoad, m_areas);
+      paintAreas(dl, rectRoad, m_pModel->areas);
    }
-   paintAreas(dc, rectRoad, m_tsAreas);
+   paintAreas(dl, rectRoad, m_pModel->tsAreas);
       
    // Paint the road segments using the signs info in RVSign vector. Each segment is painted together with the transition following it.
-   for (int i = 0;  i < (int) m_signs.GetSize();  i++)     // loop over the conditions/signs along the MPP
+   for (int i = 0;  i < (int) m_pModel->signs.size();  i++)     // loop over the conditions/signs along the MPP
    {
       // Get the nb of Lanes and crossing info
-      nNextNbOfLanes       = m_signs[i].getSignLanesParam();
-      fNextSizeOfCrossing  = m_signs[i].getSizeOfCrossing();
+      nNextNbOfLanes       = m_pModel->signs[i].getSignLanesParam();
+      fNextSizeOfCrossing  = m_pModel->signs[i].getSizeOfCrossing();
       
       // Get the crossing side (left, right, or both)
-      RVSign::CrossingSideType nCrossingSide = m_signs[i].getCrossingSide();
+      RVSign::CrossingSideType nCrossingSide = m_pModel->signs[i].getCrossingSide();
 
       // Get the prohibited (wrong-way) sides
-      RVSign::ProhibitedSideType nProhibitedSide = m_signs[i].getProhibitedSide();
+      RVSign::ProhibitedSideType nProhibitedSide = m_pModel->signs[i].getProhibitedSide();
 
       // Get the LinkId of the Sign attribute. The LinkId applies to the Link after.
-      Uint32 nLinkId = m_signs[i].getLinkId();
+      Uint32 nLinkId = m_pModel->signs[i].getLinkId();
 
       // SET LEFT SEGMENT LIMITS
       if (i > 0)
       {
-         nCurrentNbOfLanes = m_signs[i-1].getSignLanesParam();
-         nDistanceToPreviousSignPixels = MulDiv(m_signs[i-1].getDistanceToSignM()*100, rectRoad.Width(), m_nDisplayedLengthCM);
+         nCurrentNbOfLanes = m_pModel->signs[i-1].getSignLanesParam();
+         nDistanceToPreviousSignPixels = MulDiv(m_pModel->signs[i-1].getDistanceToSignM()*100, rectRoad.Width(), m_nDisplayedLengthCM);
          // If there was a lane change, set the transition width to 0 to ignore the Crossing
-         fPreviousSizeOfCrossing = bThereWasALaneChange ? 0 : m_signs[i-1].getSizeOfCrossing();
+         fPreviousSizeOfCrossing = bThereWasALaneChange ? 0 : m_pModel->signs[i-1].getSizeOfCrossing();
          bThereWasALaneChange = false;
          // Calculate the width in Pixels of the previous transition area (crossing of lane change area) 
          nPreviousTransitionWidthPixels = (int)(((float) hRoad / (float) m_nLaneWidthFactor) * (float) nCurrentNbOfLanes * fPreviousSizeOfCrossing);
@@ -521,8 +1035,8 @@ bool CAHRoadView::paintRoad(CDC& dc, const CSize& sizeCanvas, int wCar)
       }
 
       // SET RIGHT SEGMENT LIMITS
-      nDistanceToNextSignPixels = MulDiv(m_signs[i].getDistanceToSignM()*100, rectRoad.Width(), m_nDisplayedLengthCM);
-      if (nCurrentNbOfLanes != nNextNbOfLanes) // m_signs[i].getSizeOfCrossing() == 0
+      nDistanceToNextSignPixels = MulDiv(m_pModel->signs[i].getDistanceToSignM()*100, rectRoad.Width(), m_nDisplayedLengthCM);
+      if (nCurrentNbOfLanes != nNextNbOfLanes) // m_pModel->signs[i].getSizeOfCrossing() == 0
       {
          // If we have no crossing, the width of the transition area depends on the lane difference between the two successive segments
          nNextTransitionWidthPixels = (int)(((float) hRoad / (float) m_nLaneWidthFactor) * abs(nNextNbOfLanes - nCurrentNbOfLanes));
@@ -548,29 +1062,29 @@ bool CAHRoadView::paintRoad(CDC& dc, const CSize& sizeCanvas, int wCar)
          if ((i == 0) && (nDistanceToNextSignPixels <= nNextTransitionWidthPixels / 2))
          {
             // paint a short segment part corresponding to the transition and jump to next Sign
-            paintRoadSegment(dc, rectRoad, leftSegmentLimit, rightSegmentLimit + (2 * nNextTransitionWidthPixels), nNextNbOfLanes);
+            paintRoadSegment(dl, rectRoad, leftSegmentLimit, rightSegmentLimit + (2 * nNextTransitionWidthPixels), nNextNbOfLanes);
          }
          else
          {
-            paintRoadSegment(dc, rectRoad, leftSegmentLimit, rightSegmentLimit, nCurrentNbOfLanes);
+            paintRoadSegment(dl, rectRoad, leftSegmentLimit, rightSegmentLimit, nCurrentNbOfLanes);
             // Do not draw the transition if we exceed the Right drawing Rect limit
             if ((rightSegmentLimit + nNextTransitionWidthPixels) <= rectRoad.right)
             {
-               // Note: we pass m_signs[i].getSizeOfCrossing() as the method has to know if we have a crossing or not
-               paintRoadSegmentTransition(dc, rectRoad, rightSegmentLimit, rightSegmentLimit + nNextTransitionWidthPixels, nCurrentNbOfLanes, nNextNbOfLanes, m_signs[i].getSizeOfCrossing(), nCrossingSide, nProhibitedSide, nLinkId);
+               // Note: we pass m_pModel->signs[i].getSizeOfCrossing() as the method has to know if we have a crossing or not
+               paintRoadSegmentTransition(dl, rectRoad, rightSegmentLimit, rightSegmentLimit + nNextTransitionWidthPixels, nCurrentNbOfLanes, nNextNbOfLanes, m_pModel->signs[i].getSizeOfCrossing(), nCrossingSide, nProhibitedSide, nLinkId);
             }
          }
       }
       else  // If two transition areas are too close, paint a Complex Crossing rectangle
       {
-         paintComplexCrossing(dc, rectRoad, leftSegmentLimit, rightSegmentLimit + nNextTransitionWidthPixels, nNextNbOfLanes);
+         paintComplexCrossing(dl, rectRoad, leftSegmentLimit, rightSegmentLimit + nNextTransitionWidthPixels, nNextNbOfLanes);
       }
    };   // end of for loop over the conditions/signs
  
    return true;
 };
 
-void CAHRoadView::paintAreas(CDC& dc, const CRect& rectRoad, CArray<RVAreas>& areas)
+void CAHRoadView::paintAreas(RVDisplayList& dl, const CRect& rectRoad, const std::vector<RVAreas>& areas)
 {
    int nLaneWidth = (int)(rectRoad.Height() / (m_nLaneWidthFactor * 2));
    int nRoadCenter = rectRoad.top + (int) (rectRoad.Height() / 2);
@@ -582,7 +1096,7 @@ void CAHRoadView::paintAreas(CDC& dc, const CRect& rectRoad, CArray<RVAreas>& ar
    int nPreviousDistanceToAreaEndPx = 0;
 
    // Loop over the area vector
-   for(int nAreaIdx = 0; nAreaIdx < areas.GetSize(); nAreaIdx++)
+   for(int nAreaIdx = 0; nAreaIdx < (int) areas.size(); nAreaIdx++)
    {
       nAreaWidth = (areas[nAreaIdx].getWidth() * nLaneWidth * 2) + (2 * ROAD_LINES_GAP) + 10;
       nDistanceToAreaStartPx = MulDiv(areas[nAreaIdx].getStart()*100, rectRoad.Width(), m_nDisplayedLengthCM);
@@ -615,14 +1129,14 @@ void CAHRoadView::paintAreas(CDC& dc, const CRect& rectRoad, CArray<RVAreas>& ar
             // If it is a Roundabout Area
             if (m_bShowRoundabouts)
             {
-               dc.FillRect(rectArea, &brushAreaRoundabout);
+               dl.fillRect(RVDisplayList::STYLE_AREA_ROUNDABOUT, rectArea.left, rectArea.top, rectArea.Width(), rectArea.Height());
             }
             break;
          case TrafficSign::tsTunnel:
             // If it is a Tunnel Area
             if (m_bShowTunnels)
             {
-               dc.FillRect(rectArea, &brushAreaTunnel);
+               dl.fillRect(RVDisplayList::STYLE_AREA_TUNNEL, rectArea.left, rectArea.top, rectArea.Width(), rectArea.Height());
             }
             break;
          case TrafficSign::tsRightOfWay:        bDrawTS = m_bShowTSRightOfWayRoad;     break;
@@ -638,97 +1152,81 @@ void CAHRoadView::paintAreas(CDC& dc, const CRect& rectRoad, CArray<RVAreas>& ar
       }
       if (bDrawTS)
       {
-         dc.FillRect(rectArea, &brushAreaTS);
+         dl.fillRect(RVDisplayList::STYLE_AREA_SIGNS, rectArea.left, rectArea.top, rectArea.Width(), rectArea.Height());
       }
    }
   
 };
 
 // Method to paint a hashed road segment
-void CAHRoadView::paintComplexCrossing(CDC& dc, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes)
+void CAHRoadView::paintComplexCrossing(RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes)
 {
    int nLaneWidth = (int)(rectRoad.Height() / (m_nLaneWidthFactor * 2));
    int nRoadWidth = nNbOfLanes * nLaneWidth * 2;
    int nRoadCenter = rectRoad.top + (int) (rectRoad.Height() / 2);
 
-   CRect rectComplex(CPoint(nStart, nRoadCenter - (int)(nRoadWidth / 2) - ROAD_LINES_GAP), CSize(nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP) + 1));
-   
-   CBrush* pOldBrush = dc.SelectObject(&brushComplex);
-      dc.FillRect(rectComplex, &brushComplex);
-   dc.SelectObject(pOldBrush);
+   dl.fillRect(RVDisplayList::STYLE_COMPLEX, nStart, nRoadCenter - (int)(nRoadWidth / 2) - ROAD_LINES_GAP, nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP) + 1);
 
 };
 
-void  CAHRoadView::paintRoadSegment(CDC& dc, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes)
+void  CAHRoadView::paintRoadSegment(RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes)
 {
    int nLaneWidth = (int)(rectRoad.Height() / (m_nLaneWidthFactor * 2));
    int nRoadWidth = nNbOfLanes * nLaneWidth * 2;
    int nRoadCenter = rectRoad.top + (int) (rectRoad.Height() / 2);
-   int nLastPixels = 0;
 
    // Road background
-   dc.FillSolidRect(nStart, nRoadCenter - (int)(nRoadWidth / 2) - ROAD_LINES_GAP, nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP) + 1, COLOR_ROAD);
+   dl.fillRect(RVDisplayList::STYLE_ROAD, nStart, nRoadCenter - (int)(nRoadWidth / 2) - ROAD_LINES_GAP, nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP) + 1);
 
-   // Central line
-   if (nNbOfLanes == 1)
+   // Central line: if more than one lane, a solid central line (if one lane, it is dashed with the lane lines)
+   if (nNbOfLanes > 1)
    {
-      // If one lane, paint a dashed central line
-      nLastPixels = paintLaneLine(dc, nStart, nEnd, nRoadCenter, m_nLineLength, m_nLineGapLength);  //  nLastPixels
-   }
-   else
-   {
-      // If more than one lane, paint a solid central line
-      CPen* pOldPen = dc.SelectObject(&penLines);
-         dc.MoveTo(nStart, nRoadCenter);
-         dc.LineTo(nEnd, nRoadCenter);
-      dc.SelectObject(pOldPen);
+      dl.line(RVDisplayList::STYLE_LINES, nStart, nRoadCenter, nEnd, nRoadCenter);
    }
    // Road border lines
-   CPen* pOldPen = dc.SelectObject(&penLines);
-      // Top
-      dc.MoveTo(nStart, nRoadCenter - (int)(nRoadWidth / 2));
-      dc.LineTo(nEnd, nRoadCenter - (int)(nRoadWidth / 2));
-      // Bottom
-      dc.MoveTo(nStart, nRoadCenter + (int)(nRoadWidth / 2));
-      dc.LineTo(nEnd, nRoadCenter +(int)(nRoadWidth / 2));
-   dc.SelectObject(pOldPen);
+   // Top
+   dl.line(RVDisplayList::STYLE_LINES, nStart, nRoadCenter - (int)(nRoadWidth / 2), nEnd, nRoadCenter - (int)(nRoadWidth / 2));
+   // Bottom
+   dl.line(RVDisplayList::STYLE_LINES, nStart, nRoadCenter + (int)(nRoadWidth / 2), nEnd, nRoadCenter + (int)(nRoadWidth / 2));
 
    // Lane separation lines
+   paintLaneLines(dl, rectRoad, nStart, nEnd, nRoadCenter, nLaneWidth, nNbOfLanes);
+
    for (int nLanes = 1; nLanes <= nNbOfLanes; nLanes++)
    {
-      CPen* _pOldPen = dc.SelectObject(&penLines);
-         if (nLanes < nNbOfLanes)
-         {
-            nLastPixels = paintLaneLine(dc, nStart, nEnd, nRoadCenter - (nLanes * nLaneWidth), m_nLineLength, m_nLineGapLength); // nLastPixels
-            nLastPixels = paintLaneLine(dc, nStart, nEnd, nRoadCenter + (nLanes * nLaneWidth), m_nLineLength, m_nLineGapLength); // nLastPixels
-         }
-         // Paint traffic flow direction arrows
-         if ((nStart + ARROW_CENTER_FROM_START < rectRoad.right) && (nStart + ARROW_CENTER_FROM_START + (m_nArrowWidthPixels / 2) < nEnd))
-         {
-            paintArrow(dc, nStart + ARROW_CENTER_FROM_START, nRoadCenter - (nLanes * nLaneWidth) + (int)(nLaneWidth / 2), false, m_nArrowWidthPixels);
-            paintArrow(dc, nStart + ARROW_CENTER_FROM_START, nRoadCenter + (nLanes * nLaneWidth) - (int)(nLaneWidth / 2), true, m_nArrowWidthPixels);
-         }
-      dc.SelectObject(_pOldPen);
+      // Paint traffic flow direction arrows
+      if ((nStart + ARROW_CENTER_FROM_START < rectRoad.right) && (nStart + ARROW_CENTER_FROM_START + (m_nArrowWidthPixels / 2) < nEnd))
+      {
+         paintArrow(dl, nStart + ARROW_CENTER_FROM_START, nRoadCenter - (nLanes * nLaneWidth) + (int)(nLaneWidth / 2), false, m_nArrowWidthPixels);
+         paintArrow(dl, nStart + ARROW_CENTER_FROM_START, nRoadCenter + (nLanes * nLaneWidth) - (int)(nLaneWidth / 2), true, m_nArrowWidthPixels);
+      }
    }
 };
 
-// Method to paint a Dashed Line with the pattern defined by nLineLength and nLineGapLength
-int CAHRoadView::paintLaneLine(CDC& dc, int nStart, int nEnd, int nY, int nLineLength, int nLineGapLength)
+// Method to paint the Dashed Lines with the pattern defined by m_nLineLength and m_nLineGapLength. The pattern is
+// anchored at the left of the road moved back by the distance driven, so that the dashes continue from one segment
+// to the next and go by as the car drives (as the road strip is scrolled, see OnModelPublished()).
+void CAHRoadView::paintLaneLines(RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nRoadCenter, int nLaneWidth, int nNbOfLanes)
 {
-   /*int nLastPixels*/
-   CPen* pOldPen = dc.SelectObject(&penLinesDash);
-   int nLineIdx = nStart;
-   for (; (nLineIdx + nLineLength) < nEnd; nLineIdx += nLineLength + nLineGapLength)
+   if ((nNbOfLanes < 1) || (nStart >= nEnd))
    {
-      dc.MoveTo(nLineIdx, nY);
-      dc.LineTo(nLineIdx + nLineLength, nY);
+      return;
+   }
+   int xAnchor = rectRoad.left - MulDiv(m_nLayoutTravelCM, rectRoad.Width(), m_nDisplayedLengthCM);
+   xAnchor = RVDisplayList::getDashPhase(xAnchor, m_nLineLength, m_nLineGapLength);
+   dl.beginDashedLines(RVDisplayList::STYLE_LINES_DASH, nStart, nEnd, m_nLineLength, m_nLineGapLength);
+   if (nNbOfLanes == 1)
+   {
+      dl.addPoint(xAnchor, nRoadCenter);
+   }
+   for (int nLanes = 1; nLanes < nNbOfLanes; nLanes++)
+   {
+      dl.addPoint(xAnchor, nRoadCenter - (nLanes * nLaneWidth));
+      dl.addPoint(xAnchor, nRoadCenter + (nLanes * nLaneWidth));
    }
-   dc.SelectObject(pOldPen);
-
-   return (nEnd - nLineIdx + nLineLength + nLineGapLength);
 };
 
-void CAHRoadView::paintRoadSegmentTransition(CDC& dc, const CRect& rectRoad, int nStart, int nEnd, int nPreviousNbOfLanes, int nNextNbOfLanes, float fSizeOfCrossing, RVSign::CrossingSideType nCrossingSide, RVSign::ProhibitedSideType nProhibitedSide, Uint32 nLinkId)
+void CAHRoadView::paintRoadSegmentTransition(RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nPreviousNbOfLanes, int nNextNbOfLanes, float fSizeOfCrossing, RVSign::CrossingSideType nCrossingSide, RVSign::ProhibitedSideType nProhibitedSide, Uint32 nLinkId)
 {
    int nLaneWidth = (int)(rectRoad.Height() / (m_nLaneWidthFactor * 2));
    // Set Width of Road to the width of segment with highest number of lanes
@@ -739,21 +1237,21 @@ void CAHRoadView::paintRoadSegmentTransition(CDC& dc, const CRect& rectRoad, int
    // SIMPLE CROSSING
    if ((fSizeOfCrossing > 0) && (nPreviousNbOfLanes == nNextNbOfLanes))
    {
-      paintCrossing(dc, nStart, nEnd, nRoadCenter, nRoadWidth, nLaneWidth, nNextNbOfLanes, nCrossingSide);
+      paintCrossing(dl, nStart, nEnd, nRoadCenter, nRoadWidth, nLaneWidth, nNextNbOfLanes, nCrossingSide);
       // Paint the prohibited Signs
-      paintProhibitedSigns(dc, rectRoad, nRoadCenter, nRoadWidth, (nEnd + nStart) / 2, nProhibitedSide);
+      paintProhibitedSigns(dl, rectRoad, nRoadCenter, nRoadWidth, (nEnd + nStart) / 2, nProhibitedSide);
    }
 
    // SIMPLE LANE NUMBER DECREASE
    if (nPreviousNbOfLanes > nNextNbOfLanes)
    {
-      paintLaneDecrease(dc, nStart, nEnd, nRoadCenter, nRoadWidth, nLaneWidth, nPreviousNbOfLanes, nNextNbOfLanes);  // fSizeOfCrossing
+      paintLaneDecrease(dl, nStart, nEnd, nRoadCenter, nRoadWidth, nLaneWidth, nPreviousNbOfLanes, nNextNbOfLanes);  // fSizeOfCrossing
    }
    
    // SIMPLE LANE NUMBER INCREASE
    if (nPreviousNbOfLanes < nNextNbOfLanes)
    {
-      paintLaneIncrease(dc, nStart, nEnd, nRoadCenter, nRoadWidth, nLaneWidth, nPreviousNbOfLanes, nNextNbOfLanes); // fSizeOfCrossing
+      paintLaneIncrease(dl, nStart, nEnd, nRoadCenter, nRoadWidth, nLaneWidth, nPreviousNbOfLanes, nNextNbOfLanes); // fSizeOfCrossing
    }
 
    // Write the Link ID on top of the transition feature
@@ -761,11 +1259,11 @@ void CAHRoadView::paintRoadSegmentTransition(CDC& dc, const CRect& rectRoad, int
    {
       CString szLinkId;
       szLinkId.Format("%d", nLinkId);
-      paintText(dc, rectRoad, (nStart + nEnd)/2, szLinkId, COLOR_DEBUG);
+      paintText(dl, rectRoad, (nStart + nEnd)/2, szLinkId, RVDisplayList::STYLE_DEBUG);
    }
 };
 
-void CAHRoadView::paintCrossing(CDC& dc, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nNextNbOfLanes, RVSign::CrossingSideType nCrossingSide)
+void CAHRoadView::paintCrossing(RVDisplayList& dl, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nNextNbOfLanes, RVSign::CrossingSideType nCrossingSide)
 {
    // CROSSING_UNKNOWN is drawn as CROSSING_BOTH
    nCrossingSide = nCrossingSide == RVSign::CROSSING_UNKNOWN ? RVSign::CROSSING_BOTH:
@@ -783,219 +1281,165 @@ void CAHRoadView::paintCrossing(CDC& dc, int nStart, int nEnd, int nRoadCenter,
       nBGRectHeight += m_nCrossingLaneExtent - 1;
    }
 
-   CPen* pOldPen = dc.SelectObject(&penLines);
-      // Paint Road background
-      dc.FillSolidRect(nStart, nBGRectTop, nEnd - nStart, nBGRectHeight, COLOR_ROAD);
-      // Paint Top border Lines
-      dc.MoveTo(nStart, nRoadCenter - (nNextNbOfLanes * nLaneWidth));
-      if ((nCrossingSide == RVSign::CROSSING_LEFT) || (nCrossingSide == RVSign::CROSSING_BOTH))
-      {
-         dc.LineTo(nStart + ROAD_LINES_GAP, nRoadCenter - (nNextNbOfLanes * nLaneWidth));
-         dc.LineTo(nStart + ROAD_LINES_GAP, nRoadCenter - (nNextNbOfLanes * nLaneWidth) - m_nCrossingLaneExtent);
-         dc.MoveTo(nEnd - ROAD_LINES_GAP - 1, nRoadCenter - (nNextNbOfLanes * nLaneWidth) - m_nCrossingLaneExtent);
-         dc.LineTo(nEnd - ROAD_LINES_GAP - 1, nRoadCenter - (nNextNbOfLanes * nLaneWidth));
-      }
-      dc.LineTo(nEnd, nRoadCenter - (nNextNbOfLanes * nLaneWidth));
+   // Paint Road background
+   dl.fillRect(RVDisplayList::STYLE_ROAD, nStart, nBGRectTop, nEnd - nStart, nBGRectHeight);
 
-      // Paint Bottom Border Lines
-      dc.MoveTo(nStart, nRoadCenter + (nNextNbOfLanes * nLaneWidth));
-      if ((nCrossingSide == RVSign::CROSSING_RIGHT) || (nCrossingSide == RVSign::CROSSING_BOTH))
-      {
-         dc.LineTo(nStart + ROAD_LINES_GAP, nRoadCenter + (nNextNbOfLanes * nLaneWidth));
-         dc.LineTo(nStart + ROAD_LINES_GAP, nRoadCenter + (nNextNbOfLanes * nLaneWidth) + m_nCrossingLaneExtent);
-         dc.MoveTo(nEnd - ROAD_LINES_GAP - 1, nRoadCenter + (nNextNbOfLanes * nLaneWidth) + m_nCrossingLaneExtent);
-         dc.LineTo(nEnd - ROAD_LINES_GAP - 1, nRoadCenter + (nNextNbOfLanes * nLaneWidth));
-      }
-      dc.LineTo(nEnd, nRoadCenter + (nNextNbOfLanes * nLaneWidth));
-         
-   dc.SelectObject(pOldPen);
+   // Paint Top border Lines
+   int yTop = nRoadCenter - (nNextNbOfLanes * nLaneWidth);
+   if ((nCrossingSide == RVSign::CROSSING_LEFT) || (nCrossingSide == RVSign::CROSSING_BOTH))
+   {
+      dl.beginPolyline(RVDisplayList::STYLE_LINES);
+      dl.addPoint(nStart, yTop);
+      dl.addPoint(nStart + ROAD_LINES_GAP, yTop);
+      dl.addPoint(nStart + ROAD_LINES_GAP, yTop - m_nCrossingLaneExtent);
+      dl.beginPolyline(RVDisplayList::STYLE_LINES);
+      dl.addPoint(nEnd - ROAD_LINES_GAP - 1, yTop - m_nCrossingLaneExtent);
+      dl.addPoint(nEnd - ROAD_LINES_GAP - 1, yTop);
+      dl.addPoint(nEnd, yTop);
+   }
+   else
+   {
+      dl.line(RVDisplayList::STYLE_LINES, nStart, yTop, nEnd, yTop);
+   }
+
+   // Paint Bottom Border Lines
+   int yBottom = nRoadCenter + (nNextNbOfLanes * nLaneWidth);
+   if ((nCrossingSide == RVSign::CROSSING_RIGHT) || (nCrossingSide == RVSign::CROSSING_BOTH))
+   {
+      dl.beginPolyline(RVDisplayList::STYLE_LINES);
+      dl.addPoint(nStart, yBottom);
+      dl.addPoint(nStart + ROAD_LINES_GAP, yBottom);
+      dl.addPoint(nStart + ROAD_LINES_GAP, yBottom + m_nCrossingLaneExtent);
+      dl.beginPolyline(RVDisplayList::STYLE_LINES);
+      dl.addPoint(nEnd - ROAD_LINES_GAP - 1, yBottom + m_nCrossingLaneExtent);
+      dl.addPoint(nEnd - ROAD_LINES_GAP - 1, yBottom);
+      dl.addPoint(nEnd, yBottom);
+   }
+   else
+   {
+      dl.line(RVDisplayList::STYLE_LINES, nStart, yBottom, nEnd, yBottom);
+   }
+};
+
+// Appends the first nPoints points of the array to the polyline or polygon begun in the display list
+static void addPoints(RVDisplayList& dl, const CArray<CPoint, CPoint>& points, int nPoints)
+{
+   for (int i = 0; i < nPoints; i++)
+   {
+      dl.addPoint(points[i].x, points[i].y);
+   }
 };
 
-void CAHRoadView::paintLaneIncrease(CDC& dc, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes) // float fSizeOfCrossing
+// Appends the points of an arc starting at x=0 and stopping at the angle of its template, to the
+// polyline or polygon begun in the display list. The points are moved by nVerticalOffset, e.g. for the polygon
+// of the road which extends over the border line. Returns the y of the last point.
+// Example: Right downward arc      Right upward arc
+//              x_                            |
+//                 \                      x_ /
+//                 |
+// x is the starting point (xPolyRefPoint, yPolyRefPoint)
+//
+static int addArcPoints(RVDisplayList& dl, const RVArcCache::Arc& arc, int xPolyRefPoint, int yPolyRefPoint, bool bIsArcUp, bool bIsArcRight, int nVerticalOffset)
+{
+   // Set Arc Direction by defining if there will be an addition or a substraction
+   int nArcDirectionSign = bIsArcUp ? -1 : 1;
+   int nPoints = (int) arc.size();
+   int y = yPolyRefPoint;
+
+   for (int n = 0; n < nPoints; n++)
+   {
+      // A Right Arc starts at the reference point, a Left Arc ends there
+      int nDrawIdx = bIsArcRight ? n : nPoints - 1 - n;
+      y = yPolyRefPoint + nArcDirectionSign * arc[nDrawIdx] + nVerticalOffset;
+      dl.addPoint(bIsArcRight ? xPolyRefPoint + nDrawIdx : xPolyRefPoint - nDrawIdx, y);
+   }
+   return y;
+};
+
+void CAHRoadView::paintLaneIncrease(RVDisplayList& dl, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes) // float fSizeOfCrossing
 {
    // TOP LANE INCREASE
-   int nPtsIdx = 0;
-   CArray<CPoint, CPoint>     PolyPtsArray, PolyPtsLineArray;  // Arrays to contain the points of the polygon forming the Lane increase
+   const RVArcCache::Arc& arc = m_arcCache.get(nLaneWidth, PI / 4);      // TransitionToRoadRadius = nLaneWidth
 
-   int TransitionToRoadRadius = nLaneWidth;
    int xPolyStart = nStart; // - (1.5 * nLaneWidth);
    int yPolyStart = nRoadCenter - (nPreviousNbOfLanes * nLaneWidth) + ROAD_LINES_GAP - 1;
    int xPolyEnd = nEnd ; // + (1.5 * nLaneWidth);
    int yPolyEnd = nRoadCenter - (nNextNbOfLanes * nLaneWidth) - 1;
 
-   // Bottom upward arc points
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyStart, yPolyStart, TransitionToRoadRadius, PI / 4, ARC_UP, ARC_RIGHT, - ROAD_LINES_GAP);
-   
-   // TODO: int nTransitionIdx = nPtsIdx; // Keep it in memory to add a crossing road here if necessary
-
-   // Top downward arc points
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyEnd, yPolyEnd, TransitionToRoadRadius, PI / 4, ARC_DOWN, ARC_LEFT, - ROAD_LINES_GAP);
-   
-   // Close the polygon
-   PolyPtsArray.Add(CPoint(xPolyEnd, yPolyStart));
-
    // TODO: In this version, if there are both a crossing and a lane change, only the lane change is drawn.
    // Improvement: If there is also a crossing, add some points to the lane transition polygon for a small crossing road
-   // if (fSizeOfCrossing != 0.0)
-   // {
-   //    PolyPtsArray.InsertAt(nTransitionIdx, CPoint(PolyPtsArray[nTransitionIdx].x, nRoadCenter - (int)(nRoadWidth / 2) - ROAD_LINES_GAP - m_nCrossingLaneExtent)); //m_nCrossingLaneExtent
-   //    PolyPtsArray.InsertAt(nTransitionIdx + 1, CPoint(PolyPtsArray[nTransitionIdx + 1].x, nRoadCenter - (int)(nRoadWidth / 2) - ROAD_LINES_GAP - m_nCrossingLaneExtent));
-   //    PolyPtsLineArray.Add(CPoint(xPolyEnd, yPolyStart));
-   // }
-
-   // Now Draw the filled polygon
-   CPen* pOldPen = dc.SelectObject(&penRoad);
-      CBrush* pOldBrush = dc.SelectObject(&brushRoad);
-         dc.Polygon(PolyPtsArray.GetData(), nPtsIdx + 1);
-      dc.SelectObject(pOldBrush);
-   dc.SelectObject(pOldPen);
+
+   // Draw the filled polygon: bottom upward arc, top downward arc, closed
+   dl.beginPolygon(RVDisplayList::STYLE_ROAD);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_UP, ARC_RIGHT, - ROAD_LINES_GAP);
+   addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_DOWN, ARC_LEFT, - ROAD_LINES_GAP);
+   dl.addPoint(xPolyEnd, yPolyStart);
 
    // Add a road background in the middle
-   dc.FillSolidRect(nStart, nRoadCenter - (nPreviousNbOfLanes * nLaneWidth) - ROAD_LINES_GAP, nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP), COLOR_ROAD);
+   dl.fillRect(RVDisplayList::STYLE_ROAD, nStart, nRoadCenter - (nPreviousNbOfLanes * nLaneWidth) - ROAD_LINES_GAP, nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP));
    // Draw the border and central lines
-   pOldPen = dc.SelectObject(&penLines);
-      dc.Polyline(PolyPtsLineArray.GetData(), nPtsIdx);
-      dc.MoveTo(nStart, nRoadCenter);
-      dc.LineTo(nEnd, nRoadCenter);
-   dc.SelectObject(pOldPen);
+   dl.beginPolyline(RVDisplayList::STYLE_LINES);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_UP, ARC_RIGHT, 0);
+   addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_DOWN, ARC_LEFT, 0);
+   dl.line(RVDisplayList::STYLE_LINES, nStart, nRoadCenter, nEnd, nRoadCenter);
 
    // BOTTOM LANE INCREASE
-   nPtsIdx = 0;
-   PolyPtsArray.RemoveAll();      // Clear the polygon arrays
-   PolyPtsLineArray.RemoveAll();
-
    yPolyStart = nRoadCenter + (nPreviousNbOfLanes * nLaneWidth) - ROAD_LINES_GAP + 1;
    yPolyEnd = nRoadCenter + (nNextNbOfLanes * nLaneWidth) + 1;
 
-   // Top downward arc points
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyStart, yPolyStart, TransitionToRoadRadius, PI / 4, ARC_DOWN, ARC_RIGHT, ROAD_LINES_GAP);
-   
-   // Bottom upward arc points 
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyEnd, yPolyEnd, TransitionToRoadRadius, PI / 4, ARC_UP, ARC_LEFT, ROAD_LINES_GAP);
-  
-   // Close the polygon
-   PolyPtsArray.Add(CPoint(xPolyEnd, yPolyStart));
-
-   // Draw the filled polygon
-   pOldPen = dc.SelectObject(&penRoad);
-      pOldBrush = dc.SelectObject(&brushRoad);
-         dc.Polygon(PolyPtsArray.GetData(), nPtsIdx + 1);
-      dc.SelectObject(pOldBrush);
-   dc.SelectObject(pOldPen);
+   // Draw the filled polygon: top downward arc, bottom upward arc, closed
+   dl.beginPolygon(RVDisplayList::STYLE_ROAD);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_DOWN, ARC_RIGHT, ROAD_LINES_GAP);
+   addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_UP, ARC_LEFT, ROAD_LINES_GAP);
+   dl.addPoint(xPolyEnd, yPolyStart);
 
    // Draw the curved border line
-   pOldPen = dc.SelectObject(&penLines);
-      dc.Polyline(PolyPtsLineArray.GetData(), nPtsIdx);
-   dc.SelectObject(pOldPen);
-};
-
-// Method to define an arc (PolyPtsArray) and a "border" arc (PolyPtsLineArray) starting at x=0 and stopping at the given angle
-// Note: Angle must be in Radian ! Returns the number of points of the arc for a Polygon drawing.
-// Example: Right downward arc      Right upward arc
-//              x_                            |
-//                 \                      x_ /
-//                 |
-// x is the starting point (xPolyRefPoint, yPolyRefPoint)
-//
-int CAHRoadView::ArcPoints(CArray<CPoint, CPoint>& PolyPtsArray, CArray<CPoint, CPoint>& PolyPtsLineArray, int xPolyRefPoint, int yPolyRefPoint, int nRadius, double fAngle, bool bIsArcUp, bool bIsArcRight, int nVerticalOffset)
-{
-   // Set Arc Direction by defining if there will be an addition or a substraction
-   int nArcDirectionSign = bIsArcUp ? -1 : 1;
-
-   int nPtsIdx = 0;
-   if (bIsArcRight)     // For a Right Arc
-   {
-      for (int nDrawIdx = 0; nDrawIdx <= cos(fAngle) * nRadius; nDrawIdx++)  // cos(pi/4) = sqrt(2.0)/2.0)
-      {
-         PolyPtsArray.Add(CPoint(xPolyRefPoint + nDrawIdx,
-            yPolyRefPoint + nArcDirectionSign * (-(int) sqrt((nRadius * nRadius) - ((float) nDrawIdx * (float) nDrawIdx)) + nRadius) + nVerticalOffset));
-         PolyPtsLineArray.Add(CPoint(xPolyRefPoint + nDrawIdx,
-            yPolyRefPoint + nArcDirectionSign * (-(int) sqrt((nRadius * nRadius) - ((float) nDrawIdx * (float) nDrawIdx)) + nRadius) ));
-         nPtsIdx++;
-      }
-   }
-   else                 // For a Left Arc
-   {
-      for (int nDrawIdx = (int)(cos(fAngle) * nRadius); nDrawIdx >= 0 ; nDrawIdx--)   // sqrt(2.0)/2.0)
-      {
-         PolyPtsArray.Add(CPoint(xPolyRefPoint - nDrawIdx,
-            yPolyRefPoint + nArcDirectionSign * (-(int) sqrt((nRadius * nRadius) - ((float) nDrawIdx * (float) nDrawIdx)) + nRadius) + nVerticalOffset));
-         PolyPtsLineArray.Add(CPoint(xPolyRefPoint - nDrawIdx,
-            yPolyRefPoint + nArcDirectionSign * (-(int) sqrt((nRadius * nRadius) - ((float) nDrawIdx * (float) nDrawIdx)) + nRadius) ));
-         nPtsIdx++;
-      }
-   }
-   return nPtsIdx;
+   dl.beginPolyline(RVDisplayList::STYLE_LINES);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_DOWN, ARC_RIGHT, 0);
+   addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_UP, ARC_LEFT, 0);
 };
 
-void CAHRoadView::paintLaneDecrease(CDC& dc, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes) // float fSizeOfCrossing
+void CAHRoadView::paintLaneDecrease(RVDisplayList& dl, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes) // float fSizeOfCrossing
 {
    // Top lane decrease
-   int nPtsIdx = 0;
-   CArray<CPoint, CPoint>     PolyPtsArray, PolyPtsLineArray;
+   const RVArcCache::Arc& arc = m_arcCache.get(nLaneWidth, PI / 4);      // TransitionToRoadRadius = nLaneWidth
 
-   int TransitionToRoadRadius = nLaneWidth;
    int xPolyStart = nStart; // - (1.5 * nLaneWidth);
    int yPolyStart = nRoadCenter - (nPreviousNbOfLanes * nLaneWidth) - 1;
    int xPolyEnd = nEnd ; // + (1.5 * nLaneWidth);
    int yPolyEnd = nRoadCenter - (nNextNbOfLanes * nLaneWidth) + ROAD_LINES_GAP - 1;
 
-   // Define points of Top left Arc
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyStart, yPolyStart, TransitionToRoadRadius, PI / 4, ARC_DOWN, ARC_RIGHT, - ROAD_LINES_GAP);
-  
-   // Define points of Bottom right Arc
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyEnd, yPolyEnd, TransitionToRoadRadius, PI / 4, ARC_UP, ARC_LEFT, - ROAD_LINES_GAP);
-   
-   // Close the polygon
-   PolyPtsArray.Add(CPoint(xPolyStart, PolyPtsArray[nPtsIdx-1].y));
-   
-   // Draw the filled polygon
-   CPen* pOldPen = dc.SelectObject(&penRoad);
-      CBrush* pOldBrush = dc.SelectObject(&brushRoad);
-         dc.Polygon(PolyPtsArray.GetData(), nPtsIdx + 1);
-      dc.SelectObject(pOldBrush);
-   dc.SelectObject(pOldPen);
+   // Draw the filled polygon: top left arc, bottom right arc, closed
+   dl.beginPolygon(RVDisplayList::STYLE_ROAD);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_DOWN, ARC_RIGHT, - ROAD_LINES_GAP);
+   int yLast = addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_UP, ARC_LEFT, - ROAD_LINES_GAP);
+   dl.addPoint(xPolyStart, yLast);
 
    // Road background
-   dc.FillSolidRect(nStart, nRoadCenter - (nNextNbOfLanes * nLaneWidth) - ROAD_LINES_GAP, nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP), COLOR_ROAD);
+   dl.fillRect(RVDisplayList::STYLE_ROAD, nStart, nRoadCenter - (nNextNbOfLanes * nLaneWidth) - ROAD_LINES_GAP, nEnd - nStart, nRoadWidth + (2*ROAD_LINES_GAP));
    // Border and central lines
-   pOldPen = dc.SelectObject(&penLines);
-      dc.Polyline(PolyPtsLineArray.GetData(), nPtsIdx);
-      dc.MoveTo(nStart, nRoadCenter);
-      dc.LineTo(nEnd, nRoadCenter);
-   dc.SelectObject(pOldPen);
+   dl.beginPolyline(RVDisplayList::STYLE_LINES);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_DOWN, ARC_RIGHT, 0);
+   addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_UP, ARC_LEFT, 0);
+   dl.line(RVDisplayList::STYLE_LINES, nStart, nRoadCenter, nEnd, nRoadCenter);
 
    // Bottom lane decrease
-   nPtsIdx = 0;
-   PolyPtsArray.RemoveAll();
-   PolyPtsLineArray.RemoveAll();
-
    yPolyStart = nRoadCenter + (nPreviousNbOfLanes * nLaneWidth) + 1;
    yPolyEnd = nRoadCenter + (nNextNbOfLanes * nLaneWidth) - ROAD_LINES_GAP + 1;
 
-   // Bottom upward Arc points 
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyStart, yPolyStart, TransitionToRoadRadius, PI / 4, ARC_UP, ARC_RIGHT, ROAD_LINES_GAP);
+   // Draw the filled polygon: bottom upward arc, top downward arc, closed
+   dl.beginPolygon(RVDisplayList::STYLE_ROAD);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_UP, ARC_RIGHT, ROAD_LINES_GAP);
+   yLast = addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_DOWN, ARC_LEFT, ROAD_LINES_GAP);
+   dl.addPoint(xPolyStart, yLast);
 
-   // Top downward Arc points
-   nPtsIdx += ArcPoints(PolyPtsArray, PolyPtsLineArray, xPolyEnd, yPolyEnd, TransitionToRoadRadius, PI / 4, ARC_DOWN, ARC_LEFT, ROAD_LINES_GAP);
-   
-   // Close the polygon
-   PolyPtsArray.Add(CPoint(xPolyStart, PolyPtsArray[nPtsIdx-1].y));
-  
-   // Draw the filled polygon
-   pOldPen = dc.SelectObject(&penRoad);
-      pOldBrush = dc.SelectObject(&brushRoad);
-         dc.Polygon(PolyPtsArray.GetData(), nPtsIdx + 1);
-      dc.SelectObject(pOldBrush);
-   dc.SelectObject(pOldPen);
-
-   pOldPen = dc.SelectObject(&penLines);
-      dc.Polyline(PolyPtsLineArray.GetData(), nPtsIdx);
-   dc.SelectObject(pOldPen);
+   dl.beginPolyline(RVDisplayList::STYLE_LINES);
+   addArcPoints(dl, arc, xPolyStart, yPolyStart, ARC_UP, ARC_RIGHT, 0);
+   addArcPoints(dl, arc, xPolyEnd, yPolyEnd, ARC_DOWN, ARC_LEFT, 0);
 };
 
 
-void CAHRoadView::paintArrow(CDC& dc, int xCenter, int yCenter, bool bLeftToRight, int nArrowWidthPixels)
+void CAHRoadView::paintArrow(RVDisplayList& dl, int xCenter, int yCenter, bool bLeftToRight, int nArrowWidthPixels)
 {
    // bLeftToRight = true to paint a right arrow, else paint a left arrow
    CArray<CPoint, CPoint>     PolyArrowArray;
@@ -1016,26 +1460,23 @@ void CAHRoadView::paintArrow(CDC& dc, int xCenter, int yCenter, bool bLeftToRigh
    PolyArrowArray.Add(CPoint(xCenter + nArrowDirectionSign * (int)(nArrowWidthPixels / 4), yCenter + (int)(nArrowHeightPixels / 4)));
    PolyArrowArray.Add(CPoint(xCenter - nArrowDirectionSign * (int)(nArrowWidthPixels / 2), yCenter + (int)(nArrowHeightPixels / 4)));
    
-   CPen* pOldPen = dc.SelectObject(&penArrow);
-      CBrush* pOldBrush = dc.SelectObject(&brushArrow);
-         dc.Polygon(PolyArrowArray.GetData(), PolyArrowArray.GetSize());
-      dc.SelectObject(pOldBrush);
-   dc.SelectObject(pOldPen);
+   dl.beginPolygon(RVDisplayList::STYLE_ARROW);
+   addPoints(dl, PolyArrowArray, (int) PolyArrowArray.GetSize());
 
 };
 
-void CAHRoadView::paintSignPx(CDC& dc, const CRect& rectSigns, const TrafficSign::Sign theSign, UINT nSignParam, int nPosition)
+void CAHRoadView::paintSignPx(RVDisplayList& dl, const CRect& rectSigns, const TrafficSign::Sign theSign, UINT nSignParam, int nPosition)
 {
    // Paint signs from RVSign vector using TrafficSign
    if (nPosition > rectSigns.left && nPosition < rectSigns.right)
    {
       int wSign       = rectSigns.Width() / 15;
       CRect rectSign(nPosition - wSign/2, rectSigns.top, nPosition + wSign/2, rectSigns.bottom);
-      ts->draw(&dc, rectSign, theSign, nSignParam, 0, false);
+      dl.sign(rectSign.left, rectSign.top, rectSign.right, rectSign.bottom, theSign, nSignParam, 0, false);
    }
 };
 
-void CAHRoadView::paintSign(CDC& dc, const CRect& rectSigns, int nTopRoad, const TrafficSign::Sign theSign, UINT nSignParam, int nDistanceM, bool bLength, int nDistFromStart, int &xLast, int iPos, bool bIsSign) // const RVSign& sign
+void CAHRoadView::paintSign(RVDisplayList& dl, const CRect& rectSigns, int nTopRoad, const TrafficSign::Sign theSign, UINT nSignParam, int nDistanceM, bool bLength, int nDistFromStart, int &xLast, int iPos, bool bIsSign) // const RVSign& sign
 {
    // Paint signs from RVSign vector using TrafficSign
    int xSignCenter = rectSigns.left + MulDiv(nDistFromStart*100, rectSigns.Width(), m_nDisplayedLengthCM);
@@ -1054,23 +1495,21 @@ void CAHRoadView::paintSign(CDC& dc, const CRect& rectSigns, int nTopRoad, const
       CRect rectSign(xSignCenterNew - wSign, rectSigns.top, xSignCenterNew + wSign, rectSigns.top + wSign);
       if (nTopRoad > rectSigns.bottom) {
          /* Draw sign pole. */
-         int iModeOld = dc.SetBkMode(TRANSPARENT);
-         CPen pen(bIsSign ? PS_SOLID : PS_DOT, bIsSign ? rectSigns.Height() / 30 + 1 : 1, COLOR_SCALE);
-         CPen *pPenOld = dc.SelectObject(&pen);
-         dc.MoveTo(xSignCenter, nTopRoad);
-         dc.LineTo(xSignCenterNew, rectSigns.bottom);
          if (bIsSign) {
-            dc.LineTo(xSignCenterNew, MARGIN_TOP / 2);
+            dl.beginPolyline(RVDisplayList::STYLE_POLE, rectSigns.Height() / 30 + 1);
+            dl.addPoint(xSignCenter, nTopRoad);
+            dl.addPoint(xSignCenterNew, rectSigns.bottom);
+            dl.addPoint(xSignCenterNew, MARGIN_TOP / 2);
+         } else {
+            dl.line(RVDisplayList::STYLE_POLE_DOTTED, xSignCenter, nTopRoad, xSignCenterNew, rectSigns.bottom);
          }
-         dc.SelectObject(pPenOld);
-         dc.SetBkMode(iModeOld);
       }
-      ts->draw(&dc, rectSign, theSign, nSignParam, nDistanceM, bLength, false /*bIsSign*/);
+      dl.sign(rectSign.left, rectSign.top, rectSign.right, rectSign.bottom, theSign, nSignParam, nDistanceM, bLength);
    }
 };
 
 
-void CAHRoadView::paintSigns(CDC& dc, const CSize& sizeCanvas, int wCar)
+void CAHRoadView::paintSigns(RVDisplayList& dl, const CSize& sizeCanvas, int wCar)
 {
    int x      = MARGIN_LEFT + wCar + CAR_ROAD_GAP;
    int hTotal = (int) (sizeCanvas.cy * ((VERTICAL_ROAD_EXTENT/100.0) / 4.0));
@@ -1090,31 +1529,31 @@ void CAHRoadView::paintSigns(CDC& dc, const CSize& sizeCanvas, int wCar)
    rectSignsBottom.top    += MARGIN_TOP;
 
    // Paint Lanes signs on Top and Crossing signs on Bottom
-   for (int i = (int) m_signs.GetSize();  i > 0;  i--)
+   for (int i = (int) m_pModel->signs.size();  i > 0;  i--)
    {
       int xLast = -INT_MAX;
-//      paintSign(dc, rectSignsTop, hTotal, m_signs[i-1].getSignLanes(), m_signs[i-1].getSignLanesParam(), 9999, false,  m_signs[i-1].getDistanceToSignM(), xLast, 0);
+//      paintSign(dl, rectSignsTop, hTotal, m_pModel->signs[i-1].getSignLanes(), m_pModel->signs[i-1].getSignLanesParam(), 9999, false,  m_pModel->signs[i-1].getDistanceToSignM(), xLast, 0);
 //      xLast = -INT_MAX;
-      paintSign(dc, rectSignsBottom, rectSignsBottom.bottom, m_signs[i-1].getSignCrossing(), 0, 0, false, m_signs[i-1].getDistanceToSignM(), xLast, 0);
+      paintSign(dl, rectSignsBottom, rectSignsBottom.bottom, m_pModel->signs[i-1].getSignCrossing(), 0, 0, false, m_pModel->signs[i-1].getDistanceToSignM(), xLast, 0);
    };
 
 #if 0
    // Paint the sign corresponding to the Area above the Road (so that it is painted above the other signs)
-   for(int nAreaIdx = 0; nAreaIdx < m_areas.GetSize(); nAreaIdx++)
+   for(int nAreaIdx = 0; nAreaIdx < (int) m_pModel->areas.size(); nAreaIdx++)
    {      
       int xLast = -INT_MAX;
-      paintSign(dc, rectSignsTop, hTotal, m_areas[nAreaIdx].getSign(), 0, 0, false, m_areas[nAreaIdx].getStart(), xLast, 0);
+      paintSign(dl, rectSignsTop, hTotal, m_pModel->areas[nAreaIdx].getSign(), 0, 0, false, m_pModel->areas[nAreaIdx].getStart(), xLast, 0);
    }
 #endif
    // Paint the Traffic Signs in the Area above the Road (so that it is painted above the other signs)
    int xLast = -INT_MAX;   // Maximum x extension of last sign graphics, in pixels.
    int distPrev = -INT_MAX;   // Position of the last sign, in cm.
    int iPos = 0;           // Index of sign at same position.
-   for(int nAreaIdx = 0; nAreaIdx < m_tsAreas.GetSize(); nAreaIdx++)
+   for(int nAreaIdx = 0; nAreaIdx < (int) m_pModel->tsAreas.size(); nAreaIdx++)
    {      
       BOOL bDrawIt = FALSE;
       bool bIsFree = false;
-      switch (m_tsAreas[nAreaIdx].getSign())
+      switch (m_pModel->tsAreas[nAreaIdx].getSign())
       {
          case TrafficSign::tsInvalid:                                                        continue;
          case TrafficSign::tsPedestrian:           bDrawIt = m_bShowTSPedestrian;            break;
@@ -1130,7 +1569,7 @@ void CAHRoadView::paintSigns(CDC& dc, const CSize& sizeCanvas, int wCar)
       }
       if (bDrawIt)
       {
-         int dist = m_tsAreas[nAreaIdx].getStart();
+         int dist = m_pModel->tsAreas[nAreaIdx].getStart();
          if (distPrev == dist) {
             iPos++;
          } else {
@@ -1139,18 +1578,18 @@ void CAHRoadView::paintSigns(CDC& dc, const CSize& sizeCanvas, int wCar)
          }
          if (!bIsFree)
          {
-            paintSign(dc, rectSignsTop, hTotal, m_tsAreas[nAreaIdx].getSign(), m_tsAreas[nAreaIdx].getNumber(), m_tsAreas[nAreaIdx].getDistanceOrDuration(), m_tsAreas[nAreaIdx].isDuration(), dist, xLast, iPos , m_tsAreas[nAreaIdx].isRealSign()); // add ,true if grayed rectangles should be painted  
+            paintSign(dl, rectSignsTop, hTotal, m_pModel->tsAreas[nAreaIdx].getSign(), m_pModel->tsAreas[nAreaIdx].getNumber(), m_pModel->tsAreas[nAreaIdx].getDistanceOrDuration(), m_pModel->tsAreas[nAreaIdx].isDuration(), dist, xLast, iPos , m_pModel->tsAreas[nAreaIdx].isRealSign()); // add ,true if grayed rectangles should be painted  
          }
          else
          {
-            paintSign(dc, rectSignsTop, hTotal, TrafficSign::tsFree, 
-               reinterpret_cast<unsigned int>(m_szCustomSignPath0.GetBuffer(m_szCustomSignPath0.GetLength())), m_tsAreas[nAreaIdx].getDistanceOrDuration(), m_tsAreas[nAreaIdx].isDuration(), dist, xLast, iPos);
+            paintSign(dl, rectSignsTop, hTotal, TrafficSign::tsFree, 
+               reinterpret_cast<unsigned int>(m_szCustomSignPath0.GetBuffer(m_szCustomSignPath0.GetLength())), m_pModel->tsAreas[nAreaIdx].getDistanceOrDuration(), m_pModel->tsAreas[nAreaIdx].isDuration(), dist, xLast, iPos);
          }
       }
    }
 };
 
-void CAHRoadView::paintProhibitedSigns(CDC& dc, const CRect& rectRoad, int nRoadCenter, int nRoadWidth, int nPosition, RVSign::ProhibitedSideType nProhibitedSide)
+void CAHRoadView::paintProhibitedSigns(RVDisplayList& dl, const CRect& rectRoad, int nRoadCenter, int nRoadWidth, int nPosition, RVSign::ProhibitedSideType nProhibitedSide)
 {
    int nSignHeight = 20;
 
@@ -1171,736 +1610,96 @@ void CAHRoadView::paintProhibitedSigns(CDC& dc, const CRect& rectRoad, int nRoad
 
    if ((nProhibitedSide == RVSign::PROHIBITED_LEFT) || (nProhibitedSide == RVSign::PROHIBITED_BOTH))
    {
-      paintSignPx(dc, rectProhibitedTop, TrafficSign::tsPrivate, 0, nPosition);
+      paintSignPx(dl, rectProhibitedTop, TrafficSign::tsPrivate, 0, nPosition);
    }
    if ((nProhibitedSide == RVSign::PROHIBITED_RIGHT) || (nProhibitedSide == RVSign::PROHIBITED_BOTH))
    {
-      paintSignPx(dc, rectProhibitedBottom, TrafficSign::tsPrivate, 0, nPosition);
+      paintSignPx(dl, rectProhibitedBottom, TrafficSign::tsPrivate, 0, nPosition);
    }
 };
 
-bool CAHRoadView::paintText(CDC& dc, const CRect& rectRoad, int nPosition, CString szLinkId, COLORREF color)
+bool CAHRoadView::paintText(RVDisplayList& dl, const CRect& rectRoad, int nPosition, CString szLinkId, RVDisplayList::StyleId nStyle)
 {
    nPosition -= 16;
 
-   CFont* pOldFont = dc.SelectObject(&fontText);
-      COLORREF OldColor = dc.SetTextColor(color);
-         int nOldMode = dc.SetBkMode(TRANSPARENT);
-            dc.TextOut(nPosition, ((rectRoad.top + rectRoad.bottom) / 2) - (16/2) - 1, szLinkId);
- 	      dc.SetBkMode(nOldMode);
-      OldColor = dc.SetTextColor(OldColor);
-   dc.SelectObject(pOldFont);
+   dl.text(nStyle, nPosition, ((rectRoad.top + rectRoad.bottom) / 2) - (16/2) - 1, szLinkId);
 
    return true;
 };
 
-//////////////////
-// Worker method
-// To get Road infos along the MPP and fill RVSign and RVAreas for later drawing
+/////////////////////////////////////////////////////////
+// RVHorizonSource (over the AH Horizon Container and DAL)
 
-void CAHRoadView::getPathInfos()
+void CAHRoadView::getMostProbablePath(std::vector<Uint32>& mpp)
 {
-   // Get the attributes along the Horizon
-   ADAS::HorizonContainer* ahc = context.ahc;
-   ADAS::HorizonLinks&     links = ahc->getLinks();
-   ADAS::HorizonAttributes&    pts = ahc->getAttributes();
-	bool	bRightSideDrive = true;
-   // Get the MPP
-   std::vector<Uint32> mpp;
-   links.getMostProbablePath(mpp);
-	if (mpp.size() > 0)
-	{
-		UDAL::Link *root = context.dal->createLink(links.getLinkById(mpp.at(0)).getInternalId());
-		if (root != NULL)
-		{
-			if (root->getDrivingSide() == 2)
-			{
-				bRightSideDrive = false;
-			}
-			context.dal->deleteLink(root);
-		}
-	}
-   
-   Uint32 n = pts.getSize();         // the number of Attribute points on the Horizon
-
-   m_signs.RemoveAll();              // Clear the Signs and Areas vectors
-   m_areas.RemoveAll();
-   
-   // RVSign parameters
-   struct TrafficSignView::Hint hintLanes;
-   struct TrafficSignView::Hint hintCrossing;
-   hintLanes.sign                             = TrafficSign::tsInvalid;
-   hintLanes.param                            = 0;
-   hintCrossing.sign                          = TrafficSign::tsInvalid;
-   hintCrossing.param                         = 0;
-   float fSizeOfCrossing                      = 0.0;
-   RVSign::CrossingSideType nCrossingSide     = RVSign::CROSSING_UNKNOWN;
-   RVSign::ProhibitedSideType nProhibitedSide = RVSign::PROHIBITED_NONE;
-   Uint32 nLinkId                             = 0;
-   Sint32 nLinkLength                         = 0;
-
-   // RVArea parameters
-   struct TrafficSignView::Hint hintAreas;
-   hintAreas.sign       = TrafficSign::tsInvalid;
-   hintAreas.param      = 0;
-
-   getStartNbOfLanes(mpp, pts);   // Get m_nStartNbOfLanes and m_bIsStartInTunnel / m_bIsStartInRoundabout (used here as bIsStartInArea)
-
-   unsigned int nMaxLanes = 0;
-   Sint32 nAreaStart = 0;
-   Sint32 nAreaEnd = 0;
-   bool bIsStartInArea = false;
-   bool bFoundAreaContinuation = false;
-
-   unsigned int nPreviousNbOfLanes = m_nStartNbOfLanes;
-   unsigned int nLastFoundNbOfLanes = m_nStartNbOfLanes;
-
-   Sint32 nPreviousDist    = 0;           // Float64 = 0.0
-
-   for (Uint32 i = 0;  i < n;  i++)       // loop over the Attribute points on Horizon 
-   {
-      ADAS::HorizonAttribute ahat;        // to store the info structure of the current point on the Horizon
-      Float64  fProbability;              // to store the Probability of the current point on the Horizon
-	   
-      // get info for the n'th nearest point on Horizon and store it in "fProbability" and "ahat"
-      Sint32   nDistCM = pts.getNearest(i, &fProbability, &ahat);  
-      Sint32   nDist = nDistCM / 100;
-      // TODO: The distance returned in nDistCM is the shortest distance between the Start of the Horizon
-      // and the attribute. This distance is not necessarely the distance on the MPP if multiple paths
-      // lead to the attribute. The correct distance along the MPP has to be retrieved here.
-
-      if (isAttributeOnMPP(&ahat, mpp) && (nDist > 0))  // checks if point is on MPP and fills the RVSign
-	   {
-         // We group all the found attributes by distance. So, if there are no more infos for the current nDist,
-         // we can add the infos to the RVAreas and RVSign vectors now.
-         if ((nDist != nPreviousDist) && (nPreviousDist != 0.0))
-         {
-            if (bFoundAreaContinuation)   // If the Tunnel/Roundabout area just continues here, then do nothing
-            {
-               bFoundAreaContinuation = false;
-            }
-            else  // If we found no Tunnel/Roundabout continuation, this means that the Tunnel/Roundabout end is on the previous link
-            {
-               // Check if we have Area infos to add
-               if ((bIsStartInArea && (nAreaStart == 0)) || (nAreaStart != 0))
-               {
-                  nAreaEnd = nPreviousDist;
-                  m_areas.Add(RVAreas(hintAreas.sign, nAreaStart, nAreaEnd, nMaxLanes));
-                  // reset Area parameters
-                  nAreaStart = 0;
-                  nAreaEnd = 0;
-                  nMaxLanes = 0;
-                  bIsStartInArea = false;  // to avoid writing the starting Tunnel again
-               }
-            }
-            // Check if we have Lane or Crossing infos to add
-            if (((hintLanes.sign != TrafficSign::tsInvalid) || (hintCrossing.sign != TrafficSign::tsInvalid)))
-            {  
-               // There has to be a number of lanes defined at each crossing! If it is not the case, set it to the last found one.
-               if (hintLanes.param == 0)
-               {
-                  hintLanes.param = nLastFoundNbOfLanes;
-               }
-               // Now add the attributes to the Sign array              
-               m_signs.Add(RVSign(hintLanes.sign, hintLanes.param, hintCrossing.sign, fSizeOfCrossing, nPreviousDist, nCrossingSide, nProhibitedSide, nLinkId));
-               if (TrafficSign::tsInvalid != hintLanes.sign) {
-                  m_tsAreas.Add(RVAreas(hintLanes.sign, nPreviousDist, nPreviousDist, 0, hintLanes.param));
-               }
-
-               nLastFoundNbOfLanes = hintLanes.param;
-
-               // reset Signs infos
-               hintLanes.sign      = TrafficSign::tsInvalid;
-               hintLanes.param     = 0;
-               hintCrossing.sign   = TrafficSign::tsInvalid;
-               fSizeOfCrossing     = 0.0;
-               nCrossingSide       = RVSign::CROSSING_UNKNOWN;
-               nProhibitedSide     = RVSign::PROHIBITED_NONE;
-            }           
-         }  // End of grouping by distance part
-
-         switch (ahat.type)      // Check kind of attributes we get, look for interesting attributes
-         {
-            case ADAS::ahatNumberOfLanesFromSC:
-               {
-                  unsigned int nNew = ahat.info & 0xFFFFL;
-                  //unsigned int nOld = (ahat.info & 0x7FFF0000) >> 16;
-						hintLanes.sign = nNew == nPreviousNbOfLanes ? TrafficSign::tsInvalid : // Do not draw lanes sign if lanes nb is identical
-												nNew > nPreviousNbOfLanes ? (bRightSideDrive ? TrafficSign::tsLanesInc : TrafficSign::tsLanesIncRight)
-												: (bRightSideDrive ? TrafficSign::tsLanesDec : TrafficSign::tsLanesDecRight);
-                  hintLanes.param = nNew;
-                  
-                  nPreviousNbOfLanes = nNew;
-
-                  if (nNew > nMaxLanes)
-                  {
-                     nMaxLanes = nNew;
-                     m_nMaxLanes = nMaxLanes;
-                  }
-
-                  nLinkId = ahat.nLinkId;
-                  nLinkLength = ahat.nLengthCM / 100;
-
-                  break;
-               };
-            case ADAS::ahatCrossingSame:
-               hintCrossing.sign = TrafficSign::tsCrossing;
-               fSizeOfCrossing = m_fCrossingWidthFactorSame;
-               nCrossingSide = getCrossingSide(links, ahat.nLinkId, mpp, &nProhibitedSide); //  nNextLinkId
-               nLinkId = ahat.nLinkId;
-               break;
-
-            case ADAS::ahatCrossingSmall:
-               hintCrossing.sign = TrafficSign::tsPriorityCrossing;
-               fSizeOfCrossing = m_fCrossingWidthFactorSmall;
-               nCrossingSide = getCrossingSide(links, ahat.nLinkId, mpp, &nProhibitedSide);
-               nLinkId = ahat.nLinkId;
-               break;
-
-            case ADAS::ahatCrossingBig:
-               hintCrossing.sign = TrafficSign::tsGiveWay;
-               fSizeOfCrossing = m_fCrossingWidthFactorBig;
-               nCrossingSide = getCrossingSide(links, ahat.nLinkId, mpp, &nProhibitedSide);
-               nLinkId = ahat.nLinkId;
-               break;
-
-            case ADAS::ahatTunnel:           // Here we define the area limits
-            case ADAS::ahatRoundabout:
-               hintAreas.sign = ahat.type == ADAS::ahatTunnel ? TrafficSign::tsTunnel : TrafficSign::tsRoundabout;
-               bIsStartInArea = ahat.type == ADAS::ahatTunnel ? m_bIsStartInTunnel : m_bIsStartInRoundabout;
-               if (nAreaStart == 0.0)
-               {
-                  if (!bIsStartInArea)
-                  {
-                     nAreaStart = nDist;
-                  }
-               }
-               bFoundAreaContinuation = true;
-               break;
-
-         } // end of switch
-
-         nPreviousDist = nDist;
-
-      } // end of isAttributeOnMPP (on MPP) condition check
-   } // end of loop on Horizon points
-
-   // SIGNS: If we found a Crossing or lane change at the end, add it here
-   if (((hintLanes.sign != TrafficSign::tsInvalid) || (hintCrossing.sign != TrafficSign::tsInvalid)))
-   {  
-      // There has to be a number of lanes defined at each crossing! If it is not the case, set it to the last found one.
-      if (hintLanes.param == 0)
-      {
-         hintLanes.param = nLastFoundNbOfLanes;
-      }
-      // Now add the attributes to the Sign array              
-      m_signs.Add(RVSign(hintLanes.sign, hintLanes.param, hintCrossing.sign, fSizeOfCrossing, nPreviousDist, nCrossingSide, nProhibitedSide, nLinkId));
-      if (TrafficSign::tsInvalid != hintLanes.sign) {
-         m_tsAreas.Add(RVAreas(hintLanes.sign, nPreviousDist, nPreviousDist, 0, hintLanes.param));
-      }
-   } else {
-      // fix 2006/04/03: Create a last entry until the end of the last segment to complete the Horizon to be drawn
-      m_signs.Add(RVSign(TrafficSign::tsInvalid, hintLanes.param, TrafficSign::tsInvalid, 0.0, nPreviousDist + nLinkLength, nCrossingSide, nProhibitedSide, nLinkId));
-   }
-   // AREAS: If we didn't reach the End of the Area, then add the area info to the Area array
-   if (((nAreaStart != 0) || (bIsStartInArea && bFoundAreaContinuation && (nAreaStart == 0)) ) && (nAreaEnd == 0.0))
-   {
-      m_areas.Add(RVAreas(hintAreas.sign, nAreaStart, nAreaEnd, nMaxLanes));
-   }
-
-   RVSign *pSignBegin = m_signs.GetData();
-   RVSign *pSignEnd = pSignBegin + m_signs.GetCount();   // Must point behind the last element!
-   std::sort(pSignBegin, pSignEnd, RVSign::compareByDistance);
-
-   RVAreas *pAreaBegin = m_areas.GetData();
-   RVAreas *pAreaEnd = pAreaBegin + m_areas.GetCount();  // Must point behind the last element!
-   std::sort(pAreaBegin, pAreaEnd);
-
-   m_tsAreas.Append(m_areas);
-
-   Invalidate();
+   context.ahc->getLinks().getMostProbablePath(mpp);
 };
 
-int CAHRoadView::getLanes(ADAS::HorizonAttributes &attrs, ADAS::HorizonAttribute &ahat)
-{
-   // FIXME: If ahat is at end of link, check number of lanes at next link!
-   std::vector<ADAS::HorizonAttribute> attrsLane;
-   attrs.getLinkAttributes(ahat.nLinkId, attrsLane, ADAS::ahatADASNumberOfLanes);
-   if (1 != attrsLane.size()) {
-      return 1;   // For lack of better knowledge.
-   }
-   int nLanes = attrsLane[0].info;
-   attrsLane.clear();
-   attrs.getLinkAttributes(ahat.nLinkId, attrsLane, ADAS::ahatRightWay);
-   if (1 == attrsLane.size()) {
-      // One way road - maybe motorway carriageway ot something similar.
-      // In any case, we don't consider the opposing lanes.
-      return nLanes;
-   }
-   attrsLane.clear();
-   attrs.getLinkAttributes(ahat.nLinkId, attrsLane, ADAS::ahatADASOppositeNumberOfLanes);
-   if (1 == attrsLane.size()) {
-      nLanes += 64 * attrsLane[0].info;   // Traffic sign coding.
-   }
-   return nLanes;
-}
 
-// Get the Traffic Signs on the MPP and store them in an Area structure
-void CAHRoadView::getTSAreas()
+Sint32 CAHRoadView::getLinkLengthCM(Uint32 nLinkId)
 {
-   // Get the attributes along the Horizon
-   ADAS::HorizonContainer* ahc = context.ahc;
-   ADAS::HorizonLinks&     links = ahc->getLinks();
-   ADAS::HorizonAttributes&    pts = ahc->getAttributes();
-
-   // Get the MPP
-   std::vector<Uint32> mpp;
-   links.getMostProbablePath(mpp);
-   
-   Uint32 n = pts.getSize();         // the number of Attribute points on the Horizon
-
-   // RVSign parameters
-   struct TrafficSignView::Hint hintTS;
-
-   hintTS.sign                             = TrafficSign::tsInvalid;
-   hintTS.param                            = 0;
-   hintTS.bIsSign                          = true;
-
-   for (Uint32 i = 0;  i < n;  i++)       // loop over the Attribute points on Horizon 
-   {
-      ADAS::HorizonAttribute ahat;        // to store the info structure of the current point on the Horizon
-      Float64  fProbability;              // to store the Probability of the current point on the Horizon
-	   
-      // get info for the n'th nearest point on Horizon and store it in "fProbability" and "ahat"
-      Sint32   nDistCM = pts.getNearest(i, &fProbability, &ahat);  
-      Sint32   nDist = nDistCM / 100;
-      // TODO: The distance returned in nDistCM is the shortest distance between the Start of the Horizon
-      // and the attribute. This distance is not necessarely the distance on the MPP if multiple paths
-      // lead to the attribute. The correct distance along the MPP has to be retrieved here.
-
-      int nAreaStart = 0;
-      int nAreaEnd = 0;
-
-      // Extract the Traffic Sign Information coded in the Attribute info with the TrafficSignInfo enum
-      union ADAS::TrafficSignInfo tsi;
-      tsi.unit = ahat.info;
-
-      if (isAttributeOnMPP(&ahat, mpp) && (nDist > 0))
-      {
-         nAreaStart = nDist;
-         nAreaEnd = nAreaStart;
-         int nDistanceOrDuration = 0;
-         bool bDuration = false;
+   return context.ahc->getLinks().getLinkById(nLinkId).getLengthCM();
+};
 
-         if (tsi.bits.m_validityFlag == ADAS::TrafficSignValidityFlag::tsValidityStart)
-         {
-            //nAreaStart += ahat.nLengthCM / 100;
-            nDistanceOrDuration = ahat.nLengthCM / 100;
-            bDuration = false;
-         }
-         if (tsi.bits.m_validityFlag == ADAS::TrafficSignValidityFlag::tsValidityDuration)
-         {
-            nAreaEnd += ahat.nLengthCM / 100;
-            nDistanceOrDuration = ahat.nLengthCM / 100;
-            bDuration = true;
-         }
 
-         switch (ahat.type)      // Check kind of attributes we get, look for interesting attributes
-         {
-            case ADAS::ahatTSPedestrianXing:
-               hintTS.sign  = TrafficSign::tsPedestrian;
-               //hintTS.param = tsi.bits.m_nNumber;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));             
-               //nLinkId = ahat.nLinkId;
-               break;
-            case ADAS::ahatTSPedestrianCrosswalk:
-               hintTS.sign = TrafficSign::tsPedestrianCrossing;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-            case ADAS::ahatTSTrafficLight:
-               hintTS.sign  = TrafficSign::tsTrafficLight;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, 0, false, false));
-               break;
-            case ADAS::ahatTSTrafficLightSign:
-               hintTS.sign = TrafficSign::tsTrafficLight;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRightofWayRoad:
-               hintTS.sign  = TrafficSign::tsRightOfWay;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRightOfWayCrossing:
-               hintTS.sign = TrafficSign::tsPriorityCrossing;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSEndOfTown:
-               hintTS.sign = TrafficSign::tsUrbanAreaEnd;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSEqualIntersection:
-               hintTS.sign = TrafficSign::tsCrossing;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSYield:
-               hintTS.sign = TrafficSign::tsGiveWay;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSStop:
-               hintTS.sign = TrafficSign::tsStop;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSWarning:
-               hintTS.sign = TrafficSign::tsWarning;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSharpCurveLeft:
-               hintTS.sign = TrafficSign::tsLeftTurn;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSharpCurveRight:
-               hintTS.sign = TrafficSign::tsRightTurn;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSCurveLeft:
-               hintTS.sign = TrafficSign::tsSCurveLeft;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSCurveRight:
-               hintTS.sign = TrafficSign::tsSCurveRight;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSUnevenRoad:
-               hintTS.sign = TrafficSign::tsUnevenRoad;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSIcyRoad:
-               hintTS.sign = TrafficSign::tsIcyRoad;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSlipperyRoad:
-               hintTS.sign = TrafficSign::tsSlipperyRoad;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSFallingRocks:
-               hintTS.sign = TrafficSign::tsFallingRocks;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRoadNarrowingLeft:
-               hintTS.sign = TrafficSign::tsRoadNarrowingLeft;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRoadNarrowingRight:
-               hintTS.sign = TrafficSign::tsRoadNarrowingRight;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRoadNarrowingBothSides:
-               hintTS.sign = TrafficSign::tsRoadNarrowingBothSides;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSTrafficCongestion:
-               hintTS.sign = TrafficSign::tsTrafficCongestion;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSAnimals:
-               hintTS.sign = TrafficSign::tsAnimals;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSChildren:
-               hintTS.sign = TrafficSign::tsChildren;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSOvertakeCC:
-               hintTS.sign = ahat.bIsStart ? TrafficSign::tsOvertakeAllowed : TrafficSign::tsOvertakeProhibited;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSOvertakeTC:
-               hintTS.sign = ahat.bIsStart ? TrafficSign::tsOvertakeTCAllowed : TrafficSign::tsOvertakeTCProhibited;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSEndOfAllProhibitions:
-               hintTS.sign = TrafficSign::tsEndOfAllProhibitions;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSEndPriorityRoad:
-               hintTS.sign = TrafficSign::tsEndPriorityRoad;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRailwayCrossingGates:
-               hintTS.sign = TrafficSign::tsRailwayCrossingGates;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRailwayCrossingNoGates:
-               hintTS.sign = TrafficSign::tsRailwayCrossingNoGates;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSTramway:
-               hintTS.sign = TrafficSign::tsTramway;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRailwayCrossing:
-               hintTS.sign = TrafficSign::tsRailwayCrossing;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSCompulsoryRoundabout:
-               hintTS.sign = TrafficSign::tsCompulsoryRoundabout;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSCrossWind:
-               hintTS.sign = TrafficSign::tsCrossWind;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSAccidentHazard:
-               hintTS.sign = TrafficSign::tsAccidentHazard;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSRiskOfGrounding:
-               hintTS.sign = TrafficSign::tsRiskOfGrounding;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSPriorityOncomingTraffic:
-               hintTS.sign = TrafficSign::tsPriorityOncomingTraffic;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSYieldOncomingTraffic:
-               hintTS.sign = TrafficSign::tsYieldOncomingTraffic;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSteepUphill:
-               hintTS.sign = TrafficSign::tsSlope;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, tsi.bits.m_nNumber, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSteepDownhill:
-               hintTS.sign = TrafficSign::tsSlopeNeg;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, tsi.bits.m_nNumber, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSpeedLimit:
-               hintTS.sign = ahat.bIsStart ? TrafficSign::tsSpeedLimit : TrafficSign::tsSpeedLimitEnd;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, tsi.bits.m_nNumber, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatTSSignLanes:
-               {
-                  hintTS.sign = TrafficSign::tsLanes;
-                  int nCurLanes = getLanes(pts, ahat);
-                  m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, (1 == (nCurLanes & 0x3f)) ? (2 + (nCurLanes & ~0x3f)) : nCurLanes - 1, nDistanceOrDuration, bDuration, true));
-               }
-               break;
-            case ADAS::ahatTSSignExtraLaneLeft:
-               {
-                  hintTS.sign = TrafficSign::tsLanesInc;
-                  int nCurLanes = getLanes(pts, ahat) & 0x3f;
-                  m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, nCurLanes + 1, nDistanceOrDuration, bDuration, true));
-               }
-               break;
-            case ADAS::ahatTSSignExtraLaneRight:
-               {
-                  hintTS.sign = TrafficSign::tsLanesIncRight;
-                  int nCurLanes = getLanes(pts, ahat) & 0x3f;
-                  m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, nCurLanes + 1, nDistanceOrDuration, bDuration, true));
-               }
-               break;
-            case ADAS::ahatTSSignLaneMergeLeft:
-               {
-                  hintTS.sign = TrafficSign::tsLanesDec;
-                  int nCurLanes = getLanes(pts, ahat) & 0x3f;
-                  m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, (1 == nCurLanes) ? 1 : nCurLanes - 1, nDistanceOrDuration, bDuration, true));
-               }
-               break;
-            case ADAS::ahatTSSignLaneMergeRight:
-               {
-                  hintTS.sign = TrafficSign::tsLanesDecRight;
-                  int nCurLanes = getLanes(pts, ahat) & 0x3f;
-                  m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, (1 == nCurLanes) ? 1 : nCurLanes - 1, nDistanceOrDuration, bDuration, true));
-               }
-               break;
-            case ADAS::ahatTSSignLaneMergeCenter:
-               hintTS.sign = TrafficSign::tsLanesDecCenter;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, getLanes(pts, ahat) - 1, nDistanceOrDuration, bDuration, true));
-               break;
-            case ADAS::ahatCustom3:
-               hintTS.sign = TrafficSign::tsFree;
-               m_tsAreas.Add(RVAreas(hintTS.sign, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, false));
-               break;
-            default:
-               break;
-         }
-      }
-   }
-   // Sort traffic signs by:
-   // * position,
-   // * sign itself,
-   // * additional information.
-   RVAreas *pBegin = m_tsAreas.GetData();
-   RVAreas *pEnd = pBegin + m_tsAreas.GetCount();  // Must point behind the last element!
-   std::sort(pBegin, pEnd);
-
-   // Then eliminate duplicate signs (same sign may be posted e.g. left and right or over multiple lanes).
-   int iSign = 0;
-   while (iSign < m_tsAreas.GetCount() - 1) { // At most the last but one entry.
-      if (m_tsAreas[iSign].getStart() == m_tsAreas[iSign + 1].getStart()
-         && m_tsAreas[iSign].getSign() == m_tsAreas[iSign + 1].getSign()) {
-            // We don't expect differences in other properties.
-            m_tsAreas.RemoveAt(iSign + 1);
-      } else {
-         iSign++;
-      }
-   }
+bool CAHRoadView::isInCity(Uint32 nLinkId)
+{
+   return context.ahc->getLinks().getLinkById(nLinkId).isInCity() ? true : false;
 };
 
 
-bool CAHRoadView::getStartNbOfLanes(std::vector<Uint32>& mpp, ADAS::HorizonAttributes&  pts)
+bool CAHRoadView::isRightSideDrive(Uint32 nLinkId)
 {
-   Uint32  n = pts.getSize();
-   m_bIsStartInTunnel = false;
-   m_bIsStartInRoundabout = false;
-
-   // The information about the root link is stored in the attributes of the start node which is behind us.
-   // Therefore, we have to search in the negative distance values for the Nb of Lanes attribute of the Root link
-   //while((nDist < 0) && (i > 0))
-   for (int i = n - 1; i > 0; i--)
+   bool bRightSideDrive = true;
+   UDAL::Link *link = context.dal->createLink(context.ahc->getLinks().getLinkById(nLinkId).getInternalId());
+   if (link != NULL)
    {
-      //i--;
-      ADAS::HorizonAttribute ahat;   // to store the info structure of the current point on Horizon
-      Float64          fProbability;
-      Sint32           nDistCM = pts.getNearest(i, &fProbability, &ahat);  
-
-      if ((isAttributeOnMPP(&ahat, mpp)) && (fProbability != 0) && (nDistCM < 0))
+      if (link->getDrivingSide() == 2)
       {
-         switch(ahat.type)
-         {
-            case ADAS::ahatNumberOfLanesFromSC:    // Set the start number of Lanes
-               m_nStartNbOfLanes = ahat.info & 0xFFFFL;
-               break;
-            case ADAS::ahatTunnel:           // detect if we are in a Tunnel
-               m_bIsStartInTunnel = true;
-               break;
-            case ADAS::ahatRoundabout:       // detect if we are on a Roundabout
-               m_bIsStartInRoundabout = true;
-               break;
-         }
+         bRightSideDrive = false;
       }
+      context.dal->deleteLink(link);
    }
-
-   return true;
-   
+   return bRightSideDrive;
 };
 
-// Returns the crossing sides between a parent link whose ID is provided and its Child links excluding the next link on the MPP
-RVSign::CrossingSideType CAHRoadView::getCrossingSide(ADAS::HorizonLinks& links, Uint32 nCurrentLinkId, std::vector<Uint32>& mpp, RVSign::ProhibitedSideType* nProhibitedSide) // Uint32 nNextLinkId
+
+void CAHRoadView::getBranches(Uint32 nLinkId, std::vector<RVBranch>& branches)
 {
-   ADAS::HorizonLink &currentLink = links.getLinkById(nCurrentLinkId);
-   RVSign::CrossingSideType nCrossingSide = RVSign::CROSSING_UNKNOWN;
+   ADAS::HorizonLinks& links = context.ahc->getLinks();
+   ADAS::HorizonLink &currentLink = links.getLinkById(nLinkId);
 
    for (int i = 0; i < currentLink.getChilds(); i++)
    {
       ADAS::HorizonLink& child = links.getLinkById(currentLink.getChild(i));
 
-      if (!isIdOnMPP(child.getId(), mpp)
-         && memcmp(child.getInternalId(), currentLink.getInternalId(), currentLink.getInternalIdSize()))  // Ignore the link if it's the next link on the MPP, or if it's a U-turn.
+      if (memcmp(child.getInternalId(), currentLink.getInternalId(), currentLink.getInternalIdSize()))  // Ignore the link if it's a U-turn.
       {
-         //ADAS::HorizonLink& child = links.getLinkById(nChildId);
-         int nChildTurnAngle = child.getParentTurnAngleDegreesById(nCurrentLinkId);
-         if (nChildTurnAngle < 0)  // Left Turn
-         {
-            nCrossingSide = nCrossingSide == RVSign::CROSSING_LEFT ? RVSign::CROSSING_LEFT:
-                            nCrossingSide == RVSign::CROSSING_UNKNOWN ? RVSign::CROSSING_LEFT:
-                            nCrossingSide == RVSign::CROSSING_RIGHT ? RVSign::CROSSING_BOTH:
-                            RVSign::CROSSING_BOTH;
-
-            // Determine if this link is prohibited (wrong-way)
-            if (child.getProbability() == 0.0)
-            {
-               *nProhibitedSide = *nProhibitedSide == RVSign::PROHIBITED_RIGHT ? RVSign::PROHIBITED_BOTH:
-                                  *nProhibitedSide == RVSign::PROHIBITED_BOTH ? RVSign::PROHIBITED_BOTH:
-                                   RVSign::PROHIBITED_LEFT;
-            }
-         }
-         if (nChildTurnAngle > 0)  // Right Turn
-         {
-            nCrossingSide = nCrossingSide == RVSign::CROSSING_LEFT ? RVSign::CROSSING_BOTH:
-                            nCrossingSide == RVSign::CROSSING_UNKNOWN ? RVSign::CROSSING_RIGHT:
-                            nCrossingSide == RVSign::CROSSING_RIGHT ? RVSign::CROSSING_RIGHT:
-                            RVSign::CROSSING_BOTH;
-
-            // Determine if this link is prohibited (wrong-way)
-            if (child.getProbability() == 0.0)
-            {
-               *nProhibitedSide = *nProhibitedSide == RVSign::PROHIBITED_LEFT ? RVSign::PROHIBITED_BOTH:
-                                  *nProhibitedSide == RVSign::PROHIBITED_BOTH ? RVSign::PROHIBITED_BOTH:
-                                   RVSign::PROHIBITED_RIGHT;
-            }
-         }
-
-      };
-   };
-
-   return nCrossingSide;
+         RVBranch branch;
+         branch.nLinkId = child.getId();
+         branch.nTurnAngleDegrees = child.getParentTurnAngleDegreesById(nLinkId);
+         branch.fProbability = child.getProbability();
+         branches.push_back(branch);
+      }
+   }
 };
 
-// returns Current/ADAS or Expected speed on link with provided Id - added by sdrehe to account for ADAS Speed Limits
-Uint32 CAHRoadView::getSpeedOnLink(Uint32 nLinkId, ADAS::HorizonAttributes&  pts)
-{
-   Uint32 nCurrentSpeed = 0;
-   Uint32 nExpectedSpeed = 0;
-
-   // Puts the attributes of the Horizon in the ahat vector
-   std::vector<ADAS::HorizonAttribute> ahat;    
-   pts.getLinkAttributes(nLinkId, ahat);
-
-   // Look for speed attributes
-   for (Uint32 i = 0;  i < ahat.size();  i++)
-   {
-      switch(ahat[i].type)
-         {
-            case ADAS::ahatCurrentSpeed:
-               nCurrentSpeed = ahat[i].info;
-               break;
-            case ADAS::ahatExpectedSpeedFromSC:
-               nExpectedSpeed = ahat[i].info;
-               break;
-         }
-   };
-   // If the Current/ADAS Speed Limit is not defined take the Expected Speed Limit (from the Speed Cat)
-   Uint32 sp = (nCurrentSpeed != 0) ? nCurrentSpeed : nExpectedSpeed;
-   m_bIsCurrentSpeed = (nCurrentSpeed != 0) ? true : false;
 
-   return sp;
+Uint32 CAHRoadView::getAttributeCount()
+{
+   return context.ahc->getAttributes().getSize();
 };
 
 
-// Check if attribute is on MPP
-bool CAHRoadView::isAttributeOnMPP(ADAS::HorizonAttribute* pt, std::vector<Uint32>& mpp)
+Sint32 CAHRoadView::getNearestAttribute(Uint32 nIndex, Float64* pfProbability, ADAS::HorizonAttribute* pAttr)
 {
-   bool bIn = false;
-   for (Uint32 i = 0;  !bIn && i < mpp.size();  i++)
-   {
-      bIn = pt->nLinkId == mpp[i];
-   };
-   if (!bIn)
-   {
-      return false;
-   }
-   else
-	{
-       return true;
-   };
+   return context.ahc->getAttributes().getNearest(nIndex, pfProbability, pAttr);
 };
 
 
-// Check if the link with given ID is on MPP
-bool CAHRoadView::isIdOnMPP(Uint32 nLinkId, std::vector<Uint32>& mpp)
+void CAHRoadView::getLinkAttributes(Uint32 nLinkId, std::vector<ADAS::HorizonAttribute>& attrs)
 {
-   bool bIn = false;
-   for (Uint32 i = 0;  !bIn && i < mpp.size();  i++)
-   {
-      bIn = nLinkId == mpp[i];
-   };
-   if (!bIn)
-   {
-      return false;
-   }
-   else
-	{
-       return true;
-   };
+   context.ahc->getAttributes().getLinkAttributes(nLinkId, attrs);
 };
 
 
@@ -1912,7 +1711,13 @@ void CAHRoadView::showPreferencesDialog()
    if (IDOK != dlg.DoModal()) {
       return;
    }
+   if (dlg.m_nLaneWidthFactor != m_nLaneWidthFactor)
+   {
+      m_arcCache.clear();
+   }
    (Preferences &) *this = (Preferences &) dlg;
+   m_gdiBackend.releaseObjects();
+   m_stageStats.setEnabled(m_bDebug != FALSE);
 
 #pragma warning(disable: 4800)   // Assign BOOL to bool.
    setProfileInt("Max Lanes", m_nLaneWidthFactor);
@@ -1935,6 +1740,8 @@ void CAHRoadView::showPreferencesDialog()
    setProfileInt(_T("City Out Scale"), m_nCityOutScale / 100);
    setProfileBool(_T("Debug") ,m_bDebug);
 #pragma warning(default: 4800)   // Assign BOOL to bool.
+
+   invalidateLayers(LAYER_ALL);
 }
 
 void CAHRoadView::OnConfigure()
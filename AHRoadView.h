@@ -13,16 +13,26 @@
 #pragma once
 
 #include "stdafx.h"
+#include <mutex>
 #include "PreferencesDialog.h"
 #include "ADASRP.Libs\EHPI\EHPlugIn.h"
 #include "RVAreas.h"
 #include "RVSign.h"
+#include "RVRoadModelBuilder.h"
+#include "RVRebuildScheduler.h"
+#include "RVLayer.h"
+#include "RVDisplayList.h"
+#include "RVGdiBackend.h"
+#include "RVDirtyRegion.h"
+#include "RVArcCache.h"
+#include "RVStageStats.h"
+#include "RVHorizonRecorder.h"
 #include "Resource.h"
 //#include"ADASRP.Libs\NTMFCUtils\inc\NTLayout.h"
 
 
 
-class CAHRoadView : public CEHPlugIn, public Preferences
+class CAHRoadView : public CEHPlugIn, public Preferences, public RVHorizonSource
 {
 
 public: // Constructor/Destructor
@@ -44,6 +54,18 @@ public: // AH Listener
    virtual Sint16 onRootLinkMsg       (const MASSIVE::AHRootLinkMsg& msg);
 
 
+public: // RVHorizonSource
+
+   virtual void   getMostProbablePath(std::vector<Uint32>& mpp);
+   virtual Sint32 getLinkLengthCM(Uint32 nLinkId);
+   virtual bool   isInCity(Uint32 nLinkId);
+   virtual bool   isRightSideDrive(Uint32 nLinkId);
+   virtual void   getBranches(Uint32 nLinkId, std::vector<RVBranch>& branches);
+   virtual Uint32 getAttributeCount();
+   virtual Sint32 getNearestAttribute(Uint32 nIndex, Float64* pfProbability, ADAS::HorizonAttribute* pAttr);
+   virtual void   getLinkAttributes(Uint32 nLinkId, std::vector<ADAS::HorizonAttribute>& attrs);
+
+
 public: // VP Listener
 
    virtual Sint16 onVPMessage(const MASSIVE::VPMessage& rMsg);
@@ -59,72 +81,89 @@ public: // Messages
    afx_msg void OnSize(UINT nType, int cx, int cy);
 	afx_msg BOOL OnMouseWheel(UINT nFlags, short zDelta, CPoint pt);
    afx_msg void OnDestroy();
+   afx_msg void OnTimer(UINT_PTR nIDEvent);
    afx_msg void OnContextMenu(CWnd* /*pWnd*/, CPoint point);
    afx_msg void OnConfigure();
+   afx_msg LRESULT OnDpiChanged(WPARAM wParam, LPARAM lParam);
+   afx_msg LRESULT OnModelPublished(WPARAM wParam, LPARAM lParam);
 
 private: // Worker method
 
    void showPreferencesDialog();
+   /** Runs the pending rebuild on the current Horizon and publishes the model (m_rebuildLock held) */
+   void rebuildModel();
+   /** Publishes the model of the builder and posts WM_RV_MODEL_PUBLISHED (m_rebuildLock held) */
+   void publishModel();
 
 
-   /** Gets all the infos along the MPP to build the Road View (Crossings, Lane changes, Crossing Sides, Prohibited Roads). */
-   void getPathInfos();
-   /** Gets the number of lane on the root link */
-   bool getStartNbOfLanes(std::vector<Uint32>& mpp, ADAS::HorizonAttributes&  pts);
-   /** Gets the Side of the Crossing at the end of the link with id nLinkId */
-   RVSign::CrossingSideType getCrossingSide(ADAS::HorizonLinks& links, Uint32 nLinkId, std::vector<Uint32>& mpp, RVSign::ProhibitedSideType* nProhibitedSide); // Uint32 nNextLinkId
-
-   /** Creates arrays for the arc-shaped transition in lane change areas */
-   int  ArcPoints                   (CArray<CPoint, CPoint>& PolyPtsArray, CArray<CPoint, CPoint>& PolyPtsLineArray, int xPolyRefPoint, int yPolyRefPoint, int nRadius, double fAngle, bool bIsArcUp, bool bIsArcRight, int nVerticalOffset);
-   /** To check if attribute points are on the MPP */
-	bool isAttributeOnMPP            (ADAS::HorizonAttribute* pt, std::vector<Uint32>& mpp);
-   /** Check if the link with given ID is on the MPP */
-   bool isIdOnMPP                   (Uint32 nLinkId, std::vector<Uint32>& mpp);
-   /** Retrieves the Speed Limit (Current/ADAS or Expected) on the link whose Id is provided */
-   Uint32 getSpeedOnLink(Uint32 nLinkId, ADAS::HorizonAttributes&  pts);
-   /** Get number of lanes on the link that ahat refers to. Add opposing lanes * 64. */
-   int CAHRoadView::getLanes(ADAS::HorizonAttributes &attrs, ADAS::HorizonAttribute &ahat);
-   /** Get Traffic Signs along the MPP and store them in an Area strcuture */
-   void getTSAreas();
-   
-
 private: // Painting
 
+   /** Layers of the Road View, combined into the mask of the layers to re-render */
+   enum Layer
+   {
+      LAYER_STATIC   = 0x1,      // Background and scale ruler: depend on the window size, the scale and the preferences
+      LAYER_DYNAMIC  = 0x2,      // Car, Road, Signs: depend on the road model as well
+      LAYER_ALL      = LAYER_STATIC | LAYER_DYNAMIC
+   };
+
+   /** Marks the layers to be re-rendered by the next paint and invalidates the window */
+   void invalidateLayers(UINT nLayers);
+   /** Re-renders the invalid layers and composites them into the frame layer */
    void paintAll(CDC& dc, const CSize& sizeCanvas);
+   /** Paints the static layer, over the whole canvas */
+   void paintStaticLayer            (CDC& dc, const CSize& sizeCanvas, int wCar);
+   /** Lays the latest road model out into the display list (Root Link Signs, Road, Signs) */
+   void layoutDynamicLayer          (RVDisplayList& dl, const CSize& sizeCanvas, int wCar);
+   /** Paints the static layer and the dynamic layer into the frame layer, in the region only if given */
+   void renderFrameLayer            (const CSize& sizeCanvas, const RVDirtyRegion* pRegion);
+   /** Paints the dynamic layer (car, display list, Debug counters), over a copy of the static layer */
+   void paintDynamicLayer           (CDC& dc, const CSize& sizeCanvas);
 
    /** Paints the Plug-in window Background */
    void paintBackground             (CDC& dc, const CSize& sizeCanvas);
    /** Paints the car bitmap frtom the resources */
    int  paintCar                    (CDC& dc, const CSize& sizeCanvas);
-   /** Paints the scale ruler and the City Sign */
+   /** Returns the width paintCar() gives to the car (0 if the window is too narrow) */
+   int  getCarWidth                 (const CSize& sizeCanvas);
+   /** Returns the part of the window scrolled with the distance driven: the road and the signs above it */
+   CRect getRoadStrip               (const CSize& sizeCanvas, int wCar);
+   /** Paints the scale ruler */
    void paintScale                  (CDC& dc, const CSize& sizeCanvas, int wCar);
+   /** Paints the City Sign and the Speed Limit Sign of the Root Link, left of the scale */
+   void paintRootLinkSigns          (RVDisplayList& dl, const CSize& sizeCanvas, int wCar);
+   /** Paints the update and paint counters (Debug mode) */
+   void paintDebugStats             (CDC& dc, const CSize& sizeCanvas);
+   /** Paints the performance overlay at the top of the window (Debug mode) */
+   void paintHud                    (CDC& dc, const CSize& sizeCanvas);
+   /** Formats the lines of the performance overlay again */
+   void updateHud                   (DWORD nNowMs);
    /** Paints the Roundabout and Tunnel areas as background rectangles if ShowTunnels or Showroundabouts are set */
-   void paintAreas                  (CDC& dc, const CRect& rectRoad, CArray<RVAreas>& areas);
+   void paintAreas                  (RVDisplayList& dl, const CRect& rectRoad, const std::vector<RVAreas>& areas);
    /** Paints the whole Road View */
-   bool paintRoad                   (CDC& dc, const CSize& sizeCanvas, int wCar);
+   bool paintRoad                   (RVDisplayList& dl, const CSize& sizeCanvas, int wCar);
    /** Paints a straight road segment bewteen two transition areas (crossings or lane number changes) */
-   void paintRoadSegment            (CDC& dc, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes);
-   /** Paint the Lane separation lines */
-   int  paintLaneLine               (CDC& dc, int nStart, int nEnd, int nY, int nLineLength, int nGapLength);  // int nLastPixels
+   void paintRoadSegment            (RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes);
+   /** Paints the dashed Lane separation lines of a segment (and its central line if one lane) as one batch */
+   void paintLaneLines              (RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nRoadCenter, int nLaneWidth, int nNbOfLanes);
    /** Paints the Transition areas (Crossings or Lane number change) bewteen two Road segments */
-   void paintRoadSegmentTransition  (CDC& dc, const CRect& rectRoad, int nStart, int nEnd, int nPreviousNbOfLanes, int nNextNbOfLanes, float nSizeOfCrossing, RVSign::CrossingSideType nCrossingSide, RVSign::ProhibitedSideType nProhibitedSide, Uint32 nLinkId);
+   void paintRoadSegmentTransition  (RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nPreviousNbOfLanes, int nNextNbOfLanes, float nSizeOfCrossing, RVSign::CrossingSideType nCrossingSide, RVSign::ProhibitedSideType nProhibitedSide, Uint32 nLinkId);
    /** Paints a Crossing on the determined sides */
-   void paintCrossing               (CDC& dc, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nNextNbOfLanes, RVSign::CrossingSideType nCrossingSide);
+   void paintCrossing               (RVDisplayList& dl, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nNextNbOfLanes, RVSign::CrossingSideType nCrossingSide);
    /** Paint methods for lane number change accomodation areas */
-   void paintLaneIncrease           (CDC& dc, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes); // float fSizeOfCrossing
-   void paintLaneDecrease           (CDC& dc, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes); // float fSizeOfCrossing
+   void paintLaneIncrease           (RVDisplayList& dl, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes); // float fSizeOfCrossing
+   void paintLaneDecrease           (RVDisplayList& dl, int nStart, int nEnd, int nRoadCenter, int nRoadWidth, int nLaneWidth, int nPreviousNbOfLanes, int nNextNbOfLanes); // float fSizeOfCrossing
    /** Paints a hashed area if two crossings are too close */
-   void paintComplexCrossing        (CDC& dc, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes);
+   void paintComplexCrossing        (RVDisplayList& dl, const CRect& rectRoad, int nStart, int nEnd, int nNbOfLanes);
    /** Paints arrows showing the traffic flow direction */
-   void paintArrow                  (CDC& dc, int xCenter, int yCenter, bool bLeftToRigth, int nArrowWidthPixels);
+   void paintArrow                  (RVDisplayList& dl, int xCenter, int yCenter, bool bLeftToRigth, int nArrowWidthPixels);
    /** Paint text in the Plug-in window (for Debug) */
-   bool paintText                   (CDC& dc, const CRect& rectRoad, int nPosition, CString szText, COLORREF color = RGB(0, 0, 0));
+   bool paintText                   (RVDisplayList& dl, const CRect& rectRoad, int nPosition, CString szText, RVDisplayList::StyleId nStyle);
    
    /** Various methods to paint signs */
-   void paintSigns                  (CDC& dc, const CSize& sizeCanvas, int wCar);
-   void paintSign                   (CDC& dc, const CRect& rectSigns, int nTopRoad, const TrafficSign::Sign theSign, UINT nSignParam, int nDistanceM, bool bLength, int nDistFromStart, int &xLast, int iPos, bool bIsSign = false);
-   void paintSignPx                 (CDC& dc, const CRect& rectSigns, const TrafficSign::Sign theSign, UINT nSignParam, int nPosition);
-   void paintProhibitedSigns        (CDC& dc, const CRect& rectRoad, int nRoadCenter, int nRoadWidth, int nPosition, RVSign::ProhibitedSideType nProhibitedSide);
+   void paintSigns                  (RVDisplayList& dl, const CSize& sizeCanvas, int wCar);
+   void paintSign                   (RVDisplayList& dl, const CRect& rectSigns, int nTopRoad, const TrafficSign::Sign theSign, UINT nSignParam, int nDistanceM, bool bLength, int nDistFromStart, int &xLast, int iPos, bool bIsSign = false);
+   void paintSignPx                 (RVDisplayList& dl, const CRect& rectSigns, const TrafficSign::Sign theSign, UINT nSignParam, int nPosition);
+   void paintProhibitedSigns        (RVDisplayList& dl, const CRect& rectRoad, int nRoadCenter, int nRoadWidth, int nPosition, RVSign::ProhibitedSideType nProhibitedSide);
 
 private: // .INI settings
    CString            m_szCustomSignPath0;
@@ -143,27 +182,71 @@ private: // .INI settings
    CString            m_szCustomSignPath13;
    CString            m_szCustomSignPath14;
    CString            m_szCustomSignPath15;
+   CString            m_szStageStatsPath;    // File the stage latencies are dumped to in Debug mode, empty for none
+   bool               m_bShowHud;            // Performance overlay in Debug mode
+   CString            m_szHorizonRecordPath; // File the Horizon of the AH callbacks is appended to, empty for none
    
 
 private: // Data members
 
    int                m_nDisplayedLengthCM;
-   int                m_nStartNbOfLanes;
    int                m_nLineLength;
    int                m_nLineGapLength;
-   bool               m_bIsStartInTunnel;
-   bool               m_bIsStartInRoundabout;
-   bool               m_bIsInCity;
-   int                m_nSpeedOnRootLink;
-   bool               m_bIsCurrentSpeed;
-   int                m_nMaxLanes;
-
-   CArray<RVSign>     m_signs;
+
+   /** Road model built in the AH listener, painted from the latest published snapshot */
+   RVRoadModelBuilder m_builder;
+   RVModelBuffer      m_models;
+   RVRebuildScheduler m_scheduler;
+   std::mutex         m_rebuildLock;   // Held by the AH listener and by OnTimer() around m_builder, m_scheduler and the publishing
+   const RVRoadModel* m_pModel;        // Snapshot being painted (set by paintAll())
+
    TrafficSign*       ts;
-   /** Areas for Tunnels and Roundabouts */
-   CArray<RVAreas>    m_areas;
-   /** Areas for Traffic Signs */
-   CArray<RVAreas>    m_tsAreas;
+
+   /** Static layer, and frame layer (static layer + dynamic layer) blitted to the window */
+   RVLayer            m_staticLayer;
+   RVLayer            m_frameLayer;
+   UINT               m_nInvalidLayers;      // Layer mask set by invalidateLayers(), applied by the next paint
+   int                m_nStaticLengthCM;     // Scale of the static layer
+   int                m_nLayoutStartLanes;   // Car position of the display list
+   Sint32             m_nLayoutTravelCM;     // Distance driven along the path of the display list (see RVRoadModel)
+   Uint32             m_nLayoutTravelEpoch;
+   RVDirtyRegion      m_dirtyRegion;         // Parts of the frame layer to paint again for the new display list
+
+   /** Primitives of the Root Link Signs, Road and Signs, replayed by the GDI backend into the frame layer.
+       The next list is laid out for each new road model and compared with it. */
+   RVDisplayList      m_displayList;
+   RVDisplayList      m_nextDisplayList;
+   RVGdiBackend       m_gdiBackend;
+   RVArcCache         m_arcCache;            // Arcs of the lane change transitions, for the current lane width
+   RVSignAtlas        m_signAtlas;           // Traffic Signs rasterized once, blitted by the GDI backend
+
+   /** Frame times, shown in Debug mode */
+   struct PaintStats
+   {
+      Uint32   nFrames;
+      Uint32   nModelUpdates;    // Road models received
+      double   fRepaintedPixels; // Pixels of the frame layer painted again for them
+      Uint32   nScrolls;         // Road models shown by scrolling the road strip
+      double   fLastMs;
+      double   fAvgMs;           // Moving average over about the last 10 frames
+   };
+   PaintStats         m_paintStats;
+
+   /** Latencies of the extraction and paint stages, recorded in Debug mode */
+   RVStageStats       m_stageStats;
+   DWORD              m_nLastStageDumpMs;
+
+   /** Horizon of the AH callbacks, recorded for RVHorizonReplay if a record file is set */
+   RVHorizonRecorder  m_recorder;
+
+   /** Performance overlay, formatted at most every HUD_REFRESH_MS from the counters above */
+   struct Hud
+   {
+      DWORD    nLastMs;
+      Uint32   nLastRebuilds;       // Rebuilds at nLastMs, for the rate
+      CString  szLines[3];
+   };
+   Hud                m_hud;
 
    CFont              fontText;
    CFont              fontScale;
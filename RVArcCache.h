@@ -0,0 +1,95 @@
+/**
+ * @file    RVArcCache.h
+ * @brief   Cache of the arc templates of the lane change transitions of the Road View.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * An arc of the transitions is a quarter of a circle of the lane width, from its lowest point to the given angle,
+ * one point per pixel step. Its shape only depends on the radius and the angle: the template gives the rise of the
+ * arc for each step, and the four orientations (up or down, to the right or to the left) and the position are
+ * applied when the points are added. The templates are computed once per radius, the cache is cleared when the
+ * lane width changes (resize, DPI, preferences).
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <math.h>
+
+class RVArcCache
+{
+public: // Constants
+
+   /** Rise of the arc (pixels, towards its center) at each pixel step from its start point */
+   typedef std::vector<int> Arc;
+
+   static const int MAX_ARCS = 8;         // More radii than lane widths of a view, cleared if exceeded
+
+
+public: // Constructor/Destructor
+
+   RVArcCache()
+   {
+      m_nHits = 0;
+      m_nMisses = 0;
+   };
+
+
+public: // Access
+
+   void clear()
+   {
+      m_arcs.clear();
+   };
+
+   /** Returns the template of the arc of the given radius stopping at fAngle (radian), computed on first use.
+    *  The reference is valid until the next call. */
+   const Arc& get(int nRadius, double fAngle)
+   {
+      for (size_t i = 0; i < m_arcs.size(); i++)
+      {
+         if ((m_arcs[i].nRadius == nRadius) && (m_arcs[i].fAngle == fAngle))
+         {
+            m_nHits++;
+            return m_arcs[i].arc;
+         }
+      }
+      m_nMisses++;
+      if ((int) m_arcs.size() >= MAX_ARCS)
+      {
+         m_arcs.clear();
+      }
+      m_arcs.push_back(Entry());
+      Entry& entry = m_arcs.back();
+      entry.nRadius = nRadius;
+      entry.fAngle = fAngle;
+      for (int nDrawIdx = 0; nDrawIdx <= cos(fAngle) * nRadius; nDrawIdx++)  // cos(pi/4) = sqrt(2.0)/2.0)
+      {
+         entry.arc.push_back(-(int) sqrt((nRadius * nRadius) - ((float) nDrawIdx * (float) nDrawIdx)) + nRadius);
+      }
+      return entry.arc;
+   };
+
+
+public: // Getters
+
+   Uint32   getHits()      const { return m_nHits;   };
+   Uint32   getMisses()    const { return m_nMisses; };
+
+
+private: // Data Members
+
+   struct Entry
+   {
+      int      nRadius;
+      double   fAngle;
+      Arc      arc;
+   };
+
+   std::vector<Entry>   m_arcs;
+   Uint32               m_nHits;
+   Uint32               m_nMisses;
+};
+
+
@@ -15,106 +15,72 @@ public: // Constructor/Destructor
    
    RVAreas()
    {
-      m_sign               = TrafficSign::tsInvalid;
-      m_nStart             = 0;
-      m_nEnd               = 0;
-      m_nWidth             = 0;
-      m_nNumber            = 0;
-      m_nDistanceOrDuration = 0;
-      m_bDuration          = true;
-      m_bRealSign = false;
+      setFields(TrafficSign::tsInvalid, 0, 0, 0, 0, 0, true, false);
    };
 
 
    RVAreas(enum TrafficSign::Sign sign, int nStart, int nEnd, int nWidth, int nNumber = 0, int nDistanceOrDuration = 0, bool bDuration = true, bool bRealSign = false)
    {
-      m_sign               = sign;
-      m_nStart             = nStart;
-      m_nEnd               = nEnd;
-      m_nWidth             = nWidth;
-      m_nNumber            = nNumber;
-      m_nDistanceOrDuration = nDistanceOrDuration;
-      m_bDuration          = bDuration;
-      m_bRealSign          = bRealSign;
+      setFields(sign, nStart, nEnd, nWidth, nNumber, nDistanceOrDuration, bDuration, bRealSign);
    };
 
 
 
 public: // Getters
 
-   enum TrafficSign::Sign getSign()                   const { return m_sign;           };
-   Sint32                 getStart()                  const { return m_nStart;         };
-   Sint32                 getEnd()                    const { return m_nEnd;           };
-   unsigned int           getWidth()                  const { return m_nWidth;         };
-   unsigned int           getNumber()                 const { return m_nNumber;        };
-   int                    getDistanceOrDuration()     const { return m_nDistanceOrDuration; };
-   bool                   isDuration()                const { return m_bDuration;      };
-   bool                   isRealSign()                const { return m_bRealSign;      };
+   enum TrafficSign::Sign getSign()                   const { return (enum TrafficSign::Sign) unbias((Uint32) (m_nKey[1] >> 32)); };
+   Sint32                 getStart()                  const { return unbias((Uint32) (m_nKey[0] >> 1)); };
+   Sint32                 getEnd()                    const { return unbias((Uint32) m_nKey[1]);       };
+   unsigned int           getWidth()                  const { return (unsigned int) (m_nKey[2] >> 32); };
+   unsigned int           getNumber()                 const { return (unsigned int) m_nKey[2];         };
+   int                    getDistanceOrDuration()     const { return unbias((Uint32) (m_nKey[3] >> 1)); };
+   bool                   isDuration()                const { return (m_nKey[3] & 1) != 0;             };
+   bool                   isRealSign()                const { return (m_nKey[0] & 1) == 0;             };
 
+public: // Setters
+
+   void                   setWidth(unsigned int nWidth)     { m_nKey[2] = ((ULONGLONG) nWidth << 32) | (Uint32) m_nKey[2]; };
+
+   /** Same sign at the same position (e.g. posted left and right) */
+   static bool isSameSign(const RVAreas &left, const RVAreas &right) {
+      return ((left.m_nKey[0] >> 1) == (right.m_nKey[0] >> 1)) && ((left.m_nKey[1] >> 32) == (right.m_nKey[1] >> 32));
+   }
+
+   /** Same order as comparing start, real sign first, sign, end, width, number, distance or duration, duration */
    bool operator<(const RVAreas &other) const
    {
-      if (m_nStart < other.m_nStart) {
-         return true;
-      }
-      if (m_nStart > other.m_nStart) {
-         return false;
-      }
-      if (m_bRealSign > other.m_bRealSign) { // Reversed.
-         return true;
-      }
-      if (m_bRealSign < other.m_bRealSign) {
-         return false;
-      }
-      if (m_sign < other.m_sign) {
-         return true;
-      }
-      if (m_sign > other.m_sign) {
-         return false;
-      }
-      if (m_nEnd < other.m_nEnd) {
-         return true;
-      }
-      if (m_nEnd > other.m_nEnd) {
-         return false;
-      }
-      if (m_nWidth < other.m_nWidth) {
-         return true;
-      }
-      if (m_nWidth > other.m_nWidth) {
-         return false;
-      }
-      if (m_nNumber < other.m_nNumber) {
-         return true;
-      }
-      if (m_nNumber > other.m_nNumber) {
-         return false;
-      }
-      if (m_nDistanceOrDuration < other.m_nDistanceOrDuration) {
-         return true;
-      }
-      if (m_nDistanceOrDuration > other.m_nDistanceOrDuration) {
-         return false;
-      }
-      if (m_bDuration < other.m_bDuration) {
-         return true;
-      }
-      if (m_bDuration > other.m_bDuration) {
-         return false;
+      for (int i = 0;  i < KEY_WORDS;  i++)
+      {
+         if (m_nKey[i] != other.m_nKey[i]) {
+            return m_nKey[i] < other.m_nKey[i];
+         }
       }
       return false;
    }
 
 
+private: // Worker methods
+
+   /** Maps a signed value to an unsigned one with the same order, and back */
+   static ULONGLONG bias(int nValue)     { return (ULONGLONG) ((Uint32) nValue ^ 0x80000000U); };
+   static int       unbias(Uint32 nValue) { return (int) (nValue ^ 0x80000000U); };
+
+   /** The fields are only kept packed in the order of operator<, each at full width so that the order is exact */
+   void setFields(enum TrafficSign::Sign sign, int nStart, int nEnd, int nWidth, int nNumber, int nDistanceOrDuration, bool bDuration, bool bRealSign)
+   {
+      m_nKey[0] = (bias(nStart) << 1) | (bRealSign ? 0 : 1);        // Real signs first
+      m_nKey[1] = (bias((int) sign) << 32) | bias(nEnd);
+      m_nKey[2] = ((ULONGLONG) (Uint32) nWidth << 32) | (Uint32) nNumber;
+      m_nKey[3] = (bias(nDistanceOrDuration) << 1) | (bDuration ? 1 : 0);
+   };
+
+
 private: // Data Members
-   
-   enum TrafficSign::Sign  m_sign;
-   Sint32                  m_nStart;
-   Sint32                  m_nEnd;
-   unsigned int            m_nWidth;
-   unsigned int            m_nNumber;
-   int                     m_nDistanceOrDuration;
-   bool                    m_bDuration;
-   bool                    m_bRealSign;
+
+   static const int KEY_WORDS = 4;
+
+   /** Start and real sign, sign and end, width and number, distance or duration and duration */
+   ULONGLONG               m_nKey[KEY_WORDS];
 };
 
 
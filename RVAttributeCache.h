@@ -0,0 +1,129 @@
+/**
+ * @file    RVAttributeCache.h
+ * @brief   Cache of per-attribute classification results, kept from one Horizon update to the next.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * Between two position messages, the Horizon mostly contains the same attributes at a shifted distance.
+ * The classification of an attribute only depends on its content (and on the links around it), so the result
+ * computed for the previous update can be reused and only the new attributes have to be classified.
+ * Entries which were not used during an update are evicted at its end. Their nodes are reused for the new entries.
+ */
+
+
+#pragma once
+
+#include <map>
+#include "RVPoolAllocator.h"
+
+/** Identifies an attribute by its content. Identical attributes (e.g. a sign posted on both sides) share an entry. */
+struct RVAttributeKey
+{
+   Uint32   nLinkId;
+   int      nType;
+   Uint32   nInfo;
+   Sint32   nLengthCM;
+   bool     bIsStart;
+
+   bool operator<(const RVAttributeKey &other) const
+   {
+      if (nLinkId != other.nLinkId) {
+         return nLinkId < other.nLinkId;
+      }
+      if (nType != other.nType) {
+         return nType < other.nType;
+      }
+      if (nInfo != other.nInfo) {
+         return nInfo < other.nInfo;
+      }
+      if (nLengthCM != other.nLengthCM) {
+         return nLengthCM < other.nLengthCM;
+      }
+      return bIsStart < other.bIsStart;
+   }
+};
+
+
+template <class TKey, class TValue>
+class RVAttributeCache
+{
+public: // Constructor/Destructor
+
+   RVAttributeCache()
+   {
+      m_nGeneration = 0;
+   };
+
+
+public: // Update cycle
+
+   /** Drops all the entries (Horizon topology change) */
+   void clear()
+   {
+      m_entries.clear();
+   };
+
+   /** Starts a new update. Entries not used until endUpdate() will be evicted. */
+   void beginUpdate()
+   {
+      m_nGeneration++;
+   };
+
+   /** Evicts the entries which were not used since beginUpdate() */
+   void endUpdate()
+   {
+      typename EntryMap::iterator it = m_entries.begin();
+      while (it != m_entries.end())
+      {
+         if (it->second.nGeneration != m_nGeneration)
+         {
+            m_entries.erase(it++);
+         }
+         else
+         {
+            ++it;
+         }
+      }
+   };
+
+
+public: // Access
+
+   /** Returns the cached value for the key, or NULL if the key has not been classified yet */
+   TValue* find(const TKey& key)
+   {
+      typename EntryMap::iterator it = m_entries.find(key);
+      if (it == m_entries.end())
+      {
+         return NULL;
+      }
+      it->second.nGeneration = m_nGeneration;
+      return &it->second.value;
+   };
+
+   /** Adds an entry for the key and returns its value to be filled by the caller */
+   TValue& insert(const TKey& key)
+   {
+      Entry& entry = m_entries[key];
+      entry.nGeneration = m_nGeneration;
+      return entry.value;
+   };
+
+   int getSize() const { return (int) m_entries.size(); };
+
+
+private: // Data Members
+
+   struct Entry
+   {
+      TValue   value;
+      Uint32   nGeneration;
+   };
+
+   typedef std::map<TKey, Entry, std::less<TKey>, RVPoolAllocator<std::pair<const TKey, Entry> > > EntryMap;
+
+   EntryMap                m_entries;
+   Uint32                  m_nGeneration;
+};
+
+
@@ -0,0 +1,359 @@
+/**
+ * @file    RVDirtyRegion.h
+ * @brief   Set of rectangles of the Road View to be repainted after a change of the road model.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The rectangles are merged when they overlap or touch. Past MAX_RECTS rectangles, they are replaced by their
+ * bounding rectangle, so that the invalidation never costs more than a few calls.
+ *
+ * addChanges() compares two display lists of the Road View: a primitive of either list without an identical
+ * primitive in the other one adds the rectangle it paints (or painted). Everything outside these rectangles
+ * is painted the same by both lists. The horizontal spans left (rectangles, lines, dashed lines) are paired with
+ * a span of the other list differing only by its x extent: such a pair only adds its two ends, so that a road
+ * segment growing or shrinking by a few pixels does not repaint its whole length.
+ *
+ * When the content of a part of the view is scrolled, scroll() moves the pending rectangles inside it and the
+ * changes can be added inside or outside that part only. The hatch of the hatched fills is anchored to the canvas,
+ * not to the fill: addHatched() repaints the scrolled ones.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "RVDisplayList.h"
+
+class RVDirtyRegion
+{
+public: // Constants
+
+   static const int MAX_RECTS = 32;
+
+
+public: // Constructor/Destructor
+
+   RVDirtyRegion() {};
+
+
+public: // Region
+
+   void clear()                              { m_rects.clear(); };
+   bool isEmpty()                      const { return m_rects.empty(); };
+
+   /** Adds a rectangle (right and bottom excluded). Empty rectangles are ignored. */
+   void add(const RVRect& rect)
+   {
+      if ((rect.nLeft >= rect.nRight) || (rect.nTop >= rect.nBottom))
+      {
+         return;
+      }
+      RVRect merged = rect;
+      // Absorb the rectangles the new one touches, until none is left (a merge may touch further rectangles)
+      for (bool bMerged = true; bMerged; )
+      {
+         bMerged = false;
+         for (size_t i = 0; i < m_rects.size(); i++)
+         {
+            if (touches(m_rects[i], merged))
+            {
+               merged = getUnion(m_rects[i], merged);
+               m_rects.erase(m_rects.begin() + i);
+               bMerged = true;
+               break;
+            }
+         }
+      }
+      m_rects.push_back(merged);
+      if ((int) m_rects.size() > MAX_RECTS)
+      {
+         RVRect bounds = getBounds();
+         m_rects.assign(1, bounds);
+      }
+   };
+
+   /** Adds the bounds of the primitives which differ between the two lists */
+   void addChanges(const RVDisplayList& prev, const RVDisplayList& next)
+   {
+      diff(prev, next, NULL, true);
+   };
+
+   /** Same, only adding the changes inside (or outside) the rectangle */
+   void addChanges(const RVDisplayList& prev, const RVDisplayList& next, const RVRect& rectPart, bool bInside)
+   {
+      diff(prev, next, &rectPart, bInside);
+   };
+
+   /** Adds the bounds of the hatched fills of the list inside the rectangle: once scrolled, their hatch no longer
+       lines up with the one the list paints */
+   void addHatched(const RVDisplayList& list, const RVRect& rectPart)
+   {
+      for (size_t i = 0; i < list.getSize(); i++)
+      {
+         if (list.getStyle(list.getCmd(i).nStyle).nPattern == RVStyle::PATTERN_HATCH)
+         {
+            addPart(list.getBounds(i), &rectPart, true);
+         }
+      }
+   };
+
+   /** The content of rectPart was moved by dx pixels: the rectangles inside it are moved too (clipped to it) */
+   void scroll(const RVRect& rectPart, int dx)
+   {
+      m_scrolled.swap(m_rects);
+      m_rects.clear();
+      for (size_t i = 0; i < m_scrolled.size(); i++)
+      {
+         RVRect rect = m_scrolled[i];
+         addPart(rect, &rectPart, false);
+         rect.nLeft  += dx;
+         rect.nRight += dx;
+         addPart(rect, &rectPart, true);
+      }
+   };
+
+   /** Clips all the rectangles to the canvas */
+   void clip(int nWidth, int nHeight)
+   {
+      for (size_t i = m_rects.size(); i > 0; i--)
+      {
+         RVRect& rect = m_rects[i - 1];
+         rect.nLeft   = (rect.nLeft   < 0)       ? 0       : rect.nLeft;
+         rect.nTop    = (rect.nTop    < 0)       ? 0       : rect.nTop;
+         rect.nRight  = (rect.nRight  > nWidth)  ? nWidth  : rect.nRight;
+         rect.nBottom = (rect.nBottom > nHeight) ? nHeight : rect.nBottom;
+         if ((rect.nLeft >= rect.nRight) || (rect.nTop >= rect.nBottom))
+         {
+            m_rects.erase(m_rects.begin() + (i - 1));
+         }
+      }
+   };
+
+
+public: // Getters
+
+   size_t         getSize()            const { return m_rects.size(); };
+   const RVRect&  getRect(size_t i)    const { return m_rects[i]; };
+
+   RVRect getBounds() const
+   {
+      RVRect bounds = { 0, 0, 0, 0 };
+      for (size_t i = 0; i < m_rects.size(); i++)
+      {
+         bounds = (i == 0) ? m_rects[i] : getUnion(bounds, m_rects[i]);
+      }
+      return bounds;
+   };
+
+   /** Number of pixels covered (the rectangles do not overlap) */
+   Uint32 getArea() const
+   {
+      Uint32 nArea = 0;
+      for (size_t i = 0; i < m_rects.size(); i++)
+      {
+         nArea += (Uint32) ((m_rects[i].nRight - m_rects[i].nLeft) * (m_rects[i].nBottom - m_rects[i].nTop));
+      }
+      return nArea;
+   };
+
+
+private: // Worker methods
+
+   typedef std::pair<Uint32, Uint32> Key;      // Hash, index of the primitive
+
+   struct SpanKey
+   {
+      Uint32   nHash;                  // Hash without the x extent
+      int      nLeft;
+      Uint32   nIndex;
+
+      bool operator<(const SpanKey& other) const
+      {
+         if (nHash != other.nHash)     return nHash < other.nHash;
+         if (nLeft != other.nLeft)     return nLeft < other.nLeft;
+         return nIndex < other.nIndex;
+      };
+   };
+
+   void diff(const RVDisplayList& prev, const RVDisplayList& next, const RVRect* pPart, bool bInside)
+   {
+      getKeys(prev, m_prevKeys);
+      getKeys(next, m_nextKeys);
+      m_prevSpans.clear();
+      m_nextSpans.clear();
+      size_t i = 0;
+      size_t j = 0;
+      while ((i < m_prevKeys.size()) && (j < m_nextKeys.size()))
+      {
+         if (m_prevKeys[i].first < m_nextKeys[j].first)
+         {
+            addChanged(prev, m_prevKeys[i++].second, m_prevSpans, pPart, bInside);
+         }
+         else if (m_nextKeys[j].first < m_prevKeys[i].first)
+         {
+            addChanged(next, m_nextKeys[j++].second, m_nextSpans, pPart, bInside);
+         }
+         else
+         {
+            // Same hash: unchanged if really identical, else both are repainted
+            if (!prev.isSame(m_prevKeys[i].second, next, m_nextKeys[j].second))
+            {
+               addChanged(prev, m_prevKeys[i].second, m_prevSpans, pPart, bInside);
+               addChanged(next, m_nextKeys[j].second, m_nextSpans, pPart, bInside);
+            }
+            i++;
+            j++;
+         }
+      }
+      for (; i < m_prevKeys.size(); i++)
+      {
+         addChanged(prev, m_prevKeys[i].second, m_prevSpans, pPart, bInside);
+      }
+      for (; j < m_nextKeys.size(); j++)
+      {
+         addChanged(next, m_nextKeys[j].second, m_nextSpans, pPart, bInside);
+      }
+
+      // Changed spans: paired in x order within the same hash, a pair only repaints its ends
+      std::sort(m_prevSpans.begin(), m_prevSpans.end());
+      std::sort(m_nextSpans.begin(), m_nextSpans.end());
+      i = 0;
+      j = 0;
+      while ((i < m_prevSpans.size()) && (j < m_nextSpans.size()))
+      {
+         const SpanKey& a = m_prevSpans[i];
+         const SpanKey& b = m_nextSpans[j];
+         if (a.nHash < b.nHash)
+         {
+            addPart(prev.getBounds(a.nIndex), pPart, bInside);
+            i++;
+         }
+         else if (b.nHash < a.nHash)
+         {
+            addPart(next.getBounds(b.nIndex), pPart, bInside);
+            j++;
+         }
+         else
+         {
+            if (prev.isSameSpan(a.nIndex, next, b.nIndex))
+            {
+               addSpanEnds(prev, a.nIndex, next.getCmd(b.nIndex).rect, pPart, bInside);
+            }
+            else
+            {
+               addPart(prev.getBounds(a.nIndex), pPart, bInside);
+               addPart(next.getBounds(b.nIndex), pPart, bInside);
+            }
+            i++;
+            j++;
+         }
+      }
+      for (; i < m_prevSpans.size(); i++)
+      {
+         addPart(prev.getBounds(m_prevSpans[i].nIndex), pPart, bInside);
+      }
+      for (; j < m_nextSpans.size(); j++)
+      {
+         addPart(next.getBounds(m_nextSpans[j].nIndex), pPart, bInside);
+      }
+   };
+
+   /** Keeps a changed span for the pairing, adds the bounds of any other changed primitive */
+   void addChanged(const RVDisplayList& list, Uint32 nIndex, std::vector<SpanKey>& spans, const RVRect* pPart, bool bInside)
+   {
+      if (list.isSpan(nIndex))
+      {
+         SpanKey key = { list.getSpanHash(nIndex), list.getCmd(nIndex).rect.nLeft, nIndex };
+         spans.push_back(key);
+      }
+      else
+      {
+         addPart(list.getBounds(nIndex), pPart, bInside);
+      }
+   };
+
+   /** Adds the columns where the span i of the list and the same span over rectNext differ */
+   void addSpanEnds(const RVDisplayList& list, Uint32 nIndex, const RVRect& rectNext, const RVRect* pPart, bool bInside)
+   {
+      const RVRect& rect = list.getCmd(nIndex).rect;
+      if (rect.nLeft != rectNext.nLeft)
+      {
+         int xMin = (rect.nLeft < rectNext.nLeft) ? rect.nLeft : rectNext.nLeft;
+         int xMax = (rect.nLeft > rectNext.nLeft) ? rect.nLeft : rectNext.nLeft;
+         addPart(getUnion(list.getSpanBounds(nIndex, xMin), list.getSpanBounds(nIndex, xMax - 1)), pPart, bInside);
+      }
+      if (rect.nRight != rectNext.nRight)
+      {
+         int xMin = (rect.nRight < rectNext.nRight) ? rect.nRight : rectNext.nRight;
+         int xMax = (rect.nRight > rectNext.nRight) ? rect.nRight : rectNext.nRight;
+         addPart(getUnion(list.getSpanBounds(nIndex, xMin - 1), list.getSpanBounds(nIndex, xMax - 1)), pPart, bInside);
+      }
+   };
+
+   /** Adds the rectangle, or only its part inside (or outside) pPart if given */
+   void addPart(const RVRect& rect, const RVRect* pPart, bool bInside)
+   {
+      if (pPart == NULL)
+      {
+         add(rect);
+         return;
+      }
+      const RVRect& part = *pPart;
+      int nTop    = (rect.nTop    > part.nTop)    ? rect.nTop    : part.nTop;
+      int nBottom = (rect.nBottom < part.nBottom) ? rect.nBottom : part.nBottom;
+      if (bInside)
+      {
+         RVRect inside = { (rect.nLeft  > part.nLeft)  ? rect.nLeft  : part.nLeft,  nTop,
+                           (rect.nRight < part.nRight) ? rect.nRight : part.nRight, nBottom };
+         add(inside);
+         return;
+      }
+      // Outside: above and below the part, then left and right of it between them
+      RVRect above = { rect.nLeft, rect.nTop, rect.nRight, (rect.nBottom < part.nTop) ? rect.nBottom : part.nTop };
+      RVRect below = { rect.nLeft, (rect.nTop > part.nBottom) ? rect.nTop : part.nBottom, rect.nRight, rect.nBottom };
+      RVRect left  = { rect.nLeft, nTop, (rect.nRight < part.nLeft) ? rect.nRight : part.nLeft, nBottom };
+      RVRect right = { (rect.nLeft > part.nRight) ? rect.nLeft : part.nRight, nTop, rect.nRight, nBottom };
+      add(above);
+      add(below);
+      add(left);
+      add(right);
+   };
+
+   static void getKeys(const RVDisplayList& list, std::vector<Key>& keys)
+   {
+      keys.resize(list.getSize());
+      for (size_t i = 0; i < keys.size(); i++)
+      {
+         keys[i] = Key(list.getHash(i), (Uint32) i);
+      }
+      std::sort(keys.begin(), keys.end());
+   };
+
+   static bool touches(const RVRect& a, const RVRect& b)
+   {
+      return (a.nLeft <= b.nRight) && (b.nLeft <= a.nRight) && (a.nTop <= b.nBottom) && (b.nTop <= a.nBottom);
+   };
+
+   static RVRect getUnion(const RVRect& a, const RVRect& b)
+   {
+      RVRect u;
+      u.nLeft   = (a.nLeft   < b.nLeft)   ? a.nLeft   : b.nLeft;
+      u.nTop    = (a.nTop    < b.nTop)    ? a.nTop    : b.nTop;
+      u.nRight  = (a.nRight  > b.nRight)  ? a.nRight  : b.nRight;
+      u.nBottom = (a.nBottom > b.nBottom) ? a.nBottom : b.nBottom;
+      return u;
+   };
+
+
+private: // Data Members
+
+   std::vector<RVRect>  m_rects;
+   std::vector<Key>     m_prevKeys;       // Kept between the diffs
+   std::vector<Key>     m_nextKeys;
+   std::vector<SpanKey> m_prevSpans;
+   std::vector<SpanKey> m_nextSpans;
+   std::vector<RVRect>  m_scrolled;
+};
+
+
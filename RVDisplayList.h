@@ -0,0 +1,556 @@
+/**
+ * @file    RVDisplayList.h
+ * @brief   Display list of the Road View: typed drawing primitives, replayed by a rendering backend.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The paint methods of the Road View do not draw into a device context, they append primitives to the list:
+ * filled rectangles, lines and polylines, filled polygons, batches of dashed lines, Traffic Signs and text. Points and text are
+ * kept in pools shared by all the primitives, so that a list which is cleared and filled again for each frame does
+ * not allocate once it has reached its usual size. Colors and line patterns are given by a style table set once by
+ * the view. The list only uses standard types: it can be built, counted and checked without a window, and replayed
+ * by any RVRenderBackend (GDI for the window, recording for checks).
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <string.h>
+
+struct RVPoint
+{
+   Sint32   x;
+   Sint32   y;
+};
+
+struct RVRect
+{
+   Sint32   nLeft;
+   Sint32   nTop;
+   Sint32   nRight;
+   Sint32   nBottom;
+};
+
+/** Color (0x00BBGGRR, as a COLORREF), pattern and default line width of the styles of the Road View */
+struct RVStyle
+{
+   enum Pattern
+   {
+      PATTERN_SOLID,
+      PATTERN_DASH,
+      PATTERN_DOT,
+      PATTERN_HATCH        // Diagonal hatch (fills only)
+   };
+
+   Uint32   nColor;
+   Uint8    nPattern;
+   Uint8    nWidth;
+   Uint8    nId;                 // RVDisplayList::StyleId, to map the style to the objects of a backend
+};
+
+/** Traffic Sign drawn by a backend: the parameters of TrafficSign::draw() */
+struct RVSignBlit
+{
+   Sint32   nSign;               // TrafficSign::Sign
+   Uint32   nParam;
+   Sint32   nDistance;
+   bool     bLength;
+};
+
+
+/** Backend replaying a display list. The points and the text are only valid during the call. */
+class RVRenderBackend
+{
+public: // Constructor/Destructor
+
+   virtual ~RVRenderBackend() {};
+
+
+public: // Primitives
+
+   virtual void fillRect  (const RVRect& rect, const RVStyle& style) = 0;
+   /** Open line through the points, the last point is not drawn (as GDI) */
+   virtual void polyline  (const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style, int nWidth) = 0;
+   /** Filled polygon, outlined with the same style */
+   virtual void polygon   (const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style) = 0;
+   /** Horizontal dashed lines between xStart and xEnd, one per anchor at the y of the anchor: dashes of nDash
+    *  pixels separated by nGap pixels, starting at the x of the anchor (and every period before or after it), clipped
+    *  to [xStart, xEnd[. Lines of neighbour batches with the same anchor continue the same dash pattern. */
+   virtual void dashedLines(int xStart, int xEnd, const RVPoint* pAnchors, Uint32 nLines, int nDash, int nGap, const RVStyle& style) = 0;
+   virtual void sign      (const RVRect& rect, const RVSignBlit& sign) = 0;
+   /** Text with a transparent background, top left at (x, y) */
+   virtual void text      (int x, int y, const char* szText, Uint32 nLength, const RVStyle& style) = 0;
+
+
+protected: // Worker methods
+
+   /** Start of the first dash of the pattern anchored at xAnchor which ends after xStart */
+   static int getFirstDash(int xStart, int xAnchor, int nDash, int nGap)
+   {
+      int nPeriod = nDash + nGap;
+      int nOffset = (xStart - xAnchor) % nPeriod;
+      int x = xStart - ((nOffset < 0) ? nOffset + nPeriod : nOffset);
+      return ((x + nDash) <= xStart) ? x + nPeriod : x;
+   };
+};
+
+
+class RVDisplayList
+{
+public: // Constants
+
+   enum CmdType
+   {
+      CMD_FILL_RECT,
+      CMD_LINE,
+      CMD_POLYLINE,
+      CMD_POLYGON,
+      CMD_DASHED_LINES,
+      CMD_SIGN,
+      CMD_TEXT,
+      CMD_TYPES
+   };
+
+   enum StyleId
+   {
+      STYLE_ROAD,
+      STYLE_LINES,
+      STYLE_LINES_DASH,
+      STYLE_ARROW,
+      STYLE_COMPLEX,
+      STYLE_AREA_ROUNDABOUT,
+      STYLE_AREA_TUNNEL,
+      STYLE_AREA_SIGNS,
+      STYLE_POLE,
+      STYLE_POLE_DOTTED,
+      STYLE_DEBUG,
+      STYLE_COUNT
+   };
+
+   /** Bound of the extent of a char and of a line of text, for the fonts of the view */
+   static const int TEXT_MAX_CHAR_WIDTH   = 16;
+   static const int TEXT_MAX_HEIGHT       = 20;
+
+   /** One primitive. The meaning of the fields depends on the type:
+    *  FILL_RECT: rect.           LINE: from (nLeft, nTop) to (nRight, nBottom).
+    *  POLYLINE, POLYGON: nCount points from nFirst in the point pool.
+    *  DASHED_LINES: from nLeft to nRight, nTop = dash length, nBottom = gap length, nCount anchors from nFirst in the
+    *  point pool (one line per anchor).
+    *  SIGN: rect, nFirst = index of the sign.  TEXT: at (nLeft, nTop), nCount chars from nFirst in the text pool. */
+   struct Cmd
+   {
+      Uint8    nType;
+      Uint8    nStyle;
+      Uint16   nWidth;           // Line width, 0 for the width of the style
+      RVRect   rect;
+      Uint32   nFirst;
+      Uint32   nCount;
+   };
+
+
+public: // Constructor/Destructor
+
+   RVDisplayList()
+   {
+      memset(m_styles, 0, sizeof(m_styles));
+   };
+
+
+public: // Styles
+
+   void setStyle(StyleId nStyle, Uint32 nColor, RVStyle::Pattern nPattern, int nWidth)
+   {
+      m_styles[nStyle].nColor   = nColor;
+      m_styles[nStyle].nPattern = (Uint8) nPattern;
+      m_styles[nStyle].nWidth   = (Uint8) nWidth;
+      m_styles[nStyle].nId      = (Uint8) nStyle;
+   };
+
+   /** Copies the styles of another list. swap() keeps the styles of each list: lists swapped together need the same. */
+   void setStyles(const RVDisplayList& other)
+   {
+      memcpy(m_styles, other.m_styles, sizeof(m_styles));
+   };
+
+   const RVStyle& getStyle(int nStyle) const { return m_styles[nStyle]; };
+
+
+public: // Building
+
+   /** Empties the list, keeps the capacity of the pools */
+   void clear()
+   {
+      m_cmds.clear();
+      m_points.clear();
+      m_signs.clear();
+      m_text.clear();
+   };
+
+   /** Exchanges the content with another list (the styles are kept) */
+   void swap(RVDisplayList& other)
+   {
+      m_cmds.swap(other.m_cmds);
+      m_points.swap(other.m_points);
+      m_signs.swap(other.m_signs);
+      m_text.swap(other.m_text);
+   };
+
+   void fillRect(StyleId nStyle, int nLeft, int nTop, int nWidth, int nHeight)
+   {
+      add(CMD_FILL_RECT, nStyle, 0, nLeft, nTop, nLeft + nWidth, nTop + nHeight, 0, 0);
+   };
+
+   void line(StyleId nStyle, int x1, int y1, int x2, int y2, int nWidth = 0)
+   {
+      add(CMD_LINE, nStyle, nWidth, x1, y1, x2, y2, 0, 0);
+   };
+
+   /** Starts a polyline or polygon: the points are then given with addPoint() */
+   void beginPolyline(StyleId nStyle, int nWidth = 0) { add(CMD_POLYLINE, nStyle, nWidth, 0, 0, 0, 0, (Uint32) m_points.size(), 0); };
+   void beginPolygon(StyleId nStyle)                  { add(CMD_POLYGON,  nStyle, 0,      0, 0, 0, 0, (Uint32) m_points.size(), 0); };
+
+   void addPoint(int x, int y)
+   {
+      RVPoint pt = { x, y };
+      m_points.push_back(pt);
+      m_cmds.back().nCount++;
+   };
+
+   /** Starts a batch of dashed lines from xStart to xEnd: the anchor of each line is then given with addPoint() */
+   void beginDashedLines(StyleId nStyle, int xStart, int xEnd, int nDash, int nGap)
+   {
+      add(CMD_DASHED_LINES, nStyle, 0, xStart, nDash, xEnd, nGap, (Uint32) m_points.size(), 0);
+   };
+
+   void sign(int nLeft, int nTop, int nRight, int nBottom, int nSign, Uint32 nParam, int nDistance, bool bLength)
+   {
+      RVSignBlit blit = { nSign, nParam, nDistance, bLength };
+      add(CMD_SIGN, 0, 0, nLeft, nTop, nRight, nBottom, (Uint32) m_signs.size(), 0);
+      m_signs.push_back(blit);
+   };
+
+   void text(StyleId nStyle, int x, int y, const char* szText)
+   {
+      Uint32 nLength = (Uint32) strlen(szText);
+      add(CMD_TEXT, nStyle, 0, x, y, x, y, (Uint32) m_text.size(), nLength);
+      m_text.insert(m_text.end(), szText, szText + nLength);
+   };
+
+   /** Moves all the primitives by dx pixels, as if they had been laid out dx pixels further. The anchors of the
+    *  dashed lines are reduced to their first period (see getDashPhase()). */
+   void translate(int dx)
+   {
+      for (size_t i = 0; i < m_cmds.size(); i++)
+      {
+         Cmd& cmd = m_cmds[i];
+         switch (cmd.nType)
+         {
+            case CMD_POLYLINE:
+            case CMD_POLYGON:
+               for (Uint32 n = 0; n < cmd.nCount; n++)
+               {
+                  m_points[cmd.nFirst + n].x += dx;
+               }
+               break;
+            case CMD_DASHED_LINES:
+               cmd.rect.nLeft  += dx;
+               cmd.rect.nRight += dx;
+               for (Uint32 n = 0; n < cmd.nCount; n++)
+               {
+                  RVPoint& pt = m_points[cmd.nFirst + n];
+                  pt.x = getDashPhase(pt.x + dx, cmd.rect.nTop, cmd.rect.nBottom);
+               }
+               break;
+            default:
+               cmd.rect.nLeft  += dx;
+               cmd.rect.nRight += dx;
+               break;
+         }
+      }
+   };
+
+   /** Anchor of a dash pattern reduced to [0, nDash + nGap[: the same pattern always gets the same anchor */
+   static int getDashPhase(int xAnchor, int nDash, int nGap)
+   {
+      int nPeriod = nDash + nGap;
+      if (nPeriod <= 0)
+      {
+         return xAnchor;
+      }
+      int nPhase = xAnchor % nPeriod;
+      return (nPhase < 0) ? nPhase + nPeriod : nPhase;
+   };
+
+
+public: // Replay
+
+   void replay(RVRenderBackend& backend) const
+   {
+      for (size_t i = 0; i < m_cmds.size(); i++)
+      {
+         const Cmd& cmd = m_cmds[i];
+         const RVStyle& style = m_styles[cmd.nStyle];
+         int nWidth = (cmd.nWidth > 0) ? cmd.nWidth : style.nWidth;
+         switch (cmd.nType)
+         {
+            case CMD_FILL_RECT:
+               backend.fillRect(cmd.rect, style);
+               break;
+            case CMD_LINE:
+            {
+               RVPoint points[2] = { { cmd.rect.nLeft, cmd.rect.nTop }, { cmd.rect.nRight, cmd.rect.nBottom } };
+               backend.polyline(points, 2, style, nWidth);
+               break;
+            }
+            case CMD_POLYLINE:
+               if (cmd.nCount > 1)
+               {
+                  backend.polyline(&m_points[cmd.nFirst], cmd.nCount, style, nWidth);
+               }
+               break;
+            case CMD_POLYGON:
+               if (cmd.nCount > 2)
+               {
+                  backend.polygon(&m_points[cmd.nFirst], cmd.nCount, style);
+               }
+               break;
+            case CMD_DASHED_LINES:
+               if ((cmd.nCount > 0) && (cmd.rect.nTop > 0))
+               {
+                  backend.dashedLines(cmd.rect.nLeft, cmd.rect.nRight, &m_points[cmd.nFirst], cmd.nCount, cmd.rect.nTop, cmd.rect.nBottom, style);
+               }
+               break;
+            case CMD_SIGN:
+               backend.sign(cmd.rect, m_signs[cmd.nFirst]);
+               break;
+            case CMD_TEXT:
+               backend.text(cmd.rect.nLeft, cmd.rect.nTop, (cmd.nCount > 0) ? &m_text[cmd.nFirst] : "", cmd.nCount, style);
+               break;
+         }
+      }
+   };
+
+
+public: // Getters
+
+   size_t      getSize()                     const { return m_cmds.size(); };
+   const Cmd&  getCmd(size_t i)              const { return m_cmds[i]; };
+   size_t      getPointCount()               const { return m_points.size(); };
+
+   /** Number of primitives of the given type, for the cost accounting */
+   Uint32 getCount(CmdType nType) const
+   {
+      Uint32 nCount = 0;
+      for (size_t i = 0; i < m_cmds.size(); i++)
+      {
+         nCount += (m_cmds[i].nType == nType) ? 1 : 0;
+      }
+      return nCount;
+   };
+
+
+public: // Diff
+
+   /** Rectangle (right and bottom excluded) the primitive may paint. The text extent is a bound for the view font. */
+   RVRect getBounds(size_t i) const
+   {
+      const Cmd& cmd = m_cmds[i];
+      RVRect bounds = cmd.rect;
+      int nWidth = (cmd.nWidth > 0) ? cmd.nWidth : m_styles[cmd.nStyle].nWidth;
+      switch (cmd.nType)
+      {
+         case CMD_FILL_RECT:
+         case CMD_SIGN:
+            return bounds;
+         case CMD_TEXT:
+            bounds.nRight  = cmd.rect.nLeft + (int) cmd.nCount * TEXT_MAX_CHAR_WIDTH;
+            bounds.nBottom = cmd.rect.nTop + TEXT_MAX_HEIGHT;
+            return bounds;
+         case CMD_DASHED_LINES:
+            // From xStart to xEnd, over the y of the anchors
+            for (Uint32 n = 0; n < cmd.nCount; n++)
+            {
+               const RVPoint& pt = m_points[cmd.nFirst + n];
+               bounds.nTop    = ((n == 0) || (pt.y < bounds.nTop))    ? pt.y : bounds.nTop;
+               bounds.nBottom = ((n == 0) || (pt.y > bounds.nBottom)) ? pt.y : bounds.nBottom;
+            }
+            break;
+         case CMD_POLYLINE:
+         case CMD_POLYGON:
+            for (Uint32 n = 0; n < cmd.nCount; n++)
+            {
+               const RVPoint& pt = m_points[cmd.nFirst + n];
+               bounds.nLeft   = ((n == 0) || (pt.x < bounds.nLeft))   ? pt.x : bounds.nLeft;
+               bounds.nTop    = ((n == 0) || (pt.y < bounds.nTop))    ? pt.y : bounds.nTop;
+               bounds.nRight  = ((n == 0) || (pt.x > bounds.nRight))  ? pt.x : bounds.nRight;
+               bounds.nBottom = ((n == 0) || (pt.y > bounds.nBottom)) ? pt.y : bounds.nBottom;
+            }
+            break;
+         default:    // Lines: endpoints in the rect, possibly reversed
+            if (bounds.nLeft > bounds.nRight)   { bounds.nLeft = cmd.rect.nRight;   bounds.nRight = cmd.rect.nLeft;  }
+            if (bounds.nTop > bounds.nBottom)   { bounds.nTop = cmd.rect.nBottom;   bounds.nBottom = cmd.rect.nTop;  }
+            break;
+      }
+      // Lines and outlines extend by the pen (and its caps) around the points
+      int nMargin = nWidth / 2 + 1;
+      bounds.nLeft   -= nMargin;
+      bounds.nTop    -= nMargin;
+      bounds.nRight  += nMargin + 1;
+      bounds.nBottom += nMargin + 1;
+      return bounds;
+   };
+
+   /** True for the horizontal spans: filled rectangles, horizontal lines and dashed lines. Two spans which only differ
+    *  by their x extent (see isSameSpan()) paint the same where they overlap. */
+   bool isSpan(size_t i) const
+   {
+      const Cmd& cmd = m_cmds[i];
+      return (cmd.nType == CMD_FILL_RECT) || (cmd.nType == CMD_DASHED_LINES) ||
+             ((cmd.nType == CMD_LINE) && (cmd.rect.nTop == cmd.rect.nBottom) && (cmd.rect.nLeft <= cmd.rect.nRight));
+   };
+
+   /** Bounds of what the span paints around the column x: the column, with the pen and its caps for the lines */
+   RVRect getSpanBounds(size_t i, int x) const
+   {
+      const Cmd& cmd = m_cmds[i];
+      int nWidth = (cmd.nWidth > 0) ? cmd.nWidth : m_styles[cmd.nStyle].nWidth;
+      int nMargin = (cmd.nType == CMD_FILL_RECT) ? 0 : nWidth / 2 + 1;
+      RVRect bounds = getBounds(i);
+      bounds.nLeft  = x - nMargin;
+      bounds.nRight = x + nMargin + 1;
+      return bounds;
+   };
+
+   /** Hash of everything the primitive paints (type, style, geometry, sign, text) */
+   Uint32 getHash(size_t i) const
+   {
+      return getHash(i, true);
+   };
+
+   /** Hash of everything the span paints but its x extent */
+   Uint32 getSpanHash(size_t i) const
+   {
+      return getHash(i, false);
+   };
+
+   /** Returns true if the primitive i paints exactly the same as the primitive j of the other list */
+   bool isSame(size_t i, const RVDisplayList& other, size_t j) const
+   {
+      return isSame(i, other, j, true);
+   };
+
+   /** Returns true if the span i only differs from the span j of the other list by its x extent */
+   bool isSameSpan(size_t i, const RVDisplayList& other, size_t j) const
+   {
+      return isSame(i, other, j, false);
+   };
+
+
+private: // Worker methods
+
+   Uint32 getHash(size_t i, bool bExtent) const
+   {
+      const Cmd& cmd = m_cmds[i];
+      Uint32 nHash = 2166136261u;
+      nHash = hash(nHash, cmd.nType | (cmd.nStyle << 8) | (cmd.nWidth << 16));
+      if (bExtent)
+      {
+         nHash = hash(nHash, (Uint32) cmd.rect.nLeft);
+         nHash = hash(nHash, (Uint32) cmd.rect.nRight);
+      }
+      nHash = hash(nHash, (Uint32) cmd.rect.nTop);
+      nHash = hash(nHash, (Uint32) cmd.rect.nBottom);
+      nHash = hash(nHash, cmd.nCount);
+      switch (cmd.nType)
+      {
+         case CMD_POLYLINE:
+         case CMD_POLYGON:
+         case CMD_DASHED_LINES:
+            for (Uint32 n = 0; n < cmd.nCount; n++)
+            {
+               nHash = hash(nHash, (Uint32) m_points[cmd.nFirst + n].x);
+               nHash = hash(nHash, (Uint32) m_points[cmd.nFirst + n].y);
+            }
+            break;
+         case CMD_SIGN:
+            nHash = hash(nHash, (Uint32) m_signs[cmd.nFirst].nSign);
+            nHash = hash(nHash, m_signs[cmd.nFirst].nParam);
+            nHash = hash(nHash, (Uint32) m_signs[cmd.nFirst].nDistance);
+            nHash = hash(nHash, m_signs[cmd.nFirst].bLength ? 1 : 0);
+            break;
+         case CMD_TEXT:
+            for (Uint32 n = 0; n < cmd.nCount; n++)
+            {
+               nHash = hash(nHash, (Uint32) (unsigned char) m_text[cmd.nFirst + n]);
+            }
+            break;
+      }
+      return nHash;
+   };
+
+   bool isSame(size_t i, const RVDisplayList& other, size_t j, bool bExtent) const
+   {
+      const Cmd& a = m_cmds[i];
+      const Cmd& b = other.m_cmds[j];
+      if ((a.nType != b.nType) || (a.nStyle != b.nStyle) || (a.nWidth != b.nWidth) || (a.nCount != b.nCount) ||
+          (a.rect.nTop != b.rect.nTop) || (a.rect.nBottom != b.rect.nBottom) ||
+          (bExtent && ((a.rect.nLeft != b.rect.nLeft) || (a.rect.nRight != b.rect.nRight))))
+      {
+         return false;
+      }
+      switch (a.nType)
+      {
+         case CMD_POLYLINE:
+         case CMD_POLYGON:
+         case CMD_DASHED_LINES:
+            return (a.nCount == 0) || (memcmp(&m_points[a.nFirst], &other.m_points[b.nFirst], a.nCount * sizeof(RVPoint)) == 0);
+         case CMD_SIGN:
+         {
+            const RVSignBlit& sa = m_signs[a.nFirst];
+            const RVSignBlit& sb = other.m_signs[b.nFirst];
+            return (sa.nSign == sb.nSign) && (sa.nParam == sb.nParam) && (sa.nDistance == sb.nDistance) && (sa.bLength == sb.bLength);
+         }
+         case CMD_TEXT:
+            return (a.nCount == 0) || (memcmp(&m_text[a.nFirst], &other.m_text[b.nFirst], a.nCount) == 0);
+         default:
+            return true;
+      }
+   };
+
+   /** FNV-1a over the 4 bytes of the value */
+   static Uint32 hash(Uint32 nHash, Uint32 nValue)
+   {
+      for (int i = 0; i < 4; i++)
+      {
+         nHash = (nHash ^ ((nValue >> (i * 8)) & 0xFF)) * 16777619u;
+      }
+      return nHash;
+   };
+
+   void add(CmdType nType, int nStyle, int nWidth, int nLeft, int nTop, int nRight, int nBottom, Uint32 nFirst, Uint32 nCount)
+   {
+      Cmd cmd;
+      cmd.nType         = (Uint8) nType;
+      cmd.nStyle        = (Uint8) nStyle;
+      cmd.nWidth        = (Uint16) nWidth;
+      cmd.rect.nLeft    = nLeft;
+      cmd.rect.nTop     = nTop;
+      cmd.rect.nRight   = nRight;
+      cmd.rect.nBottom  = nBottom;
+      cmd.nFirst        = nFirst;
+      cmd.nCount        = nCount;
+      m_cmds.push_back(cmd);
+   };
+
+
+private: // Data Members
+
+   std::vector<Cmd>        m_cmds;
+   std::vector<RVPoint>    m_points;
+   std::vector<RVSignBlit> m_signs;
+   std::vector<char>       m_text;
+   RVStyle                 m_styles[STYLE_COUNT];
+};
+
+
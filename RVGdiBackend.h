@@ -0,0 +1,338 @@
+/**
+ * @file    RVGdiBackend.h
+ * @brief   Replays a Road View display list into a device context.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The styles are drawn with the pens and brushes of the view, given once with setPen() and setBrush(). A style
+ * without pen (or a line with another width than its style, as the sign poles) gets a pen of the pool, a polygon
+ * style without brush a brush of the pool, a fill without brush its plain color. The pooled objects are created on
+ * first use, keyed by pen style, width and color, and kept until releaseObjects() (resize, preferences). The
+ * Traffic Signs are drawn by the TrafficSign of the view, through its sprite atlas if set.
+ *
+ * During a replay the selected pen, brush, font, text color and background mode are tracked: an object is only
+ * selected when it differs from the current one, so that a run of primitives of the same style selects it once.
+ * The DC is saved before and restored after the replay.
+ *
+ * A batch of dashed lines is drawn with a single PolyPolyline, one polyline of two points per dash. The GDI calls,
+ * selections and pooled objects created by the last replay are counted.
+ */
+
+
+#pragma once
+
+#include <map>
+#include "RVDisplayList.h"
+#include "RVSignAtlas.h"
+
+class RVGdiBackend : public RVRenderBackend
+{
+public: // Constants
+
+   struct Stats
+   {
+      Uint32   nCalls;              // GDI draw calls
+      Uint32   nSelects;            // Objects and modes changed in the DC
+      Uint32   nCreated;            // Pooled objects created
+   };
+
+
+public: // Constructor/Destructor
+
+   RVGdiBackend()
+   {
+      m_pDC = NULL;
+      m_pSigns = NULL;
+      m_pAtlas = NULL;
+      m_pFont = NULL;
+      memset(m_pens, 0, sizeof(m_pens));
+      memset(m_brushes, 0, sizeof(m_brushes));
+      memset(&m_stats, 0, sizeof(m_stats));
+      resetState();
+   };
+
+   ~RVGdiBackend()
+   {
+      releaseObjects();
+   };
+
+
+public: // Setters
+
+   void setPen  (RVDisplayList::StyleId nStyle, CPen* pPen)       { m_pens[nStyle] = pPen;      };
+   void setBrush(RVDisplayList::StyleId nStyle, CBrush* pBrush)   { m_brushes[nStyle] = pBrush; };
+   void setSigns(TrafficSign* pSigns)                             { m_pSigns = pSigns;          };
+   void setAtlas(RVSignAtlas* pAtlas)                             { m_pAtlas = pAtlas;          };
+   void setFont (CFont* pFont)                                    { m_pFont = pFont;            };
+
+
+public: // Replay
+
+   void replay(CDC& dc, const RVDisplayList& list)
+   {
+      m_pDC = &dc;
+      memset(&m_stats, 0, sizeof(m_stats));
+      int nSavedDC = dc.SaveDC();
+      resetState();
+      list.replay(*this);
+      dc.RestoreDC(nSavedDC);
+      m_pDC = NULL;
+   };
+
+   /** Deletes the pooled pens and brushes (not selected out of a replay) */
+   void releaseObjects()
+   {
+      for (PenMap::iterator it = m_pooledPens.begin(); it != m_pooledPens.end(); ++it)
+      {
+         delete it->second;
+      }
+      for (BrushMap::iterator it = m_pooledBrushes.begin(); it != m_pooledBrushes.end(); ++it)
+      {
+         delete it->second;
+      }
+      m_pooledPens.clear();
+      m_pooledBrushes.clear();
+   };
+
+   /** Counters of the last replay */
+   const Stats& getStats() const { return m_stats; };
+
+
+public: // RVRenderBackend
+
+   virtual void fillRect(const RVRect& rect, const RVStyle& style)
+   {
+      m_stats.nCalls++;
+      CRect rectFill(rect.nLeft, rect.nTop, rect.nRight, rect.nBottom);
+      if (m_brushes[style.nId] != NULL)
+      {
+         selectBkMode(OPAQUE);      // Background of the hatched brushes
+         m_pDC->FillRect(rectFill, m_brushes[style.nId]);
+      }
+      else
+      {
+         m_pDC->FillSolidRect(rectFill, style.nColor);
+      }
+   };
+
+   virtual void polyline(const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style, int nWidth)
+   {
+      toPOINTs(pPoints, nPoints);
+      if ((m_pens[style.nId] != NULL) && (nWidth == style.nWidth))
+      {
+         selectPen(m_pens[style.nId]);
+      }
+      else
+      {
+         selectPen(getPen(getPenStyle(style), nWidth, style.nColor));
+         selectBkMode(TRANSPARENT);
+      }
+      m_pDC->Polyline(&m_points[0], (int) nPoints);
+      m_stats.nCalls++;
+   };
+
+   virtual void polygon(const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style)
+   {
+      toPOINTs(pPoints, nPoints);
+      selectPen((m_pens[style.nId] != NULL) ? m_pens[style.nId] : getPen(PS_SOLID, style.nWidth, style.nColor));
+      selectBrush((m_brushes[style.nId] != NULL) ? m_brushes[style.nId] : getBrush(style.nColor));
+      m_pDC->Polygon(&m_points[0], (int) nPoints);
+      m_stats.nCalls++;
+   };
+
+   virtual void dashedLines(int xStart, int xEnd, const RVPoint* pAnchors, Uint32 nLines, int nDash, int nGap, const RVStyle& style)
+   {
+      m_points.clear();
+      for (Uint32 i = 0; i < nLines; i++)
+      {
+         for (int x = getFirstDash(xStart, pAnchors[i].x, nDash, nGap); x < xEnd; x += nDash + nGap)
+         {
+            POINT ptStart = { (x < xStart) ? xStart : x, pAnchors[i].y };
+            POINT ptEnd   = { ((x + nDash) > xEnd) ? xEnd : x + nDash, pAnchors[i].y };
+            m_points.push_back(ptStart);
+            m_points.push_back(ptEnd);
+         }
+      }
+      if (m_points.empty())
+      {
+         return;
+      }
+      if (m_counts.size() < m_points.size() / 2)
+      {
+         m_counts.resize(m_points.size() / 2, 2);
+      }
+      selectPen(m_pens[style.nId]);
+      m_pDC->PolyPolyline(&m_points[0], &m_counts[0], (int) (m_points.size() / 2));
+      m_stats.nCalls++;
+   };
+
+   virtual void sign(const RVRect& rect, const RVSignBlit& sign)
+   {
+      m_stats.nCalls++;
+      CRect rectSign(rect.nLeft, rect.nTop, rect.nRight, rect.nBottom);
+      if ((m_pAtlas != NULL) && m_pAtlas->draw(*m_pDC, m_pSigns, rectSign, sign))
+      {
+         return;                    // Blitted: the DC state is unchanged
+      }
+      if (m_pAtlas == NULL)
+      {
+         m_pSigns->draw(m_pDC, rectSign, (TrafficSign::Sign) sign.nSign, sign.nParam, sign.nDistance, sign.bLength, false);
+      }
+      resetState();                 // Drawn into the DC by TrafficSign: its state is not known anymore
+   };
+
+   virtual void text(int x, int y, const char* szText, Uint32 nLength, const RVStyle& style)
+   {
+      selectFont(m_pFont);
+      selectTextColor(style.nColor);
+      selectBkMode(TRANSPARENT);
+      m_pDC->TextOut(x, y, szText, (int) nLength);
+      m_stats.nCalls++;
+   };
+
+
+private: // Worker methods
+
+   /** Copies the points into the POINT array given to GDI (kept between calls) */
+   void toPOINTs(const RVPoint* pPoints, Uint32 nPoints)
+   {
+      if (m_points.size() < nPoints)
+      {
+         m_points.resize(nPoints);
+      }
+      for (Uint32 i = 0; i < nPoints; i++)
+      {
+         m_points[i].x = pPoints[i].x;
+         m_points[i].y = pPoints[i].y;
+      }
+   };
+
+   static int getPenStyle(const RVStyle& style)
+   {
+      switch (style.nPattern)
+      {
+         case RVStyle::PATTERN_DASH:   return PS_DASH;
+         case RVStyle::PATTERN_DOT:    return PS_DOT;
+         default:                      return PS_SOLID;
+      }
+   };
+
+   /** Pen of the pool, created on first use */
+   CPen* getPen(int nPenStyle, int nWidth, COLORREF nColor)
+   {
+      PenKey key((((Uint32) nPenStyle) << 16) | (Uint32) (nWidth & 0xFFFF), nColor);
+      PenMap::iterator it = m_pooledPens.find(key);
+      if (it != m_pooledPens.end())
+      {
+         return it->second;
+      }
+      CPen* pPen = new CPen(nPenStyle, nWidth, nColor);
+      m_pooledPens[key] = pPen;
+      m_stats.nCreated++;
+      return pPen;
+   };
+
+   /** Solid brush of the pool, created on first use */
+   CBrush* getBrush(COLORREF nColor)
+   {
+      BrushMap::iterator it = m_pooledBrushes.find(nColor);
+      if (it != m_pooledBrushes.end())
+      {
+         return it->second;
+      }
+      CBrush* pBrush = new CBrush();
+      pBrush->CreateSolidBrush(nColor);
+      m_pooledBrushes[nColor] = pBrush;
+      m_stats.nCreated++;
+      return pBrush;
+   };
+
+   /** Forgets the state of the DC: the next primitives select their objects again */
+   void resetState()
+   {
+      m_pCurPen = NULL;
+      m_pCurBrush = NULL;
+      m_pCurFont = NULL;
+      m_nCurTextColor = CLR_INVALID;
+      m_nCurBkMode = 0;
+   };
+
+   void selectPen(CPen* pPen)
+   {
+      if (pPen != m_pCurPen)
+      {
+         m_pDC->SelectObject(pPen);
+         m_pCurPen = pPen;
+         m_stats.nSelects++;
+      }
+   };
+
+   void selectBrush(CBrush* pBrush)
+   {
+      if (pBrush != m_pCurBrush)
+      {
+         m_pDC->SelectObject(pBrush);
+         m_pCurBrush = pBrush;
+         m_stats.nSelects++;
+      }
+   };
+
+   void selectFont(CFont* pFont)
+   {
+      if (pFont != m_pCurFont)
+      {
+         m_pDC->SelectObject(pFont);
+         m_pCurFont = pFont;
+         m_stats.nSelects++;
+      }
+   };
+
+   void selectTextColor(COLORREF nColor)
+   {
+      if (nColor != m_nCurTextColor)
+      {
+         m_pDC->SetTextColor(nColor);
+         m_nCurTextColor = nColor;
+         m_stats.nSelects++;
+      }
+   };
+
+   void selectBkMode(int nMode)
+   {
+      if (nMode != m_nCurBkMode)
+      {
+         m_pDC->SetBkMode(nMode);
+         m_nCurBkMode = nMode;
+         m_stats.nSelects++;
+      }
+   };
+
+
+private: // Data Members
+
+   typedef std::pair<Uint32, COLORREF>    PenKey;     // Pen style and width, color
+   typedef std::map<PenKey, CPen*>        PenMap;
+   typedef std::map<COLORREF, CBrush*>    BrushMap;
+
+   CDC*                 m_pDC;            // Set during replay()
+   TrafficSign*         m_pSigns;
+   RVSignAtlas*         m_pAtlas;
+   CFont*               m_pFont;
+   CPen*                m_pens[RVDisplayList::STYLE_COUNT];
+   CBrush*              m_brushes[RVDisplayList::STYLE_COUNT];
+   PenMap               m_pooledPens;
+   BrushMap             m_pooledBrushes;
+   std::vector<POINT>   m_points;
+   std::vector<DWORD>   m_counts;         // 2 points per polyline of PolyPolyline()
+
+   // State of the DC during replay()
+   CPen*                m_pCurPen;
+   CBrush*              m_pCurBrush;
+   CFont*               m_pCurFont;
+   COLORREF             m_nCurTextColor;
+   int                  m_nCurBkMode;     // 0 if not known
+
+   Stats                m_stats;
+};
+
+
@@ -0,0 +1,483 @@
+/**
+ * @file    RVHorizonRecord.h
+ * @brief   Snapshot of the Horizon seen by an AH callback, and its binary record in a Horizon recording.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * A snapshot holds everything RVRoadModelBuilder reads through RVHorizonSource: the links of the MPP (length,
+ * city, child links with their turn angles), the driving side of the root link and all the attributes with their
+ * distance. A recording is an append-only file of records, one per AH callback:
+ *
+ *    file     := "RVHR" version:u8 record*
+ *    record   := size:varint payload
+ *    payload  := flags:u8 time:varint [rootLink:varint] links attributes
+ *
+ * All the integers are LEB128 varints, signed values zigzag encoded. The time is absolute in a key record and
+ * the delta from the previous record otherwise. The links of a key record are all written; in the other records
+ * they are given as the links of the previous MPP dropped at its start, kept after them (with the few whose data
+ * changed) and new at its end. The link ids are written as the delta from the previous id, the attribute
+ * distances as the delta from the previous attribute. The probabilities are kept to 1/65535, a probability of 0
+ * staying 0 (the builder only tests for 0).
+ */
+
+
+#pragma once
+
+#include <vector>
+#include "RVHorizonSource.h"
+
+struct RVHorizonSnapshot
+{
+   enum Message
+   {
+      MSG_CLEAR,
+      MSG_POSITION_CHANGED,
+      MSG_ROOT_LINK
+   };
+
+   struct Link
+   {
+      Uint32   nLinkId;
+      Sint32   nLengthCM;
+      bool     bInCity;
+      Uint32   nFirstBranch;           // In branches
+      Uint32   nBranches;
+   };
+
+   struct Attribute
+   {
+      ADAS::HorizonAttribute  ahat;
+      Sint32                  nDistCM;       // As returned by getNearestAttribute()
+      Float64                 fProbability;
+   };
+
+   Message                 nMessage;
+   Uint32                  nTimeMs;          // GetTickCount() of the callback
+   Uint32                  nRootLinkId;      // Link of a MSG_ROOT_LINK
+   bool                    bRootInCity;      // isInCity() of that link
+   bool                    bRightSideDrive;  // isRightSideDrive() of the first link of the MPP
+   std::vector<Link>       links;            // The MPP, root link first
+   std::vector<RVBranch>   branches;
+   std::vector<Attribute>  attrs;            // Nearest first
+};
+
+
+class RVHorizonCodec
+{
+public: // Constants
+
+   static const Uint8   VERSION        = 1;
+   static const Uint32  HEADER_SIZE    = 5;
+
+   enum Flags
+   {
+      FLAG_MESSAGE      = 0x03,     // RVHorizonSnapshot::Message
+      FLAG_KEY          = 0x04,     // Written without the previous record
+      FLAG_RIGHT_SIDE   = 0x08,
+      FLAG_ROOT_IN_CITY = 0x10
+   };
+
+
+public: // Header
+
+   static void putHeader(std::vector<Uint8>& out)
+   {
+      const Uint8 header[HEADER_SIZE] = { 'R', 'V', 'H', 'R', VERSION };
+      out.insert(out.end(), header, header + HEADER_SIZE);
+   };
+
+   static bool isHeader(const Uint8* p, size_t nSize)
+   {
+      return (nSize >= HEADER_SIZE) && (p[0] == 'R') && (p[1] == 'V') && (p[2] == 'H') && (p[3] == 'R') && (p[4] == VERSION);
+   };
+
+
+public: // Records
+
+   /** Reads the size prefix of the record at p: the record then takes the nSize bytes after p. Returns false if the
+       prefix is cut by pEnd. */
+   static bool getRecordSize(const Uint8*& p, const Uint8* pEnd, Uint32& nSize)
+   {
+      return getVarint(p, pEnd, nSize);
+   };
+
+   /** Appends the record of the snapshot, as the delta from pPrevious if given (else as a key record) */
+   void encode(const RVHorizonSnapshot& snap, const RVHorizonSnapshot* pPrevious, std::vector<Uint8>& out)
+   {
+      std::vector<Uint8>& payload = m_payload;
+      payload.clear();
+      Uint8 nFlags = (Uint8) (snap.nMessage & FLAG_MESSAGE);
+      nFlags |= (pPrevious == NULL)   ? FLAG_KEY          : 0;
+      nFlags |= snap.bRightSideDrive  ? FLAG_RIGHT_SIDE   : 0;
+      nFlags |= snap.bRootInCity      ? FLAG_ROOT_IN_CITY : 0;
+      payload.push_back(nFlags);
+      putVarint(payload, (pPrevious == NULL) ? snap.nTimeMs : snap.nTimeMs - pPrevious->nTimeMs);
+      if (snap.nMessage == RVHorizonSnapshot::MSG_ROOT_LINK)
+      {
+         putVarint(payload, snap.nRootLinkId);
+      }
+
+      // Links
+      if (pPrevious == NULL)
+      {
+         putVarint(payload, (Uint32) snap.links.size());
+         Uint32 nPreviousId = 0;
+         for (size_t i = 0; i < snap.links.size(); i++)
+         {
+            putLink(payload, snap, i, nPreviousId);
+         }
+      }
+      else
+      {
+         // The car moved on: the MPP lost links at its start and got new ones at its end
+         size_t nDrop = 0;
+         while ((nDrop < pPrevious->links.size()) && (!snap.links.empty()) && (pPrevious->links[nDrop].nLinkId != snap.links[0].nLinkId))
+         {
+            nDrop++;                            // All dropped if the new root link is not on the previous MPP
+         }
+         size_t nKeep = 0;
+         while ((nDrop + nKeep < pPrevious->links.size()) && (nKeep < snap.links.size()) &&
+                (pPrevious->links[nDrop + nKeep].nLinkId == snap.links[nKeep].nLinkId))
+         {
+            nKeep++;
+         }
+         putVarint(payload, (Uint32) nDrop);
+         putVarint(payload, (Uint32) nKeep);
+         Uint32 nChanged = 0;
+         for (size_t i = 0; i < nKeep; i++)
+         {
+            nChanged += isSameLink(snap, i, *pPrevious, nDrop + i) ? 0 : 1;
+         }
+         putVarint(payload, nChanged);
+         for (size_t i = 0; i < nKeep; i++)
+         {
+            if (!isSameLink(snap, i, *pPrevious, nDrop + i))
+            {
+               putVarint(payload, (Uint32) i);
+               Uint32 nPreviousId = snap.links[i].nLinkId;
+               putLink(payload, snap, i, nPreviousId);
+            }
+         }
+         putVarint(payload, (Uint32) (snap.links.size() - nKeep));
+         Uint32 nPreviousId = (nKeep > 0) ? snap.links[nKeep - 1].nLinkId : 0;
+         for (size_t i = nKeep; i < snap.links.size(); i++)
+         {
+            putLink(payload, snap, i, nPreviousId);
+         }
+      }
+
+      // Attributes
+      putVarint(payload, (Uint32) snap.attrs.size());
+      Uint32 nPreviousId = 0;
+      Sint32 nPreviousDist = 0;
+      for (size_t i = 0; i < snap.attrs.size(); i++)
+      {
+         const RVHorizonSnapshot::Attribute& attr = snap.attrs[i];
+         putSigned(payload, (Sint32) (attr.ahat.nLinkId - nPreviousId));
+         putVarint(payload, (((Uint32) attr.ahat.type) << 1) | (attr.ahat.bIsStart ? 1 : 0));
+         putVarint(payload, (Uint32) attr.ahat.info);
+         putSigned(payload, attr.ahat.nLengthCM);
+         putSigned(payload, attr.ahat.nOffsetCM);
+         putSigned(payload, attr.nDistCM - nPreviousDist);
+         putVarint(payload, toFixed(attr.fProbability));
+         nPreviousId = attr.ahat.nLinkId;
+         nPreviousDist = attr.nDistCM;
+      }
+
+      putVarint(out, (Uint32) payload.size());
+      out.insert(out.end(), payload.begin(), payload.end());
+   };
+
+   /** Decodes the record at p into snap, given the snapshot of the previous record (NULL if none). Advances p past
+    *  the record. Returns false if the record is truncated, corrupt, or a delta without previous snapshot. */
+   bool decode(const Uint8*& p, const Uint8* pEnd, const RVHorizonSnapshot* pPrevious, RVHorizonSnapshot& snap)
+   {
+      Uint32 nSize;
+      if (!getVarint(p, pEnd, nSize) || (nSize > (Uint32) (pEnd - p)))
+      {
+         return false;
+      }
+      const Uint8* pRecordEnd = p + nSize;
+      if (p == pRecordEnd)
+      {
+         return false;
+      }
+      Uint8 nFlags = *p++;
+      bool bKey = (nFlags & FLAG_KEY) != 0;
+      if (!bKey && (pPrevious == NULL))
+      {
+         return false;
+      }
+      snap.nMessage = (RVHorizonSnapshot::Message) (nFlags & FLAG_MESSAGE);
+      snap.bRightSideDrive = (nFlags & FLAG_RIGHT_SIDE) != 0;
+      snap.bRootInCity = (nFlags & FLAG_ROOT_IN_CITY) != 0;
+      Uint32 nTime;
+      if (!getVarint(p, pRecordEnd, nTime))
+      {
+         return false;
+      }
+      snap.nTimeMs = bKey ? nTime : pPrevious->nTimeMs + nTime;
+      snap.nRootLinkId = 0;
+      if ((snap.nMessage == RVHorizonSnapshot::MSG_ROOT_LINK) && !getVarint(p, pRecordEnd, snap.nRootLinkId))
+      {
+         return false;
+      }
+
+      // Links
+      snap.links.clear();
+      snap.branches.clear();
+      if (bKey)
+      {
+         Uint32 nLinks;
+         if (!getVarint(p, pRecordEnd, nLinks) || (nLinks > nSize))
+         {
+            return false;
+         }
+         Uint32 nPreviousId = 0;
+         for (Uint32 i = 0; i < nLinks; i++)
+         {
+            if (!getLink(p, pRecordEnd, snap, nPreviousId))
+            {
+               return false;
+            }
+         }
+      }
+      else
+      {
+         Uint32 nDrop, nKeep, nChanged;
+         if (!getVarint(p, pRecordEnd, nDrop) || !getVarint(p, pRecordEnd, nKeep) ||
+             (nDrop > pPrevious->links.size()) || (nKeep > pPrevious->links.size() - nDrop) || !getVarint(p, pRecordEnd, nChanged))
+         {
+            return false;
+         }
+         // Changed links first, in their own snapshot, then the kept links copied or taken from it
+         RVHorizonSnapshot& changed = m_changed;
+         changed.links.clear();
+         changed.branches.clear();
+         std::vector<Uint32>& changedIdx = m_changedIdx;
+         changedIdx.clear();
+         for (Uint32 i = 0; i < nChanged; i++)
+         {
+            Uint32 nIndex;
+            if (!getVarint(p, pRecordEnd, nIndex) || (nIndex >= nKeep))
+            {
+               return false;
+            }
+            Uint32 nPreviousId = pPrevious->links[nDrop + nIndex].nLinkId;
+            if (!getLink(p, pRecordEnd, changed, nPreviousId))
+            {
+               return false;
+            }
+            changedIdx.push_back(nIndex);
+         }
+         size_t nNextChanged = 0;
+         for (Uint32 i = 0; i < nKeep; i++)
+         {
+            if ((nNextChanged < changedIdx.size()) && (changedIdx[nNextChanged] == i))
+            {
+               copyLink(changed, nNextChanged++, snap);
+            }
+            else
+            {
+               copyLink(*pPrevious, nDrop + i, snap);
+            }
+         }
+         Uint32 nNew;
+         if (!getVarint(p, pRecordEnd, nNew) || (nNew > nSize))
+         {
+            return false;
+         }
+         Uint32 nPreviousId = (nKeep > 0) ? snap.links[nKeep - 1].nLinkId : 0;
+         for (Uint32 i = 0; i < nNew; i++)
+         {
+            if (!getLink(p, pRecordEnd, snap, nPreviousId))
+            {
+               return false;
+            }
+         }
+      }
+
+      // Attributes
+      Uint32 nAttrs;
+      if (!getVarint(p, pRecordEnd, nAttrs) || (nAttrs > nSize))
+      {
+         return false;
+      }
+      snap.attrs.resize(nAttrs);
+      Uint32 nPreviousId = 0;
+      Sint32 nPreviousDist = 0;
+      for (Uint32 i = 0; i < nAttrs; i++)
+      {
+         RVHorizonSnapshot::Attribute& attr = snap.attrs[i];
+         memset(&attr.ahat, 0, sizeof(attr.ahat));
+         Sint32 nIdDelta, nDistDelta;
+         Uint32 nType, nInfo, nProbability;
+         if (!getSigned(p, pRecordEnd, nIdDelta) || !getVarint(p, pRecordEnd, nType) || !getVarint(p, pRecordEnd, nInfo) ||
+             !getSigned(p, pRecordEnd, attr.ahat.nLengthCM) || !getSigned(p, pRecordEnd, attr.ahat.nOffsetCM) ||
+             !getSigned(p, pRecordEnd, nDistDelta) || !getVarint(p, pRecordEnd, nProbability))
+         {
+            return false;
+         }
+         attr.ahat.nLinkId = nPreviousId + (Uint32) nIdDelta;
+         attr.ahat.type = (ADAS::AttributeType) (nType >> 1);
+         attr.ahat.bIsStart = (nType & 1) != 0;
+         attr.ahat.info = nInfo;
+         attr.nDistCM = nPreviousDist + nDistDelta;
+         attr.fProbability = fromFixed(nProbability);
+         nPreviousId = attr.ahat.nLinkId;
+         nPreviousDist = attr.nDistCM;
+      }
+      p = pRecordEnd;
+      return true;
+   };
+
+
+private: // Worker methods
+
+   static void putVarint(std::vector<Uint8>& out, Uint32 n)
+   {
+      while (n >= 0x80)
+      {
+         out.push_back((Uint8) (n | 0x80));
+         n >>= 7;
+      }
+      out.push_back((Uint8) n);
+   };
+
+   static void putSigned(std::vector<Uint8>& out, Sint32 n)
+   {
+      putVarint(out, (((Uint32) n) << 1) ^ (Uint32) (n >> 31));
+   };
+
+   static bool getVarint(const Uint8*& p, const Uint8* pEnd, Uint32& n)
+   {
+      n = 0;
+      for (int nShift = 0; (p < pEnd) && (nShift < 35); nShift += 7)
+      {
+         Uint8 nByte = *p++;
+         n |= ((Uint32) (nByte & 0x7F)) << nShift;
+         if ((nByte & 0x80) == 0)
+         {
+            return true;
+         }
+      }
+      return false;
+   };
+
+   static bool getSigned(const Uint8*& p, const Uint8* pEnd, Sint32& n)
+   {
+      Uint32 nZigzag;
+      if (!getVarint(p, pEnd, nZigzag))
+      {
+         return false;
+      }
+      n = (Sint32) (nZigzag >> 1) ^ -(Sint32) (nZigzag & 1);
+      return true;
+   };
+
+   static Uint32 toFixed(Float64 fProbability)
+   {
+      if (fProbability <= 0.0)
+      {
+         return 0;
+      }
+      Uint32 nFixed = (fProbability >= 1.0) ? 65535 : (Uint32) (fProbability * 65535.0 + 0.5);
+      return (nFixed > 0) ? nFixed : 1;
+   };
+
+   static Float64 fromFixed(Uint32 nFixed)
+   {
+      return nFixed / 65535.0;
+   };
+
+   /** Link with its branches. The link id is written as the delta from nPreviousId, which is updated. */
+   static void putLink(std::vector<Uint8>& out, const RVHorizonSnapshot& snap, size_t i, Uint32& nPreviousId)
+   {
+      const RVHorizonSnapshot::Link& link = snap.links[i];
+      putSigned(out, (Sint32) (link.nLinkId - nPreviousId));
+      putSigned(out, link.nLengthCM);
+      putVarint(out, (link.nBranches << 1) | (link.bInCity ? 1 : 0));
+      for (Uint32 b = 0; b < link.nBranches; b++)
+      {
+         const RVBranch& branch = snap.branches[link.nFirstBranch + b];
+         putSigned(out, (Sint32) (branch.nLinkId - link.nLinkId));
+         putSigned(out, branch.nTurnAngleDegrees);
+         putVarint(out, toFixed(branch.fProbability));
+      }
+      nPreviousId = link.nLinkId;
+   };
+
+   static bool getLink(const Uint8*& p, const Uint8* pEnd, RVHorizonSnapshot& snap, Uint32& nPreviousId)
+   {
+      RVHorizonSnapshot::Link link;
+      Sint32 nIdDelta;
+      Uint32 nBranches;
+      if (!getSigned(p, pEnd, nIdDelta) || !getSigned(p, pEnd, link.nLengthCM) || !getVarint(p, pEnd, nBranches) ||
+          ((nBranches >> 1) > (Uint32) (pEnd - p)))
+      {
+         return false;
+      }
+      link.nLinkId = nPreviousId + (Uint32) nIdDelta;
+      link.bInCity = (nBranches & 1) != 0;
+      link.nBranches = nBranches >> 1;
+      link.nFirstBranch = (Uint32) snap.branches.size();
+      for (Uint32 b = 0; b < link.nBranches; b++)
+      {
+         RVBranch branch;
+         Sint32 nChildDelta;
+         Uint32 nProbability;
+         if (!getSigned(p, pEnd, nChildDelta) || !getSigned(p, pEnd, branch.nTurnAngleDegrees) || !getVarint(p, pEnd, nProbability))
+         {
+            return false;
+         }
+         branch.nLinkId = link.nLinkId + (Uint32) nChildDelta;
+         branch.fProbability = fromFixed(nProbability);
+         snap.branches.push_back(branch);
+      }
+      snap.links.push_back(link);
+      nPreviousId = link.nLinkId;
+      return true;
+   };
+
+   /** Appends the link i of the snapshot (and its branches) to another snapshot */
+   static void copyLink(const RVHorizonSnapshot& from, size_t i, RVHorizonSnapshot& to)
+   {
+      RVHorizonSnapshot::Link link = from.links[i];
+      link.nFirstBranch = (Uint32) to.branches.size();
+      to.branches.insert(to.branches.end(), from.branches.begin() + from.links[i].nFirstBranch,
+                         from.branches.begin() + from.links[i].nFirstBranch + link.nBranches);
+      to.links.push_back(link);
+   };
+
+   /** Same link data, as written (probabilities to 1/65535) */
+   static bool isSameLink(const RVHorizonSnapshot& a, size_t i, const RVHorizonSnapshot& b, size_t j)
+   {
+      const RVHorizonSnapshot::Link& la = a.links[i];
+      const RVHorizonSnapshot::Link& lb = b.links[j];
+      if ((la.nLinkId != lb.nLinkId) || (la.nLengthCM != lb.nLengthCM) || (la.bInCity != lb.bInCity) || (la.nBranches != lb.nBranches))
+      {
+         return false;
+      }
+      for (Uint32 n = 0; n < la.nBranches; n++)
+      {
+         const RVBranch& ba = a.branches[la.nFirstBranch + n];
+         const RVBranch& bb = b.branches[lb.nFirstBranch + n];
+         if ((ba.nLinkId != bb.nLinkId) || (ba.nTurnAngleDegrees != bb.nTurnAngleDegrees) ||
+             (toFixed(ba.fProbability) != toFixed(bb.fProbability)))
+         {
+            return false;
+         }
+      }
+      return true;
+   };
+
+
+private: // Data Members
+
+   /** Kept between the records */
+   std::vector<Uint8>   m_payload;
+   RVHorizonSnapshot    m_changed;           // Kept links whose data changed
+   std::vector<Uint32>  m_changedIdx;
+};
+
+
@@ -0,0 +1,242 @@
+/**
+ * @file    RVHorizonRecorder.h
+ * @brief   Records the Horizon seen by each AH callback of the Road View into an append-only file.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * For each callback the Horizon is captured through RVHorizonSource (MPP, links and their branches, attributes)
+ * and appended as a record of RVHorizonCodec, the delta from the previous one. A recording session starts with a
+ * key record (the previous snapshot is not in the file then) and another one is written every KEY_INTERVAL
+ * records. Each record is flushed once written. A file cut by a crash is replayed up to its last complete record,
+ * and open() drops the cut record before appending the next session. RVHorizonReplay reads the file back.
+ *
+ * Capturing asks the source for the branches of every MPP link: it only runs while recording. The driving side
+ * is only asked again when the root link changes (a DAL query).
+ */
+
+
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include "RVHorizonRecord.h"
+
+#ifdef _WIN32
+   #include <io.h>
+#else
+   #include <unistd.h>
+#endif
+
+class RVHorizonRecorder
+{
+public: // Constants
+
+   static const Uint32 KEY_INTERVAL = 256;
+
+
+public: // Constructor/Destructor
+
+   RVHorizonRecorder()
+   {
+      m_pFile = NULL;
+      m_nCurrent = 0;
+      m_nRecords = 0;
+      m_nBytes = 0;
+      m_nDrivingSideLinkId = 0;
+      m_bRightSideDrive = true;
+      m_bDrivingSideKnown = false;
+   };
+
+   ~RVHorizonRecorder()
+   {
+      close();
+   };
+
+
+public: // Recording
+
+   /** Opens the file for appending, writing the header if it is new. Returns false if it cannot be opened, or if it
+       is not a recording. */
+   bool open(const char* szPath)
+   {
+      close();
+      // A record cut by a crash would hide the records appended after it: the file is cut after the last complete one
+      FILE* pFile = fopen(szPath, "r+b");
+      if (pFile != NULL)
+      {
+         long nComplete = getCompleteSize(pFile);
+         fseek(pFile, 0, SEEK_END);
+         bool bAppendable = (nComplete >= 0) && ((nComplete == ftell(pFile)) || cutFile(pFile, nComplete));
+         fclose(pFile);
+         if (!bAppendable)
+         {
+            return false;
+         }
+      }
+      m_pFile = fopen(szPath, "ab");
+      if (m_pFile == NULL)
+      {
+         return false;
+      }
+      fseek(m_pFile, 0, SEEK_END);
+      if (ftell(m_pFile) == 0)
+      {
+         m_buffer.clear();
+         RVHorizonCodec::putHeader(m_buffer);
+         write();
+      }
+      m_nRecords = 0;
+      m_bDrivingSideKnown = false;
+      return true;
+   };
+
+   void close()
+   {
+      if (m_pFile != NULL)
+      {
+         fclose(m_pFile);
+         m_pFile = NULL;
+      }
+   };
+
+   bool isOpen() const { return m_pFile != NULL; };
+
+   /** Captures the Horizon and appends the record of the callback. nRootLinkId is the link of a MSG_ROOT_LINK. */
+   void record(RVHorizonSnapshot::Message nMessage, Uint32 nRootLinkId, Uint32 nTimeMs, RVHorizonSource& source)
+   {
+      if (m_pFile == NULL)
+      {
+         return;
+      }
+      RVHorizonSnapshot& snap = m_snapshots[m_nCurrent];
+      const RVHorizonSnapshot& previous = m_snapshots[1 - m_nCurrent];
+      capture(source, snap);
+      snap.nMessage = nMessage;
+      snap.nTimeMs = nTimeMs;
+      snap.nRootLinkId = (nMessage == RVHorizonSnapshot::MSG_ROOT_LINK) ? nRootLinkId : 0;
+      snap.bRootInCity = (nMessage == RVHorizonSnapshot::MSG_ROOT_LINK) ? source.isInCity(nRootLinkId) : false;
+
+      m_buffer.clear();
+      m_codec.encode(snap, ((m_nRecords % KEY_INTERVAL) == 0) ? NULL : &previous, m_buffer);
+      write();
+      m_nRecords++;
+      m_nCurrent = 1 - m_nCurrent;
+   };
+
+
+public: // Getters
+
+   Uint32   getRecords()   const { return m_nRecords; };      // Of this session
+   Uint32   getBytes()     const { return m_nBytes;   };
+
+
+private: // Worker methods
+
+   /** Returns the size of the header and of the complete records of the file (0 if the header itself is cut), or -1
+       if the file is not a recording */
+   static long getCompleteSize(FILE* pFile)
+   {
+      Uint8 header[RVHorizonCodec::HEADER_SIZE];
+      size_t nRead = fread(header, 1, sizeof(header), pFile);
+      std::vector<Uint8> expected;
+      RVHorizonCodec::putHeader(expected);
+      if (memcmp(header, &expected[0], nRead) != 0)
+      {
+         return -1;
+      }
+      if (nRead < sizeof(header))
+      {
+         return 0;
+      }
+
+      fseek(pFile, 0, SEEK_END);
+      long nFileSize = ftell(pFile);
+      long nComplete = (long) sizeof(header);
+      while (nComplete < nFileSize)
+      {
+         Uint8 prefix[5];                         // Longest varint of a Uint32
+         fseek(pFile, nComplete, SEEK_SET);
+         size_t nPrefix = fread(prefix, 1, sizeof(prefix), pFile);
+         const Uint8* p = prefix;
+         Uint32 nSize;
+         if (!RVHorizonCodec::getRecordSize(p, prefix + nPrefix, nSize) || (nSize > (Uint32) (nFileSize - nComplete - (p - prefix))))
+         {
+            break;
+         }
+         nComplete += (long) (p - prefix) + (long) nSize;
+      }
+      return nComplete;
+   };
+
+   /** Cuts the file to nSize bytes */
+   static bool cutFile(FILE* pFile, long nSize)
+   {
+      fflush(pFile);
+#ifdef _WIN32
+      return _chsize_s(_fileno(pFile), nSize) == 0;
+#else
+      return ftruncate(fileno(pFile), (off_t) nSize) == 0;
+#endif
+   };
+
+   void capture(RVHorizonSource& source, RVHorizonSnapshot& snap)
+   {
+      m_mpp.clear();
+      source.getMostProbablePath(m_mpp);
+      snap.links.clear();
+      snap.branches.clear();
+      for (size_t i = 0; i < m_mpp.size(); i++)
+      {
+         RVHorizonSnapshot::Link link;
+         link.nLinkId = m_mpp[i];
+         link.nLengthCM = source.getLinkLengthCM(m_mpp[i]);
+         link.bInCity = source.isInCity(m_mpp[i]);
+         link.nFirstBranch = (Uint32) snap.branches.size();
+         source.getBranches(m_mpp[i], snap.branches);
+         link.nBranches = (Uint32) snap.branches.size() - link.nFirstBranch;
+         snap.links.push_back(link);
+      }
+
+      if (!m_mpp.empty() && (!m_bDrivingSideKnown || (m_nDrivingSideLinkId != m_mpp[0])))
+      {
+         m_bDrivingSideKnown = true;
+         m_nDrivingSideLinkId = m_mpp[0];
+         m_bRightSideDrive = source.isRightSideDrive(m_mpp[0]);
+      }
+      snap.bRightSideDrive = m_bRightSideDrive;
+
+      Uint32 n = source.getAttributeCount();
+      snap.attrs.resize(n);
+      for (Uint32 i = 0; i < n; i++)
+      {
+         RVHorizonSnapshot::Attribute& attr = snap.attrs[i];
+         attr.nDistCM = source.getNearestAttribute(i, &attr.fProbability, &attr.ahat);
+      }
+   };
+
+   void write()
+   {
+      if (!m_buffer.empty() && (fwrite(&m_buffer[0], 1, m_buffer.size(), m_pFile) == m_buffer.size()))
+      {
+         m_nBytes += (Uint32) m_buffer.size();
+      }
+      fflush(m_pFile);                 // Complete in the file if the plug-in crashes
+   };
+
+
+private: // Data Members
+
+   FILE*                m_pFile;
+   RVHorizonCodec       m_codec;
+   RVHorizonSnapshot    m_snapshots[2];      // Current and previous
+   int                  m_nCurrent;
+   std::vector<Uint32>  m_mpp;
+   std::vector<Uint8>   m_buffer;
+   Uint32               m_nRecords;
+   Uint32               m_nBytes;
+   Uint32               m_nDrivingSideLinkId;
+   bool                 m_bRightSideDrive;
+   bool                 m_bDrivingSideKnown;
+};
+
+
@@ -0,0 +1,247 @@
+/**
+ * @file    RVHorizonReplay.cpp
+ * @brief   Horizon source replaying a recording of RVHorizonRecorder, memory-mapped.
+ * @version 0.1
+ * @date    16.10.2026.
+ */
+
+#include "RVTypes.h"
+#include "RVHorizonReplay.h"
+
+#include <algorithm>
+
+#ifndef _WIN32
+   #include <fcntl.h>
+   #include <unistd.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+#endif
+
+/////////////////////////
+// Constructor/Destructor
+
+RVHorizonReplay::RVHorizonReplay()
+{
+   m_pData = NULL;
+   m_nSize = 0;
+   m_nPosition = 0;
+#ifdef _WIN32
+   m_hFile = INVALID_HANDLE_VALUE;
+   m_hMapping = NULL;
+#else
+   m_nFile = -1;
+#endif
+   m_nCurrent = 0;
+   m_bHasSnapshot = false;
+   m_nRecords = 0;
+};
+
+RVHorizonReplay::~RVHorizonReplay()
+{
+   close();
+};
+
+/////////
+// Replay
+
+bool RVHorizonReplay::open(const char* szPath)
+{
+   close();
+#ifdef _WIN32
+   m_hFile = CreateFileA(szPath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+   if (m_hFile == INVALID_HANDLE_VALUE)
+   {
+      return false;
+   }
+   LARGE_INTEGER nSize;
+   if (!GetFileSizeEx(m_hFile, &nSize) || (nSize.QuadPart == 0) || ((ULONGLONG) nSize.QuadPart != (size_t) nSize.QuadPart))
+   {
+      close();
+      return false;
+   }
+   m_hMapping = CreateFileMapping(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+   m_pData = (m_hMapping != NULL) ? (const Uint8*) MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+   m_nSize = (size_t) nSize.QuadPart;
+#else
+   m_nFile = ::open(szPath, O_RDONLY);
+   struct stat st;
+   if ((m_nFile < 0) || (fstat(m_nFile, &st) != 0) || (st.st_size == 0))
+   {
+      close();
+      return false;
+   }
+   void* pData = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, m_nFile, 0);
+   m_pData = (pData != MAP_FAILED) ? (const Uint8*) pData : NULL;
+   m_nSize = (size_t) st.st_size;
+   if (m_pData != NULL)
+   {
+      madvise(pData, m_nSize, MADV_SEQUENTIAL);
+   }
+#endif
+   if ((m_pData == NULL) || !RVHorizonCodec::isHeader(m_pData, m_nSize))
+   {
+      close();
+      return false;
+   }
+   rewind();
+   return true;
+};
+
+void RVHorizonReplay::close()
+{
+#ifdef _WIN32
+   if (m_pData != NULL)
+   {
+      UnmapViewOfFile(m_pData);
+   }
+   if (m_hMapping != NULL)
+   {
+      CloseHandle(m_hMapping);
+      m_hMapping = NULL;
+   }
+   if (m_hFile != INVALID_HANDLE_VALUE)
+   {
+      CloseHandle(m_hFile);
+      m_hFile = INVALID_HANDLE_VALUE;
+   }
+#else
+   if (m_pData != NULL)
+   {
+      munmap((void*) m_pData, m_nSize);
+   }
+   if (m_nFile >= 0)
+   {
+      ::close(m_nFile);
+      m_nFile = -1;
+   }
+#endif
+   m_pData = NULL;
+   m_nSize = 0;
+   m_nPosition = 0;
+   m_bHasSnapshot = false;
+};
+
+void RVHorizonReplay::rewind()
+{
+   m_nPosition = RVHorizonCodec::HEADER_SIZE;
+   m_bHasSnapshot = false;
+   m_nRecords = 0;
+   m_snapshots[m_nCurrent] = RVHorizonSnapshot();
+   m_linkIndex.clear();
+   m_attrIndex.clear();
+};
+
+// The record is decoded into the other snapshot, the current one being its previous snapshot
+bool RVHorizonReplay::next()
+{
+   if ((m_pData == NULL) || (m_nPosition >= m_nSize))
+   {
+      return false;
+   }
+   const Uint8* p = m_pData + m_nPosition;
+   int nNext = 1 - m_nCurrent;
+   if (!m_codec.decode(p, m_pData + m_nSize, m_bHasSnapshot ? &m_snapshots[m_nCurrent] : NULL, m_snapshots[nNext]))
+   {
+      m_nPosition = m_nSize;
+      return false;
+   }
+   m_nPosition = p - m_pData;
+   m_nCurrent = nNext;
+   m_bHasSnapshot = true;
+   m_nRecords++;
+   buildIndex();
+   return true;
+};
+
+//////////////////
+// RVHorizonSource
+
+void RVHorizonReplay::getMostProbablePath(std::vector<Uint32>& mpp)
+{
+   const RVHorizonSnapshot& snap = getSnapshot();
+   for (size_t i = 0; i < snap.links.size(); i++)
+   {
+      mpp.push_back(snap.links[i].nLinkId);
+   }
+};
+
+Sint32 RVHorizonReplay::getLinkLengthCM(Uint32 nLinkId)
+{
+   int nIndex = findLink(nLinkId);
+   return (nIndex >= 0) ? getSnapshot().links[nIndex].nLengthCM : 0;
+};
+
+bool RVHorizonReplay::isInCity(Uint32 nLinkId)
+{
+   const RVHorizonSnapshot& snap = getSnapshot();
+   if ((snap.nMessage == RVHorizonSnapshot::MSG_ROOT_LINK) && (nLinkId == snap.nRootLinkId))
+   {
+      return snap.bRootInCity;
+   }
+   int nIndex = findLink(nLinkId);
+   return (nIndex >= 0) ? snap.links[nIndex].bInCity : false;
+};
+
+bool RVHorizonReplay::isRightSideDrive(Uint32 /*nLinkId*/)
+{
+   return getSnapshot().bRightSideDrive;
+};
+
+void RVHorizonReplay::getBranches(Uint32 nLinkId, std::vector<RVBranch>& branches)
+{
+   int nIndex = findLink(nLinkId);
+   if (nIndex >= 0)
+   {
+      const RVHorizonSnapshot& snap = getSnapshot();
+      const RVHorizonSnapshot::Link& link = snap.links[nIndex];
+      branches.insert(branches.end(), snap.branches.begin() + link.nFirstBranch, snap.branches.begin() + link.nFirstBranch + link.nBranches);
+   }
+};
+
+Uint32 RVHorizonReplay::getAttributeCount()
+{
+   return (Uint32) getSnapshot().attrs.size();
+};
+
+Sint32 RVHorizonReplay::getNearestAttribute(Uint32 nIndex, Float64* pfProbability, ADAS::HorizonAttribute* pAttr)
+{
+   const RVHorizonSnapshot::Attribute& attr = getSnapshot().attrs[nIndex];
+   *pfProbability = attr.fProbability;
+   *pAttr = attr.ahat;
+   return attr.nDistCM;
+};
+
+void RVHorizonReplay::getLinkAttributes(Uint32 nLinkId, std::vector<ADAS::HorizonAttribute>& attrs)
+{
+   std::vector<IndexEntry>::const_iterator it = std::lower_bound(m_attrIndex.begin(), m_attrIndex.end(), IndexEntry(nLinkId, 0));
+   for (; (it != m_attrIndex.end()) && (it->first == nLinkId); ++it)
+   {
+      attrs.push_back(getSnapshot().attrs[it->second].ahat);
+   }
+};
+
+/////////////////
+// Worker methods
+
+void RVHorizonReplay::buildIndex()
+{
+   const RVHorizonSnapshot& snap = getSnapshot();
+   m_linkIndex.resize(snap.links.size());
+   for (size_t i = 0; i < snap.links.size(); i++)
+   {
+      m_linkIndex[i] = IndexEntry(snap.links[i].nLinkId, (Uint32) i);
+   }
+   std::sort(m_linkIndex.begin(), m_linkIndex.end());
+   m_attrIndex.resize(snap.attrs.size());
+   for (size_t i = 0; i < snap.attrs.size(); i++)
+   {
+      m_attrIndex[i] = IndexEntry(snap.attrs[i].ahat.nLinkId, (Uint32) i);
+   }
+   std::sort(m_attrIndex.begin(), m_attrIndex.end());     // By link, then by index: the nearest order is kept
+};
+
+int RVHorizonReplay::findLink(Uint32 nLinkId) const
+{
+   std::vector<IndexEntry>::const_iterator it = std::lower_bound(m_linkIndex.begin(), m_linkIndex.end(), IndexEntry(nLinkId, 0));
+   return ((it != m_linkIndex.end()) && (it->first == nLinkId)) ? (int) it->second : -1;
+};
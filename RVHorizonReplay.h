@@ -0,0 +1,98 @@
+/**
+ * @file    RVHorizonReplay.h
+ * @brief   Horizon source replaying a recording of RVHorizonRecorder, memory-mapped.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The file is mapped read-only and decoded one record at a time by next(): the source then answers the queries
+ * of RVRoadModelBuilder from the snapshot of that record, as the plug-in does from the Horizon Container. Neither
+ * ADASRP nor the map database are needed (Windows or POSIX), and nothing waits for the recorded times: a driver
+ * loop feeds the builder as fast as it builds, e.g.
+ *
+ *    RVHorizonReplay replay;
+ *    replay.open(szPath);
+ *    while (replay.next())
+ *    {
+ *       const RVHorizonSnapshot& snap = replay.getSnapshot();
+ *       if (snap.nMessage == RVHorizonSnapshot::MSG_ROOT_LINK)
+ *          builder.setRootLink(replay, snap.nRootLinkId);
+ *       else if (scheduler.onMessage(snap.nMessage == RVHorizonSnapshot::MSG_CLEAR, snap.nTimeMs))
+ *          ...scanHorizon(replay, scheduler.beginRebuild(snap.nTimeMs))...
+ *    }
+ *
+ * The links which are not on the recorded MPP are unknown: their length is 0, they have no branches and they
+ * are not in a city. The driving side is the one of the root link for all links.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include "RVHorizonRecord.h"
+
+class RVHorizonReplay : public RVHorizonSource
+{
+public: // Constructor/Destructor
+
+   RVHorizonReplay();
+   virtual ~RVHorizonReplay();
+
+
+public: // Replay
+
+   /** Maps the recording. Returns false if it cannot be mapped or is not a recording. */
+   bool open(const char* szPath);
+   void close();
+   /** Goes back to the first record */
+   void rewind();
+   /** Decodes the next record. Returns false at the end of the file or at a truncated record. */
+   bool next();
+
+   const RVHorizonSnapshot&   getSnapshot()  const { return m_snapshots[m_nCurrent]; };
+   Uint32                     getRecords()   const { return m_nRecords; };      // Decoded since open() or rewind()
+   size_t                     getSize()      const { return m_nSize;    };
+
+
+public: // RVHorizonSource
+
+   virtual void   getMostProbablePath(std::vector<Uint32>& mpp);
+   virtual Sint32 getLinkLengthCM(Uint32 nLinkId);
+   virtual bool   isInCity(Uint32 nLinkId);
+   virtual bool   isRightSideDrive(Uint32 nLinkId);
+   virtual void   getBranches(Uint32 nLinkId, std::vector<RVBranch>& branches);
+   virtual Uint32 getAttributeCount();
+   virtual Sint32 getNearestAttribute(Uint32 nIndex, Float64* pfProbability, ADAS::HorizonAttribute* pAttr);
+   virtual void   getLinkAttributes(Uint32 nLinkId, std::vector<ADAS::HorizonAttribute>& attrs);
+
+
+private: // Worker methods
+
+   /** Sorts the links and the attributes of the snapshot by link id, for the queries by link */
+   void buildIndex();
+   /** Index of the link in the snapshot, -1 if not on the recorded MPP */
+   int findLink(Uint32 nLinkId) const;
+
+
+private: // Data Members
+
+   typedef std::pair<Uint32, Uint32> IndexEntry;      // Link id, index in the snapshot
+
+   const Uint8*               m_pData;
+   size_t                     m_nSize;
+   size_t                     m_nPosition;
+#ifdef _WIN32
+   HANDLE                     m_hFile;
+   HANDLE                     m_hMapping;
+#else
+   int                        m_nFile;
+#endif
+   RVHorizonCodec             m_codec;
+   RVHorizonSnapshot          m_snapshots[2];      // Current and previous
+   int                        m_nCurrent;
+   bool                       m_bHasSnapshot;
+   Uint32                     m_nRecords;
+   std::vector<IndexEntry>    m_linkIndex;
+   std::vector<IndexEntry>    m_attrIndex;         // Stable: the attributes of a link keep their order
+};
+
+
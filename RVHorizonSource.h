@@ -0,0 +1,53 @@
+/**
+ * @file    RVHorizonSource.h
+ * @brief   Queries on the Horizon needed to build the road model.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * RVRoadModelBuilder only reads the Horizon through this interface. The plug-in implements it over the
+ * AH Horizon Container and the DAL; a stand-in implementation can feed the builder without ADASRP running.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+/** Child link at the end of a link, other than the U-turn */
+struct RVBranch
+{
+   Uint32   nLinkId;
+   int      nTurnAngleDegrees;      // < 0 for a left turn, > 0 for a right turn
+   Float64  fProbability;           // 0 for a prohibited (wrong-way) link
+};
+
+
+class RVHorizonSource
+{
+public: // Constructor/Destructor
+
+   virtual ~RVHorizonSource() {};
+
+
+public: // Links
+
+   /** Gets the link ids of the most probable path, starting with the root link */
+   virtual void   getMostProbablePath(std::vector<Uint32>& mpp) = 0;
+   virtual Sint32 getLinkLengthCM(Uint32 nLinkId) = 0;
+   virtual bool   isInCity(Uint32 nLinkId) = 0;
+   /** Returns false if traffic drives on the left on the link */
+   virtual bool   isRightSideDrive(Uint32 nLinkId) = 0;
+   /** Gets the child links at the end of a link, U-turns excluded */
+   virtual void   getBranches(Uint32 nLinkId, std::vector<RVBranch>& branches) = 0;
+
+
+public: // Attributes
+
+   virtual Uint32 getAttributeCount() = 0;
+   /** Gets the n'th nearest attribute of the Horizon and returns its distance from the car */
+   virtual Sint32 getNearestAttribute(Uint32 nIndex, Float64* pfProbability, ADAS::HorizonAttribute* pAttr) = 0;
+   /** Appends the attributes of a link */
+   virtual void   getLinkAttributes(Uint32 nLinkId, std::vector<ADAS::HorizonAttribute>& attrs) = 0;
+};
+
+
@@ -0,0 +1,117 @@
+/**
+ * @file    RVLayer.h
+ * @brief   Off-screen surface of the Road View, kept between paints and re-rendered only when invalidated.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * A layer is a memory DC with a bitmap compatible with the window. The surface is only recreated when the
+ * window size changes; its content is only re-rendered when the layer has been invalidated. The render times
+ * and the paints served from the cached content are counted.
+ */
+
+
+#pragma once
+
+class RVLayer
+{
+public: // Constants
+
+   struct Stats
+   {
+      Uint32   nSurfaces;           // Surfaces created
+      Uint32   nRenders;            // Content rendered
+      Uint32   nHits;               // Content reused
+      double   fLastRenderMs;
+   };
+
+
+public: // Constructor/Destructor
+
+   RVLayer()
+   {
+      m_pOldBitmap = NULL;
+      m_bValid = false;
+      m_nRenderStart.QuadPart = 0;
+      memset(&m_stats, 0, sizeof(m_stats));
+   };
+
+   ~RVLayer()
+   {
+      release();
+   };
+
+
+public: // Surface
+
+   /** Creates the surface if it does not exist or has another size. Returns true if it was created (content invalid). */
+   bool prepare(CDC& dc, const CSize& size)
+   {
+      if ((m_dc.GetSafeHdc() != NULL) && (m_size == size))
+      {
+         return false;
+      }
+      release();
+      m_dc.CreateCompatibleDC(&dc);
+      m_bitmap.CreateCompatibleBitmap(&dc, size.cx, size.cy);
+      m_pOldBitmap = m_dc.SelectObject(&m_bitmap);
+      m_size = size;
+      m_stats.nSurfaces++;
+      return true;
+   };
+
+   /** Deletes the surface (window resized or destroyed, DPI changed) */
+   void release()
+   {
+      if (m_dc.GetSafeHdc() != NULL)
+      {
+         m_dc.SelectObject(m_pOldBitmap);
+         m_dc.DeleteDC();
+         m_bitmap.DeleteObject();
+      }
+      m_bValid = false;
+   };
+
+   CDC&           getDC()                 { return m_dc;   };
+   const CSize&   getSize()         const { return m_size; };
+
+
+public: // Content
+
+   void invalidate()                { m_bValid = false; };
+   bool isValid()             const { return m_bValid;  };
+
+   /** To be called around the rendering of the content */
+   void beginRender()
+   {
+      QueryPerformanceCounter(&m_nRenderStart);
+   };
+
+   void endRender()
+   {
+      LARGE_INTEGER nEnd;
+      LARGE_INTEGER nFrequency;
+      QueryPerformanceCounter(&nEnd);
+      QueryPerformanceFrequency(&nFrequency);
+      m_stats.fLastRenderMs = (double) (nEnd.QuadPart - m_nRenderStart.QuadPart) * 1000.0 / (double) nFrequency.QuadPart;
+      m_stats.nRenders++;
+      m_bValid = true;
+   };
+
+   /** To be called when a paint uses the cached content */
+   void countHit()                  { m_stats.nHits++; };
+
+   const Stats& getStats()    const { return m_stats; };
+
+
+private: // Data Members
+
+   CDC            m_dc;
+   CBitmap        m_bitmap;
+   CBitmap*       m_pOldBitmap;
+   CSize          m_size;
+   bool           m_bValid;
+   LARGE_INTEGER  m_nRenderStart;
+   Stats          m_stats;
+};
+
+
@@ -0,0 +1,115 @@
+/**
+ * @file    RVLinkCache.h
+ * @brief   Per-link summary of the attributes used by the Road View (lanes, one way, speed limits).
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The summary of a link is filled on first access and stays valid for the current Horizon generation.
+ * Invalidating only increments the generation, so that the entries are refilled in place.
+ */
+
+
+#pragma once
+
+#include <map>
+#include "RVPoolAllocator.h"
+
+struct RVLinkSummary
+{
+   int      nLanesCount;            // Number of ADAS Number of Lanes attributes on the link
+   int      nLanes;
+   int      nOppositeLanesCount;    // Number of ADAS Opposite Number of Lanes attributes on the link
+   int      nOppositeLanes;
+   int      nOneWayCount;           // Number of Right Way attributes on the link
+   Uint32   nCurrentSpeed;          // Current/ADAS Speed Limit, 0 if not defined
+   Uint32   nExpectedSpeed;         // Expected Speed Limit (from the Speed Category), 0 if not defined
+};
+
+
+class RVLinkCache
+{
+public: // Constructor/Destructor
+
+   RVLinkCache()
+   {
+      m_nGeneration = 1;
+      m_nUsed = 0;
+      m_nHits = 0;
+      m_nMisses = 0;
+   };
+
+
+public: // Access
+
+   /** Invalidates all the summaries (new Horizon). Stale entries are dropped only if they outnumber the used ones. */
+   void invalidate()
+   {
+      if (m_entries.size() > 2 * m_nUsed + MIN_ENTRIES)
+      {
+         EntryMap::iterator it = m_entries.begin();
+         while (it != m_entries.end())
+         {
+            if (it->second.nGeneration != m_nGeneration)
+            {
+               m_entries.erase(it++);
+            }
+            else
+            {
+               ++it;
+            }
+         }
+      }
+      m_nGeneration++;
+      m_nUsed = 0;
+   };
+
+   /** Returns the summary of the link if it is valid for the current generation, NULL otherwise */
+   const RVLinkSummary* find(Uint32 nLinkId)
+   {
+      EntryMap::iterator it = m_entries.find(nLinkId);
+      if ((it == m_entries.end()) || (it->second.nGeneration != m_nGeneration))
+      {
+         m_nMisses++;
+         return NULL;
+      }
+      m_nHits++;
+      return &it->second.summary;
+   };
+
+   /** Returns the (reset) summary of the link, to be filled by the caller */
+   RVLinkSummary& insert(Uint32 nLinkId)
+   {
+      Entry& entry = m_entries[nLinkId];
+      entry.nGeneration = m_nGeneration;
+      memset(&entry.summary, 0, sizeof(entry.summary));
+      m_nUsed++;
+      return entry.summary;
+   };
+
+
+public: // Getters
+
+   Uint32 getHits()     const { return m_nHits;   };
+   Uint32 getMisses()   const { return m_nMisses; };
+
+
+private: // Data Members
+
+   struct Entry
+   {
+      RVLinkSummary  summary;
+      Uint32         nGeneration;
+   };
+
+   static const size_t        MIN_ENTRIES = 256;
+
+   typedef std::map<Uint32, Entry, std::less<Uint32>, RVPoolAllocator<std::pair<const Uint32, Entry> > > EntryMap;
+
+   EntryMap                   m_entries;
+   Uint32                     m_nGeneration;
+   size_t                     m_nUsed;
+   Uint32                     m_nHits;
+   Uint32                     m_nMisses;
+};
+
+
@@ -0,0 +1,76 @@
+/**
+ * @file    RVModelBuffer.h
+ * @brief   Triple buffer handing the road models over from the AH listener to the painting.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The writer fills the back buffer and publishes it with one atomic exchange. The reader takes the latest
+ * published model with one atomic exchange as well. Neither side ever locks or waits, and the model the reader
+ * holds is never written to until the reader acquires again, so that a paint always sees a complete model.
+ * There must be only one writer thread and one reader thread.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include "RVRoadModel.h"
+
+class RVModelBuffer
+{
+public: // Constructor/Destructor
+
+   RVModelBuffer()
+      : m_nMiddle(1)
+   {
+      m_nBack  = 0;
+      m_nFront = 2;
+   };
+
+
+public: // Writer
+
+   /** Returns the model to be filled. It keeps its content (and capacity) from two publications ago. */
+   RVRoadModel& getBackBuffer()
+   {
+      return m_models[m_nBack];
+   };
+
+   /** Publishes the back buffer as the latest model and takes over the previous middle buffer */
+   void publish()
+   {
+      m_nBack = m_nMiddle.exchange(m_nBack | FRESH) & INDEX_MASK;
+   };
+
+
+public: // Reader
+
+   /** Returns the latest published model. The reference stays valid until the next call. */
+   const RVRoadModel& acquire()
+   {
+      if (m_nMiddle.load() & FRESH)
+      {
+         m_nFront = m_nMiddle.exchange(m_nFront) & INDEX_MASK;
+      }
+      return m_models[m_nFront];
+   };
+
+   /** Returns true if a model was published since the last acquire() */
+   bool hasNewModel() const
+   {
+      return (m_nMiddle.load() & FRESH) != 0;
+   };
+
+
+private: // Data Members
+
+   static const unsigned int  INDEX_MASK = 0x3;
+   static const unsigned int  FRESH      = 0x4;   // Set in m_nMiddle when it holds a model not acquired yet
+
+   RVRoadModel                m_models[3];
+   unsigned int               m_nBack;            // Owned by the writer
+   std::atomic<unsigned int>  m_nMiddle;          // Shared: last published model
+   unsigned int               m_nFront;           // Owned by the reader
+};
+
+
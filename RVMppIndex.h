@@ -0,0 +1,130 @@
+/**
+ * @file    RVMppIndex.h
+ * @brief   Index of the links on the most probable path (MPP), keyed by link id.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The index is rebuilt once per Horizon update and answers "is this link on the MPP" and
+ * "at which position" in constant time, instead of scanning the MPP vector for each attribute.
+ * It also holds the cumulative link offsets along the MPP, so that the distance of any point on the MPP
+ * is one lookup plus its offset on the link.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+class RVMppIndex
+{
+public: // Constructor/Destructor
+
+   RVMppIndex()
+   {
+      m_nMask = 0;
+   };
+
+
+public: // Building
+
+   /** Rebuilds the index from the MPP link ids (in driving order). The allocated table is kept between builds. */
+   void build(const std::vector<Uint32>& mpp)
+   {
+      m_ids.assign(mpp.begin(), mpp.end());
+      m_linkStartCM.assign(mpp.size() + 1, 0);
+
+      // Open addressing table with a load factor of at most 50%
+      size_t nSlots = MIN_SLOTS;
+      while (nSlots < 2 * mpp.size())
+      {
+         nSlots *= 2;
+      }
+      Slot empty = { 0, EMPTY };
+      m_slots.assign(nSlots, empty);
+      m_nMask = (Uint32) nSlots - 1;
+
+      for (int nPosition = 0;  nPosition < (int) mpp.size();  nPosition++)
+      {
+         Uint32 nSlot = hash(mpp[nPosition]) & m_nMask;
+         while (m_slots[nSlot].nPosition != EMPTY)
+         {
+            if (m_slots[nSlot].nLinkId == mpp[nPosition])
+            {
+               break;   // Keep the first position if a link is found twice on the MPP
+            }
+            nSlot = (nSlot + 1) & m_nMask;
+         }
+         if (m_slots[nSlot].nPosition == EMPTY)
+         {
+            m_slots[nSlot].nLinkId   = mpp[nPosition];
+            m_slots[nSlot].nPosition = nPosition;
+         }
+      }
+   };
+
+
+   /** Sets the length of the link at the given position. The lengths have to be set in MPP order. */
+   void setLinkLengthCM(int nPosition, Sint32 nLengthCM)
+   {
+      m_linkStartCM[nPosition + 1] = m_linkStartCM[nPosition] + nLengthCM;
+   };
+
+
+public: // Getters
+
+   /** Returns the position (0 = root link) of the link on the MPP, or -1 if the link is not on the MPP */
+   int getPosition(Uint32 nLinkId) const
+   {
+      if (m_slots.empty())
+      {
+         return EMPTY;
+      }
+      Uint32 nSlot = hash(nLinkId) & m_nMask;
+      while (m_slots[nSlot].nPosition != EMPTY)
+      {
+         if (m_slots[nSlot].nLinkId == nLinkId)
+         {
+            return m_slots[nSlot].nPosition;
+         }
+         nSlot = (nSlot + 1) & m_nMask;
+      }
+      return EMPTY;
+   };
+
+   bool   contains(Uint32 nLinkId)   const { return getPosition(nLinkId) != EMPTY; };
+   /** Returns the id of the link at the given position on the MPP */
+   Uint32 getId(int nPosition)       const { return m_ids[nPosition]; };
+   int    getSize()                  const { return (int) m_ids.size(); };
+   /** Returns the distance along the MPP from the start of the root link to the start of the link at the given position */
+   Sint32 getLinkStartCM(int nPosition)                       const { return m_linkStartCM[nPosition]; };
+   /** Returns the distance along the MPP from the start of the root link to a point of the link at the given position */
+   Sint32 getPathDistanceCM(int nPosition, Sint32 nOffsetCM)  const { return m_linkStartCM[nPosition] + nOffsetCM; };
+
+
+private: // Helpers
+
+   static Uint32 hash(Uint32 nLinkId)
+   {
+      Uint32 h = nLinkId * 0x9E3779B1;   // Fibonacci hashing, link ids are often consecutive
+      return h ^ (h >> 16);
+   };
+
+
+private: // Data Members
+
+   struct Slot
+   {
+      Uint32 nLinkId;
+      int    nPosition;
+   };
+
+   static const int     EMPTY     = -1;
+   static const size_t  MIN_SLOTS = 16;
+
+   std::vector<Slot>    m_slots;
+   std::vector<Uint32>  m_ids;
+   std::vector<Sint32>  m_linkStartCM;     // Prefix sums of the link lengths, one more entry than links
+   Uint32               m_nMask;
+};
+
+
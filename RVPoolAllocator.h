@@ -0,0 +1,123 @@
+/**
+ * @file    RVPoolAllocator.h
+ * @brief   Allocator keeping the freed elements for reuse, for the node based containers of the road model builder.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * Single elements (the nodes of a std::map) are taken from a free list and given back to it instead of the heap,
+ * so that a container which erases and inserts about the same number of entries per update does not allocate
+ * once it has reached its usual size. The free list grows by blocks of as many nodes as already allocated: a size
+ * drifting up slowly (a new largest Horizon now and then) does not allocate once per new node. The free lists are
+ * shared by all the containers with the same node type and are not thread safe: these containers must only be
+ * used by the builder thread.
+ */
+
+
+#pragma once
+
+#include <new>
+#include <stddef.h>
+
+template <class T>
+class RVPoolAllocator
+{
+public: // Types
+
+   typedef T                  value_type;
+   typedef T*                 pointer;
+   typedef const T*           const_pointer;
+   typedef T&                 reference;
+   typedef const T&           const_reference;
+   typedef size_t             size_type;
+   typedef ptrdiff_t          difference_type;
+
+   template <class U> struct rebind { typedef RVPoolAllocator<U> other; };
+
+
+public: // Constructor/Destructor
+
+   RVPoolAllocator() {};
+   RVPoolAllocator(const RVPoolAllocator&) {};
+   template <class U> RVPoolAllocator(const RVPoolAllocator<U>&) {};
+
+
+public: // Allocator
+
+   pointer allocate(size_type n, const void* = 0)
+   {
+      if (n != 1)
+      {
+         return static_cast<pointer>(::operator new(n * sizeof(T)));
+      }
+      if (s_pFree == NULL)
+      {
+         grow();
+      }
+      FreeNode* pNode = s_pFree;
+      s_pFree = pNode->pNext;
+      return reinterpret_cast<pointer>(pNode);
+   };
+
+   void deallocate(pointer p, size_type n)
+   {
+      if (n == 1)
+      {
+         FreeNode* pNode = reinterpret_cast<FreeNode*>(p);
+         pNode->pNext = s_pFree;
+         s_pFree = pNode;
+      }
+      else
+      {
+         ::operator delete(p);
+      }
+   };
+
+   void construct(pointer p, const T& value)   { new((void*) p) T(value); };
+   void destroy(pointer p)                     { p->~T(); };
+
+   pointer       address(reference r)       const { return &r; };
+   const_pointer address(const_reference r) const { return &r; };
+   size_type     max_size()                 const { return ((size_type) -1) / sizeof(T); };
+
+   template <class U> bool operator==(const RVPoolAllocator<U>&) const { return true;  };
+   template <class U> bool operator!=(const RVPoolAllocator<U>&) const { return false; };
+
+
+private: // Worker methods
+
+   /** Puts a new block of nodes on the free list, as many as already allocated (at least MIN_BLOCK). The blocks
+       are kept until the end of the process, as the freed nodes are. */
+   static void grow()
+   {
+      size_t nNodes = (s_nNodes < MIN_BLOCK) ? MIN_BLOCK : s_nNodes;
+      char* pBlock = static_cast<char*>(::operator new(nNodes * NODE_SIZE));
+      for (size_t i = nNodes;  i > 0;  i--)
+      {
+         FreeNode* pNode = reinterpret_cast<FreeNode*>(pBlock + (i - 1) * NODE_SIZE);
+         pNode->pNext = s_pFree;
+         s_pFree = pNode;
+      }
+      s_nNodes += nNodes;
+   };
+
+
+private: // Data Members
+
+   struct FreeNode
+   {
+      FreeNode*   pNext;
+   };
+
+   static const size_t NODE_SIZE = (sizeof(T) < sizeof(FreeNode)) ? sizeof(FreeNode) : sizeof(T);
+   static const size_t MIN_BLOCK = 16;
+
+   static FreeNode*  s_pFree;
+   static size_t     s_nNodes;         // Nodes allocated by all the blocks
+};
+
+template <class T>
+typename RVPoolAllocator<T>::FreeNode* RVPoolAllocator<T>::s_pFree = NULL;
+template <class T>
+size_t RVPoolAllocator<T>::s_nNodes = 0;
+
+
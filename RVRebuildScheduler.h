@@ -0,0 +1,102 @@
+/**
+ * @file    RVRebuildScheduler.h
+ * @brief   Coalesces the AH messages into rebuilds of the road model, at a limited rate.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * Each AH message asks for a rebuild. If the last rebuild is too recent, the request is kept pending and the
+ * following messages are merged into it (a full rebuild wins over an incremental one). The pending rebuild runs
+ * as soon as the interval has elapsed, from the next listener callback or from the timer of the view if no message
+ * comes, so that it always reads the newest Horizon. The caller serializes the calls (see CAHRoadView::m_rebuildLock).
+ * Times are given in ms by the caller and may wrap around.
+ */
+
+
+#pragma once
+
+class RVRebuildScheduler
+{
+public: // Constructor/Destructor
+
+   RVRebuildScheduler()
+   {
+      m_nMinIntervalMs     = 0;
+      m_nLastRebuildMs     = 0;
+      m_bPending           = false;
+      m_bPendingFull       = false;
+      m_bRebuilt           = false;
+      m_nMessages          = 0;
+      m_nRebuilds          = 0;
+      m_nCoalesced         = 0;
+   };
+
+
+public: // Setters
+
+   /** Sets the max number of rebuilds per second, 0 for no limit */
+   void setMaxRate(Uint32 nRebuildsPerSecond)
+   {
+      m_nMinIntervalMs = (nRebuildsPerSecond > 0) ? (1000 / nRebuildsPerSecond) : 0;
+   };
+
+
+public: // Scheduling
+
+   /** Records a message asking for a rebuild. Returns true if the rebuild has to run now. */
+   bool onMessage(bool bFullRebuild, Uint32 nNowMs)
+   {
+      m_nMessages++;
+      if (m_bPending)
+      {
+         m_nCoalesced++;      // The pending rebuild will read the Horizon of this message instead
+      }
+      m_bPending = true;
+      m_bPendingFull = m_bPendingFull || bFullRebuild;
+      return isDue(nNowMs);
+   };
+
+   /** Returns true if a rebuild is pending and the min interval since the last rebuild has elapsed */
+   bool isDue(Uint32 nNowMs) const
+   {
+      if (!m_bPending)
+      {
+         return false;
+      }
+      return !m_bRebuilt || (nNowMs - m_nLastRebuildMs >= m_nMinIntervalMs);
+   };
+
+   /** Takes the pending rebuild. Returns true if it has to be a full rebuild. */
+   bool beginRebuild(Uint32 nNowMs)
+   {
+      bool bFullRebuild = m_bPendingFull;
+      m_bPending = false;
+      m_bPendingFull = false;
+      m_bRebuilt = true;
+      m_nLastRebuildMs = nNowMs;
+      m_nRebuilds++;
+      return bFullRebuild;
+   };
+
+
+public: // Getters
+
+   Uint32 getMinIntervalMs() const { return m_nMinIntervalMs; };
+   bool   isPending()       const { return m_bPending;   };
+   Uint32 getMessages()     const { return m_nMessages;  };
+   Uint32 getRebuilds()     const { return m_nRebuilds;  };
+   Uint32 getCoalesced()    const { return m_nCoalesced; };
+
+
+private: // Data Members
+
+   Uint32   m_nMinIntervalMs;
+   Uint32   m_nLastRebuildMs;
+   bool     m_bPending;
+   bool     m_bPendingFull;
+   bool     m_bRebuilt;             // False until the first rebuild
+   Uint32   m_nMessages;            // AH messages received
+   Uint32   m_nRebuilds;            // Rebuilds run
+   Uint32   m_nCoalesced;           // Messages merged into a later rebuild
+};
+
+
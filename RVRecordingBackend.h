@@ -0,0 +1,138 @@
+/**
+ * @file    RVRecordingBackend.h
+ * @brief   Headless backend recording a Road View display list as text, one line per primitive.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * Needs no window nor GDI: the recorded lines give the layout computed by the paint methods (coordinates, styles,
+ * signs) so that they can be compared between two versions, and the counters give the cost of a frame per type of
+ * primitive (primitives, points, filled pixels).
+ */
+
+
+#pragma once
+
+#include <string>
+#include <stdio.h>
+#include <stdarg.h>
+#include "RVDisplayList.h"
+
+class RVRecordingBackend : public RVRenderBackend
+{
+public: // Constants
+
+   struct Stats
+   {
+      Uint32   nPrimitives[RVDisplayList::CMD_TYPES];
+      Uint32   nPoints;             // Points of the lines and polygons, anchors of the dashed lines
+      Uint32   nFilledPixels;       // Area of the filled rectangles
+   };
+
+
+public: // Constructor/Destructor
+
+   RVRecordingBackend()
+   {
+      clear();
+   };
+
+
+public: // Recording
+
+   void clear()
+   {
+      m_szRecord.clear();
+      memset(&m_stats, 0, sizeof(m_stats));
+   };
+
+   /** Appends the primitives of the list to the record */
+   void record(const RVDisplayList& list)
+   {
+      list.replay(*this);
+   };
+
+   const std::string&   getRecord()    const { return m_szRecord; };
+   const Stats&         getStats()     const { return m_stats;    };
+
+
+public: // RVRenderBackend
+
+   virtual void fillRect(const RVRect& rect, const RVStyle& style)
+   {
+      m_stats.nPrimitives[RVDisplayList::CMD_FILL_RECT]++;
+      if ((rect.nRight > rect.nLeft) && (rect.nBottom > rect.nTop))
+      {
+         m_stats.nFilledPixels += (Uint32) ((rect.nRight - rect.nLeft) * (rect.nBottom - rect.nTop));
+      }
+      append("fill %u %d,%d,%d,%d\n", style.nId, rect.nLeft, rect.nTop, rect.nRight, rect.nBottom);
+   };
+
+   virtual void polyline(const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style, int nWidth)
+   {
+      m_stats.nPrimitives[RVDisplayList::CMD_POLYLINE]++;
+      m_stats.nPoints += nPoints;
+      append("polyline %u w%d", style.nId, nWidth);
+      appendPoints(pPoints, nPoints);
+   };
+
+   virtual void polygon(const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style)
+   {
+      m_stats.nPrimitives[RVDisplayList::CMD_POLYGON]++;
+      m_stats.nPoints += nPoints;
+      append("polygon %u", style.nId);
+      appendPoints(pPoints, nPoints);
+   };
+
+   virtual void dashedLines(int xStart, int xEnd, const RVPoint* pAnchors, Uint32 nLines, int nDash, int nGap, const RVStyle& style)
+   {
+      m_stats.nPrimitives[RVDisplayList::CMD_DASHED_LINES]++;
+      m_stats.nPoints += nLines;
+      append("dashed %u %d-%d %d/%d", style.nId, xStart, xEnd, nDash, nGap);
+      appendPoints(pAnchors, nLines);
+   };
+
+   virtual void sign(const RVRect& rect, const RVSignBlit& sign)
+   {
+      m_stats.nPrimitives[RVDisplayList::CMD_SIGN]++;
+      append("sign %d/%u/%d%s %d,%d,%d,%d\n", sign.nSign, sign.nParam, sign.nDistance, sign.bLength ? "L" : "",
+             rect.nLeft, rect.nTop, rect.nRight, rect.nBottom);
+   };
+
+   virtual void text(int x, int y, const char* szText, Uint32 nLength, const RVStyle& style)
+   {
+      m_stats.nPrimitives[RVDisplayList::CMD_TEXT]++;
+      append("text %u %d,%d ", style.nId, x, y);
+      m_szRecord.append(szText, nLength);
+      m_szRecord.append("\n");
+   };
+
+
+private: // Worker methods
+
+   void append(const char* szFormat, ...)
+   {
+      char szLine[128];
+      va_list args;
+      va_start(args, szFormat);
+      vsnprintf(szLine, sizeof(szLine), szFormat, args);
+      va_end(args);
+      m_szRecord.append(szLine);
+   };
+
+   void appendPoints(const RVPoint* pPoints, Uint32 nPoints)
+   {
+      for (Uint32 i = 0; i < nPoints; i++)
+      {
+         append(" %d,%d", pPoints[i].x, pPoints[i].y);
+      }
+      m_szRecord.append("\n");
+   };
+
+
+private: // Data Members
+
+   std::string    m_szRecord;
+   Stats          m_stats;
+};
+
+
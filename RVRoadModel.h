@@ -0,0 +1,78 @@
+/**
+ * @file    RVRoadModel.h
+ * @brief   Snapshot of everything the Road View paints: Signs, Areas and the root link infos.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The model is built from the Horizon by RVRoadModelBuilder and handed over to the painting through RVModelBuffer.
+ * It only uses standard containers, so that it can be built and checked without a window.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <string.h>
+#include "RVAreas.h"
+#include "RVSign.h"
+
+/** Counters of the update paths taken by the builder and of the rebuilds scheduled */
+struct RVUpdateStats
+{
+   Uint32   nFullRebuilds;
+   Uint32   nIncrementalUpdates;
+   Uint32   nClassifiedAttrs;
+   Uint32   nReusedAttrs;
+   Uint32   nLinkCacheHits;
+   Uint32   nLinkCacheMisses;
+   Uint32   nMessages;              // AH messages received
+   Uint32   nRebuilds;              // Rebuilds run for them
+   Uint32   nCoalescedMessages;     // Messages merged into a later rebuild
+   Uint32   nRepaints;              // Repaints posted for the published models (rebuilds and root link changes)
+   Uint32   nAttributes;            // Attributes of the Horizon read by the last scan (not a counter)
+};
+
+
+struct RVRoadModel
+{
+   RVRoadModel()
+   {
+      nStartNbOfLanes      = 1;
+      nMaxLanes            = 1;
+      bIsStartInTunnel     = false;
+      bIsStartInRoundabout = false;
+      bIsInCity            = false;
+      nSpeedOnRootLink     = 0;
+      bIsCurrentSpeed      = false;
+      nGeneration          = 0;
+      nTravelCM            = 0;
+      nTravelEpoch         = 0;
+      memset(&stats, 0, sizeof(stats));
+   };
+
+   /** Crossings and Lane number changes along the MPP, sorted by distance */
+   std::vector<RVSign>  signs;
+   /** Areas for Tunnels and Roundabouts */
+   std::vector<RVAreas> areas;
+   /** Areas for Traffic Signs (the Tunnel and Roundabout areas are appended) */
+   std::vector<RVAreas> tsAreas;
+
+   // Root link infos
+   int                  nStartNbOfLanes;
+   int                  nMaxLanes;
+   bool                 bIsStartInTunnel;
+   bool                 bIsStartInRoundabout;
+   bool                 bIsInCity;
+   int                  nSpeedOnRootLink;
+   bool                 bIsCurrentSpeed;
+
+   /** Incremented by the builder for each published model */
+   Uint32               nGeneration;
+   /** Distance driven along the MPP. It is only comparable between two models of the same epoch: the epoch is
+       incremented when the MPP does not continue the previous one (the car position is not known relative to it). */
+   Sint32               nTravelCM;
+   Uint32               nTravelEpoch;
+   RVUpdateStats        stats;
+};
+
+
@@ -0,0 +1,816 @@
+/**
+ * @file    RVRoadModelBuilder.cpp
+ * @brief   Builds the road model (Signs, Areas, root link infos) from the Horizon.
+ * @version 0.1
+ * @date    16.10.2026.
+ */
+
+#include "RVTypes.h"
+#include "RVRoadModelBuilder.h"
+
+#include <algorithm>
+#include <limits.h>
+
+static float   m_fCrossingWidthFactorSame    = 1;     // Width factor for each possible crossing road size
+static float   m_fCrossingWidthFactorSmall   = 0.5;
+static float   m_fCrossingWidthFactorBig     = 1.5;
+
+// Parameter shown with a Traffic Sign
+enum SignParam {
+   PARAM_NONE,             // No parameter
+   PARAM_NUMBER,           // Number coded in the attribute info (speed, slope)
+   PARAM_LANES,            // Lanes (with the opposing lanes * 64)
+   PARAM_LANES_INC,        // Lanes + 1
+   PARAM_LANES_DEC,        // Lanes - 1, at least 1
+   PARAM_LANES_CENTER      // Lanes - 1 (with the opposing lanes * 64)
+};
+
+static const int NO_TYPE = -1;
+
+// Traffic Sign classification: one rule per attribute type. The sign at the end of the attribute only differs from the
+// sign at the start for the prohibitions and limits. Adding a Traffic Sign is adding a rule here.
+struct RVSignRule
+{
+   int                  nType;            // Attribute type
+   TrafficSign::Sign    signStart;        // Sign at the start of the attribute
+   TrafficSign::Sign    signEnd;          // Sign at the end of the attribute
+   SignParam            nParam;
+   bool                 bValidity;        // Shows the validity (distance or duration) of the attribute
+   bool                 bRealSign;
+   int                  nAlsoType;        // Rule also applied for this attribute (a Crosswalk also gives a Traffic Light)
+};
+
+static const RVSignRule SIGN_RULES[] = {
+   { ADAS::ahatTSPedestrianXing,          TrafficSign::tsPedestrian,              TrafficSign::tsPedestrian,              PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSPedestrianCrosswalk,     TrafficSign::tsPedestrianCrossing,      TrafficSign::tsPedestrianCrossing,      PARAM_NONE,         true,  true,  ADAS::ahatTSTrafficLight },
+   { ADAS::ahatTSTrafficLight,            TrafficSign::tsTrafficLight,            TrafficSign::tsTrafficLight,            PARAM_NONE,         false, false, NO_TYPE },
+   { ADAS::ahatTSTrafficLightSign,        TrafficSign::tsTrafficLight,            TrafficSign::tsTrafficLight,            PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRightofWayRoad,          TrafficSign::tsRightOfWay,              TrafficSign::tsRightOfWay,              PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRightOfWayCrossing,      TrafficSign::tsPriorityCrossing,        TrafficSign::tsPriorityCrossing,        PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSEndOfTown,               TrafficSign::tsUrbanAreaEnd,            TrafficSign::tsUrbanAreaEnd,            PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSEqualIntersection,       TrafficSign::tsCrossing,                TrafficSign::tsCrossing,                PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSYield,                   TrafficSign::tsGiveWay,                 TrafficSign::tsGiveWay,                 PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSStop,                    TrafficSign::tsStop,                    TrafficSign::tsStop,                    PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSWarning,                 TrafficSign::tsWarning,                 TrafficSign::tsWarning,                 PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSSharpCurveLeft,          TrafficSign::tsLeftTurn,                TrafficSign::tsLeftTurn,                PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSSharpCurveRight,         TrafficSign::tsRightTurn,               TrafficSign::tsRightTurn,               PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSSCurveLeft,              TrafficSign::tsSCurveLeft,              TrafficSign::tsSCurveLeft,              PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSSCurveRight,             TrafficSign::tsSCurveRight,             TrafficSign::tsSCurveRight,             PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSUnevenRoad,              TrafficSign::tsUnevenRoad,              TrafficSign::tsUnevenRoad,              PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSIcyRoad,                 TrafficSign::tsIcyRoad,                 TrafficSign::tsIcyRoad,                 PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSSlipperyRoad,            TrafficSign::tsSlipperyRoad,            TrafficSign::tsSlipperyRoad,            PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSFallingRocks,            TrafficSign::tsFallingRocks,            TrafficSign::tsFallingRocks,            PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRoadNarrowingLeft,       TrafficSign::tsRoadNarrowingLeft,       TrafficSign::tsRoadNarrowingLeft,       PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRoadNarrowingRight,      TrafficSign::tsRoadNarrowingRight,      TrafficSign::tsRoadNarrowingRight,      PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRoadNarrowingBothSides,  TrafficSign::tsRoadNarrowingBothSides,  TrafficSign::tsRoadNarrowingBothSides,  PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSTrafficCongestion,       TrafficSign::tsTrafficCongestion,       TrafficSign::tsTrafficCongestion,       PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSAnimals,                 TrafficSign::tsAnimals,                 TrafficSign::tsAnimals,                 PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSChildren,                TrafficSign::tsChildren,                TrafficSign::tsChildren,                PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSOvertakeCC,              TrafficSign::tsOvertakeAllowed,         TrafficSign::tsOvertakeProhibited,      PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSOvertakeTC,              TrafficSign::tsOvertakeTCAllowed,       TrafficSign::tsOvertakeTCProhibited,    PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSEndOfAllProhibitions,    TrafficSign::tsEndOfAllProhibitions,    TrafficSign::tsEndOfAllProhibitions,    PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSEndPriorityRoad,         TrafficSign::tsEndPriorityRoad,         TrafficSign::tsEndPriorityRoad,         PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRailwayCrossingGates,    TrafficSign::tsRailwayCrossingGates,    TrafficSign::tsRailwayCrossingGates,    PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRailwayCrossingNoGates,  TrafficSign::tsRailwayCrossingNoGates,  TrafficSign::tsRailwayCrossingNoGates,  PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSTramway,                 TrafficSign::tsTramway,                 TrafficSign::tsTramway,                 PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRailwayCrossing,         TrafficSign::tsRailwayCrossing,         TrafficSign::tsRailwayCrossing,         PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSCompulsoryRoundabout,    TrafficSign::tsCompulsoryRoundabout,    TrafficSign::tsCompulsoryRoundabout,    PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSCrossWind,               TrafficSign::tsCrossWind,               TrafficSign::tsCrossWind,               PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSAccidentHazard,          TrafficSign::tsAccidentHazard,          TrafficSign::tsAccidentHazard,          PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSRiskOfGrounding,         TrafficSign::tsRiskOfGrounding,         TrafficSign::tsRiskOfGrounding,         PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSPriorityOncomingTraffic, TrafficSign::tsPriorityOncomingTraffic, TrafficSign::tsPriorityOncomingTraffic, PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSYieldOncomingTraffic,    TrafficSign::tsYieldOncomingTraffic,    TrafficSign::tsYieldOncomingTraffic,    PARAM_NONE,         true,  true,  NO_TYPE },
+   { ADAS::ahatTSSteepUphill,             TrafficSign::tsSlope,                   TrafficSign::tsSlope,                   PARAM_NUMBER,       true,  true,  NO_TYPE },
+   { ADAS::ahatTSSteepDownhill,           TrafficSign::tsSlopeNeg,                TrafficSign::tsSlopeNeg,                PARAM_NUMBER,       true,  true,  NO_TYPE },
+   { ADAS::ahatTSSpeedLimit,              TrafficSign::tsSpeedLimit,              TrafficSign::tsSpeedLimitEnd,           PARAM_NUMBER,       true,  true,  NO_TYPE },
+   { ADAS::ahatTSSignLanes,               TrafficSign::tsLanes,                   TrafficSign::tsLanes,                   PARAM_LANES,        true,  true,  NO_TYPE },
+   { ADAS::ahatTSSignExtraLaneLeft,       TrafficSign::tsLanesInc,                TrafficSign::tsLanesInc,                PARAM_LANES_INC,    true,  true,  NO_TYPE },
+   { ADAS::ahatTSSignExtraLaneRight,      TrafficSign::tsLanesIncRight,           TrafficSign::tsLanesIncRight,           PARAM_LANES_INC,    true,  true,  NO_TYPE },
+   { ADAS::ahatTSSignLaneMergeLeft,       TrafficSign::tsLanesDec,                TrafficSign::tsLanesDec,                PARAM_LANES_DEC,    true,  true,  NO_TYPE },
+   { ADAS::ahatTSSignLaneMergeRight,      TrafficSign::tsLanesDecRight,           TrafficSign::tsLanesDecRight,           PARAM_LANES_DEC,    true,  true,  NO_TYPE },
+   { ADAS::ahatTSSignLaneMergeCenter,     TrafficSign::tsLanesDecCenter,          TrafficSign::tsLanesDecCenter,          PARAM_LANES_CENTER, true,  true,  NO_TYPE },
+   { ADAS::ahatCustom3,                   TrafficSign::tsFree,                    TrafficSign::tsFree,                    PARAM_NONE,         true,  false, NO_TYPE },
+};
+
+// Builds the index in SIGN_RULES by attribute type, -1 for no rule
+static std::vector<short> buildSignRuleIndex()
+{
+   int nMaxType = 0;
+   for (size_t i = 0;  i < sizeof(SIGN_RULES) / sizeof(SIGN_RULES[0]);  i++)
+   {
+      nMaxType = (std::max)(nMaxType, SIGN_RULES[i].nType);
+   }
+   std::vector<short> index(nMaxType + 1, -1);
+   for (size_t i = 0;  i < sizeof(SIGN_RULES) / sizeof(SIGN_RULES[0]);  i++)
+   {
+      index[SIGN_RULES[i].nType] = (short) i;
+   }
+   return index;
+};
+
+// Index of the Traffic Sign rules, built on first use and shared by all the builders
+static const std::vector<short>& getSignRuleIndex()
+{
+   static const std::vector<short> index = buildSignRuleIndex();
+   return index;
+};
+
+// Computes the lanes parameter of a sign from the number of lanes on the link (see getLanes())
+static int getLanesParam(int nLanes, SignParam nParam)
+{
+   switch (nParam)
+   {
+      case PARAM_LANES:
+         return (1 == (nLanes & 0x3f)) ? (2 + (nLanes & ~0x3f)) : nLanes - 1;
+      case PARAM_LANES_INC:
+         return (nLanes & 0x3f) + 1;
+      case PARAM_LANES_DEC:
+         return (1 == (nLanes & 0x3f)) ? 1 : (nLanes & 0x3f) - 1;
+      case PARAM_LANES_CENTER:
+         return nLanes - 1;
+      default:
+         return 0;
+   }
+};
+
+
+/////////////////////////
+// Constructor/Destructor
+
+RVRoadModelBuilder::RVRoadModelBuilder()
+{
+   m_bDrivingSideKnown = false;
+   m_nDrivingSideLinkId = 0;
+   m_pStageStats = NULL;
+   m_bRightSideDrive = true;
+   m_nCarOffsetCM = 0;
+};
+
+
+///////////
+// Building
+
+// Sets the root link infos, which are kept until the next root link change
+void RVRoadModelBuilder::setRootLink(RVHorizonSource& source, Uint32 nLinkId)
+{
+   m_model.bIsInCity = source.isInCity(nLinkId);
+   m_model.nSpeedOnRootLink = getSpeedOnLink(source, nLinkId); // This part modified by sdrehe 05/2005 to account for ADAS Speed Limits
+};
+
+// Copies the current model to the back buffer and publishes it. The copy keeps the capacity of the back buffer.
+// The vectors of the back buffer first get the capacity of the model: the copy assignment only allocates the
+// exact size, and would allocate again each time the model gets a little larger than ever before.
+void RVRoadModelBuilder::publish(RVModelBuffer& buffer)
+{
+   m_model.nGeneration++;
+   m_model.stats.nLinkCacheHits = m_linkCache.getHits();
+   m_model.stats.nLinkCacheMisses = m_linkCache.getMisses();
+   RVRoadModel& back = buffer.getBackBuffer();
+   back.signs.reserve(m_model.signs.capacity());
+   back.areas.reserve(m_model.areas.capacity());
+   back.tsAreas.reserve(m_model.tsAreas.capacity());
+   back = m_model;
+   buffer.publish();
+};
+
+/////////////////
+// Worker methods
+
+// Returns the rule for an attribute type, NULL if the attribute type gives no Traffic Sign (or for NO_TYPE)
+const RVSignRule* RVRoadModelBuilder::findSignRule(int nType) const
+{
+   const std::vector<short>& index = getSignRuleIndex();
+   if ((nType < 0) || (nType >= (int) index.size()) || (index[nType] < 0))
+   {
+      return NULL;
+   }
+   return &SIGN_RULES[index[nType]];
+};
+
+void RVRoadModelBuilder::getMostProbablePath(RVHorizonSource& source)
+{
+   m_previousMpp.swap(m_mpp);
+   m_previousLinkStartCM.resize(m_previousMpp.size());
+   for (int nPosition = 0;  nPosition < (int) m_previousMpp.size();  nPosition++)
+   {
+      m_previousLinkStartCM[nPosition] = m_mppIndex.getLinkStartCM(nPosition);
+   }
+   m_mpp.clear();
+   source.getMostProbablePath(m_mpp);
+   m_mppIndex.build(m_mpp);
+
+   // Link offset table: start of each MPP link from the start of the root link
+   for (int nPosition = 0;  nPosition < (int) m_mpp.size();  nPosition++)
+   {
+      m_mppIndex.setLinkLengthCM(nPosition, source.getLinkLengthCM(m_mpp[nPosition]));
+   }
+};
+
+// Sorts the attributes by increasing distance, keeping the order of the attributes at the same distance.
+// The attributes are nearly sorted already (see scanHorizon()): an insertion sort is linear then and needs no buffer.
+void RVRoadModelBuilder::sortByDistance(std::vector<PathAttribute>& attrs)
+{
+   for (size_t i = 1;  i < attrs.size();  i++)
+   {
+      if (attrs[i].nDistCM < attrs[i-1].nDistCM)
+      {
+         PathAttribute attr = attrs[i];
+         size_t j = i;
+         while ((j > 0) && (attr.nDistCM < attrs[j-1].nDistCM))
+         {
+            attrs[j] = attrs[j-1];
+            j--;
+         }
+         attrs[j] = attr;
+      }
+   }
+};
+
+// Checks if the MPP continues the previous one: the car may have moved on by some links and links may have been
+// added at the end of the Horizon, but the links common to both MPPs are the same.
+bool RVRoadModelBuilder::isMppContinuation()
+{
+   if (m_mpp.empty() || m_previousMpp.empty())
+   {
+      return false;
+   }
+   std::vector<Uint32>::iterator itRoot = std::find(m_previousMpp.begin(), m_previousMpp.end(), m_mpp[0]);
+   if (itRoot == m_previousMpp.end())
+   {
+      return false;
+   }
+   for (size_t i = 0;  (i < m_mpp.size()) && (itRoot != m_previousMpp.end());  i++, ++itRoot)
+   {
+      if (m_mpp[i] != *itRoot)
+      {
+         return false;
+      }
+   }
+   return true;
+};
+
+// Single pass over the Horizon attributes: each attribute is fetched once and dispatched to the root link detection
+// and the Traffic Sign collector. The attributes ahead on the MPP are kept for the Lane/Crossing/Area state machine
+// of getPathInfos(), which needs the root link infos (nb of lanes, tunnel, roundabout) before it can start.
+void RVRoadModelBuilder::scanHorizon(RVHorizonSource& source, bool bFullRebuild)
+{
+   RVStageTimer timer(m_pStageStats, RVStageStats::STAGE_SCAN_HORIZON);
+   getMostProbablePath(source);
+
+   // A full rebuild is only needed if the MPP topology has changed, otherwise the classification of the attributes
+   // which are still on the Horizon is reused and only the new attributes are classified.
+   bool bContinued = !bFullRebuild && isMppContinuation();
+   if (!bContinued)
+   {
+      m_tsCache.clear();
+      m_crossingCache.clear();
+      m_bDrivingSideKnown = false;
+      m_model.stats.nFullRebuilds++;
+   }
+   else
+   {
+      m_model.stats.nIncrementalUpdates++;
+   }
+   m_tsCache.beginUpdate();
+   m_crossingCache.beginUpdate();
+   m_linkCache.invalidate();        // The link summaries are read again from the new Horizon
+
+   m_model.tsAreas.clear();
+   m_pathAttrs.clear();
+   m_model.bIsStartInTunnel = false;
+   m_model.bIsStartInRoundabout = false;
+   bool bFoundStartNbOfLanes = false;
+   int nAnchorPosition = INT_MAX;
+   Sint32 nCarOffsetCM = 0;
+
+   Uint32 n = source.getAttributeCount();         // the number of Attribute points on the Horizon
+   timer.addItems(n);
+   m_model.stats.nAttributes = n;
+   for (Uint32 i = 0;  i < n;  i++)
+   {
+      PathAttribute attr;
+      Float64       fProbability;     // to store the Probability of the current point on the Horizon
+
+      // get info for the n'th nearest point on Horizon
+      attr.nDistCM = source.getNearestAttribute(i, &fProbability, &attr.ahat);
+
+      if (!isIdOnMPP(attr.ahat.nLinkId))
+      {
+         continue;
+      }
+
+      // ROOT LINK: The information about the root link is stored in the attributes of the start node which is behind us.
+      // Therefore, we look in the negative distance values for the Nb of Lanes, Tunnel and Roundabout attributes.
+      // The nearest Nb of Lanes attribute wins. As before, the first attribute of the Horizon is not considered here.
+      if ((attr.nDistCM < 0) && (fProbability != 0) && (i > 0))
+      {
+         switch(attr.ahat.type)
+         {
+            case ADAS::ahatNumberOfLanesFromSC:    // Set the start number of Lanes
+               if (!bFoundStartNbOfLanes)
+               {
+                  m_model.nStartNbOfLanes = attr.ahat.info & 0xFFFFL;
+                  bFoundStartNbOfLanes = true;
+               }
+               break;
+            case ADAS::ahatTunnel:           // detect if we are in a Tunnel
+               m_model.bIsStartInTunnel = true;
+               break;
+            case ADAS::ahatRoundabout:       // detect if we are on a Roundabout
+               m_model.bIsStartInRoundabout = true;
+               break;
+         }
+      }
+
+      // The car position on the root link anchors the along-MPP distances. It is taken from the attribute nearest
+      // to the root link, where the shortest distance returned by getNearest() is the distance along the MPP.
+      int nPosition = m_mppIndex.getPosition(attr.ahat.nLinkId);
+      if (nPosition < nAnchorPosition)
+      {
+         nAnchorPosition = nPosition;
+         nCarOffsetCM = m_mppIndex.getPathDistanceCM(nPosition, attr.ahat.nOffsetCM) - attr.nDistCM;
+      }
+      m_pathAttrs.push_back(attr);
+   }
+
+   // TRAVEL: The car moved on its root link, plus the length of the links it has left since the previous MPP
+   if (bContinued && (nAnchorPosition != INT_MAX))
+   {
+      size_t nRoot = std::find(m_previousMpp.begin(), m_previousMpp.end(), m_mpp[0]) - m_previousMpp.begin();
+      m_model.nTravelCM += m_previousLinkStartCM[nRoot] + nCarOffsetCM - m_nCarOffsetCM;
+   }
+   else
+   {
+      m_model.nTravelEpoch++;
+   }
+   m_nCarOffsetCM = nCarOffsetCM;
+
+   // AHEAD: The distances are replaced by the distances along the MPP (one lookup in the link offset table per attribute).
+   // Traffic Signs are added at once (classified only if new on the Horizon), the rest is kept for getPathInfos().
+   size_t nAhead = 0;
+   {
+      RVStageTimer timerAreas(m_pStageStats, RVStageStats::STAGE_TS_AREAS);
+      timerAreas.addItems((Uint32) m_pathAttrs.size());
+      for (size_t i = 0;  i < m_pathAttrs.size();  i++)
+      {
+         PathAttribute& attr = m_pathAttrs[i];
+         attr.nDistCM = m_mppIndex.getPathDistanceCM(m_mppIndex.getPosition(attr.ahat.nLinkId), attr.ahat.nOffsetCM) - nCarOffsetCM;
+         Sint32 nDist = attr.nDistCM / 100;
+         if (nDist > 0)
+         {
+            addTSAreas(source, attr.ahat, nDist);
+            m_pathAttrs[nAhead++] = attr;
+         }
+      }
+   }
+   m_pathAttrs.resize(nAhead);
+
+   // getPathInfos() groups the attributes by distance: restore the order if the MPP distances differ from the shortest ones
+   sortByDistance(m_pathAttrs);
+
+   int nTSCount = (int) m_model.tsAreas.size();
+
+   getPathInfos(source);
+
+   // The Traffic Sign areas get the max nb of lanes found by getPathInfos()
+   for (int nAreaIdx = 0;  nAreaIdx < nTSCount;  nAreaIdx++)
+   {
+      m_model.tsAreas[nAreaIdx].setWidth(m_model.nMaxLanes);
+   }
+   sortTSAreas();
+
+   m_tsCache.endUpdate();
+   m_crossingCache.endUpdate();
+};
+
+void RVRoadModelBuilder::getPathInfos(RVHorizonSource& source)
+{
+   RVStageTimer timer(m_pStageStats, RVStageStats::STAGE_PATH_INFOS);
+   timer.addItems((Uint32) m_pathAttrs.size());
+   // The attributes on the MPP have been collected by scanHorizon()
+	bool	bRightSideDrive = true;
+	if (m_mpp.size() > 0)
+	{
+		if (!m_bDrivingSideKnown || (m_nDrivingSideLinkId != m_mpp.at(0)))
+		{
+			m_bDrivingSideKnown = true;
+			m_nDrivingSideLinkId = m_mpp.at(0);
+			m_bRightSideDrive = source.isRightSideDrive(m_nDrivingSideLinkId);
+		}
+		bRightSideDrive = m_bRightSideDrive;
+	}
+   
+   m_model.signs.clear();              // Clear the Signs and Areas vectors
+   m_model.areas.clear();
+   
+   // RVSign parameters
+   struct TrafficSignView::Hint hintLanes;
+   struct TrafficSignView::Hint hintCrossing;
+   hintLanes.sign                             = TrafficSign::tsInvalid;
+   hintLanes.param                            = 0;
+   hintCrossing.sign                          = TrafficSign::tsInvalid;
+   hintCrossing.param                         = 0;
+   float fSizeOfCrossing                      = 0.0;
+   RVSign::CrossingSideType nCrossingSide     = RVSign::CROSSING_UNKNOWN;
+   RVSign::ProhibitedSideType nProhibitedSide = RVSign::PROHIBITED_NONE;
+   Uint32 nLinkId                             = 0;
+   Sint32 nLinkLength                         = 0;
+
+   // RVArea parameters
+   struct TrafficSignView::Hint hintAreas;
+   hintAreas.sign       = TrafficSign::tsInvalid;
+   hintAreas.param      = 0;
+
+   unsigned int nMaxLanes = 0;
+   Sint32 nAreaStart = 0;
+   Sint32 nAreaEnd = 0;
+   bool bIsStartInArea = false;
+   bool bFoundAreaContinuation = false;
+
+   unsigned int nPreviousNbOfLanes = m_model.nStartNbOfLanes;
+   unsigned int nLastFoundNbOfLanes = m_model.nStartNbOfLanes;
+
+   Sint32 nPreviousDist    = 0;           // Float64 = 0.0
+
+   for (size_t i = 0;  i < m_pathAttrs.size();  i++)    // loop over the Attribute points on the MPP, ahead of the car
+   {
+      ADAS::HorizonAttribute& ahat = m_pathAttrs[i].ahat;
+      Sint32   nDist = m_pathAttrs[i].nDistCM / 100;    // Distance along the MPP (see scanHorizon())
+
+      // We group all the found attributes by distance. So, if there are no more infos for the current nDist,
+      // we can add the infos to the RVAreas and RVSign vectors now.
+      if ((nDist != nPreviousDist) && (nPreviousDist != 0.0))
+      {
+         if (bFoundAreaContinuation)   // If the Tunnel/Roundabout area just continues here, then do nothing
+         {
+            bFoundAreaContinuation = false;
+         }
+         else  // If we found no Tunnel/Roundabout continuation, this means that the Tunnel/Roundabout end is on the previous link
+         {
+            // Check if we have Area infos to add
+            if ((bIsStartInArea && (nAreaStart == 0)) || (nAreaStart != 0))
+            {
+               nAreaEnd = nPreviousDist;
+               m_model.areas.push_back(RVAreas(hintAreas.sign, nAreaStart, nAreaEnd, nMaxLanes));
+               // reset Area parameters
+               nAreaStart = 0;
+               nAreaEnd = 0;
+               nMaxLanes = 0;
+               bIsStartInArea = false;  // to avoid writing the starting Tunnel again
+            }
+         }
+         // Check if we have Lane or Crossing infos to add
+         if (((hintLanes.sign != TrafficSign::tsInvalid) || (hintCrossing.sign != TrafficSign::tsInvalid)))
+         {  
+            // There has to be a number of lanes defined at each crossing! If it is not the case, set it to the last found one.
+            if (hintLanes.param == 0)
+            {
+               hintLanes.param = nLastFoundNbOfLanes;
+            }
+            // Now add the attributes to the Sign array              
+            m_model.signs.push_back(RVSign(hintLanes.sign, hintLanes.param, hintCrossing.sign, fSizeOfCrossing, nPreviousDist, nCrossingSide, nProhibitedSide, nLinkId));
+            if (TrafficSign::tsInvalid != hintLanes.sign) {
+               m_model.tsAreas.push_back(RVAreas(hintLanes.sign, nPreviousDist, nPreviousDist, 0, hintLanes.param));
+            }
+
+            nLastFoundNbOfLanes = hintLanes.param;
+
+            // reset Signs infos
+            hintLanes.sign      = TrafficSign::tsInvalid;
+            hintLanes.param     = 0;
+            hintCrossing.sign   = TrafficSign::tsInvalid;
+            fSizeOfCrossing     = 0.0;
+            nCrossingSide       = RVSign::CROSSING_UNKNOWN;
+            nProhibitedSide     = RVSign::PROHIBITED_NONE;
+         }           
+      }  // End of grouping by distance part
+
+      switch (ahat.type)      // Check kind of attributes we get, look for interesting attributes
+      {
+         case ADAS::ahatNumberOfLanesFromSC:
+            {
+               unsigned int nNew = ahat.info & 0xFFFFL;
+               //unsigned int nOld = (ahat.info & 0x7FFF0000) >> 16;
+						hintLanes.sign = nNew == nPreviousNbOfLanes ? TrafficSign::tsInvalid : // Do not draw lanes sign if lanes nb is identical
+												nNew > nPreviousNbOfLanes ? (bRightSideDrive ? TrafficSign::tsLanesInc : TrafficSign::tsLanesIncRight)
+												: (bRightSideDrive ? TrafficSign::tsLanesDec : TrafficSign::tsLanesDecRight);
+               hintLanes.param = nNew;
+               
+               nPreviousNbOfLanes = nNew;
+
+               if (nNew > nMaxLanes)
+               {
+                  nMaxLanes = nNew;
+                  m_model.nMaxLanes = nMaxLanes;
+               }
+
+               nLinkId = ahat.nLinkId;
+               nLinkLength = ahat.nLengthCM / 100;
+
+               break;
+            };
+         case ADAS::ahatCrossingSame:
+            hintCrossing.sign = TrafficSign::tsCrossing;
+            fSizeOfCrossing = m_fCrossingWidthFactorSame;
+            nCrossingSide = getCrossingSide(source, ahat.nLinkId, &nProhibitedSide); //  nNextLinkId
+            nLinkId = ahat.nLinkId;
+            break;
+
+         case ADAS::ahatCrossingSmall:
+            hintCrossing.sign = TrafficSign::tsPriorityCrossing;
+            fSizeOfCrossing = m_fCrossingWidthFactorSmall;
+            nCrossingSide = getCrossingSide(source, ahat.nLinkId, &nProhibitedSide);
+            nLinkId = ahat.nLinkId;
+            break;
+
+         case ADAS::ahatCrossingBig:
+            hintCrossing.sign = TrafficSign::tsGiveWay;
+            fSizeOfCrossing = m_fCrossingWidthFactorBig;
+            nCrossingSide = getCrossingSide(source, ahat.nLinkId, &nProhibitedSide);
+            nLinkId = ahat.nLinkId;
+            break;
+
+         case ADAS::ahatTunnel:           // Here we define the area limits
+         case ADAS::ahatRoundabout:
+            hintAreas.sign = ahat.type == ADAS::ahatTunnel ? TrafficSign::tsTunnel : TrafficSign::tsRoundabout;
+            bIsStartInArea = ahat.type == ADAS::ahatTunnel ? m_model.bIsStartInTunnel : m_model.bIsStartInRoundabout;
+            if (nAreaStart == 0.0)
+            {
+               if (!bIsStartInArea)
+               {
+                  nAreaStart = nDist;
+               }
+            }
+            bFoundAreaContinuation = true;
+            break;
+
+      } // end of switch
+
+      nPreviousDist = nDist;
+
+   } // end of loop on MPP attributes
+
+   // SIGNS: If we found a Crossing or lane change at the end, add it here
+   if (((hintLanes.sign != TrafficSign::tsInvalid) || (hintCrossing.sign != TrafficSign::tsInvalid)))
+   {  
+      // There has to be a number of lanes defined at each crossing! If it is not the case, set it to the last found one.
+      if (hintLanes.param == 0)
+      {
+         hintLanes.param = nLastFoundNbOfLanes;
+      }
+      // Now add the attributes to the Sign array              
+      m_model.signs.push_back(RVSign(hintLanes.sign, hintLanes.param, hintCrossing.sign, fSizeOfCrossing, nPreviousDist, nCrossingSide, nProhibitedSide, nLinkId));
+      if (TrafficSign::tsInvalid != hintLanes.sign) {
+         m_model.tsAreas.push_back(RVAreas(hintLanes.sign, nPreviousDist, nPreviousDist, 0, hintLanes.param));
+      }
+   } else {
+      // fix 2006/04/03: Create a last entry until the end of the last segment to complete the Horizon to be drawn
+      m_model.signs.push_back(RVSign(TrafficSign::tsInvalid, hintLanes.param, TrafficSign::tsInvalid, 0.0, nPreviousDist + nLinkLength, nCrossingSide, nProhibitedSide, nLinkId));
+   }
+   // AREAS: If we didn't reach the End of the Area, then add the area info to the Area array
+   if (((nAreaStart != 0) || (bIsStartInArea && bFoundAreaContinuation && (nAreaStart == 0)) ) && (nAreaEnd == 0.0))
+   {
+      m_model.areas.push_back(RVAreas(hintAreas.sign, nAreaStart, nAreaEnd, nMaxLanes));
+   }
+
+   std::sort(m_model.signs.begin(), m_model.signs.end(), RVSign::compareByDistance);
+   std::sort(m_model.areas.begin(), m_model.areas.end());
+
+   m_model.tsAreas.insert(m_model.tsAreas.end(), m_model.areas.begin(), m_model.areas.end());
+};
+
+int RVRoadModelBuilder::getLanes(RVHorizonSource& source, ADAS::HorizonAttribute &ahat)
+{
+   // FIXME: If ahat is at end of link, check number of lanes at next link!
+   const RVLinkSummary& link = getLinkSummary(source, ahat.nLinkId);
+   if (1 != link.nLanesCount) {
+      return 1;   // For lack of better knowledge.
+   }
+   int nLanes = link.nLanes;
+   if (1 == link.nOneWayCount) {
+      // One way road - maybe motorway carriageway ot something similar.
+      // In any case, we don't consider the opposing lanes.
+      return nLanes;
+   }
+   if (1 == link.nOppositeLanesCount) {
+      nLanes += 64 * link.nOppositeLanes;   // Traffic sign coding.
+   }
+   return nLanes;
+}
+
+// Returns the summary of the attributes of a link, read from the Horizon on first access only
+const RVLinkSummary& RVRoadModelBuilder::getLinkSummary(RVHorizonSource& source, Uint32 nLinkId)
+{
+   const RVLinkSummary* pSummary = m_linkCache.find(nLinkId);
+   if (pSummary != NULL)
+   {
+      return *pSummary;
+   }
+
+   RVLinkSummary& summary = m_linkCache.insert(nLinkId);
+   m_linkAttrs.clear();
+   source.getLinkAttributes(nLinkId, m_linkAttrs);
+   for (size_t i = 0;  i < m_linkAttrs.size();  i++)
+   {
+      switch(m_linkAttrs[i].type)
+      {
+         case ADAS::ahatADASNumberOfLanes:
+            summary.nLanesCount++;
+            summary.nLanes = m_linkAttrs[i].info;
+            break;
+         case ADAS::ahatADASOppositeNumberOfLanes:
+            summary.nOppositeLanesCount++;
+            summary.nOppositeLanes = m_linkAttrs[i].info;
+            break;
+         case ADAS::ahatRightWay:
+            summary.nOneWayCount++;
+            break;
+         case ADAS::ahatCurrentSpeed:
+            summary.nCurrentSpeed = m_linkAttrs[i].info;
+            break;
+         case ADAS::ahatExpectedSpeedFromSC:
+            summary.nExpectedSpeed = m_linkAttrs[i].info;
+            break;
+      }
+   }
+   return summary;
+}
+
+// Adds the Traffic Sign areas of an attribute found on the MPP at the given distance (in m)
+void RVRoadModelBuilder::addTSAreas(RVHorizonSource& source, ADAS::HorizonAttribute& ahat, Sint32 nDist)
+{
+   RVAttributeKey key = { ahat.nLinkId, ahat.type, ahat.info, ahat.nLengthCM, ahat.bIsStart };
+   TSClass* pClass = m_tsCache.find(key);
+   if (pClass == NULL)
+   {
+      pClass = &m_tsCache.insert(key);
+      classifyTSArea(source, ahat, *pClass);
+      m_model.stats.nClassifiedAttrs++;
+   }
+   else
+   {
+      m_model.stats.nReusedAttrs++;
+   }
+   // Re-base the classified areas on the current distance of the attribute
+   for (int nAreaIdx = 0;  nAreaIdx < pClass->nCount;  nAreaIdx++)
+   {
+      const RVAreas& area = pClass->areas[nAreaIdx];
+      m_model.tsAreas.push_back(RVAreas(area.getSign(), nDist + area.getStart(), nDist + area.getEnd(), m_model.nMaxLanes, area.getNumber(),
+                            area.getDistanceOrDuration(), area.isDuration(), area.isRealSign()));
+   }
+};
+
+// Classifies one Traffic Sign attribute found on the MPP. The areas are given relative to the attribute position
+// so that the result can be reused while the attribute stays on the Horizon.
+void RVRoadModelBuilder::classifyTSArea(RVHorizonSource& source, ADAS::HorizonAttribute& ahat, TSClass& tsClass)
+{
+   // Extract the Traffic Sign Information coded in the Attribute info with the TrafficSignInfo enum
+   union ADAS::TrafficSignInfo tsi;
+   tsi.unit = ahat.info;
+
+   int nAreaStart = 0;
+   int nAreaEnd = nAreaStart;
+   int nDistanceOrDuration = 0;
+   bool bDuration = false;
+
+   if (tsi.bits.m_validityFlag == ADAS::TrafficSignValidityFlag::tsValidityStart)
+   {
+      //nAreaStart += ahat.nLengthCM / 100;
+      nDistanceOrDuration = ahat.nLengthCM / 100;
+      bDuration = false;
+   }
+   if (tsi.bits.m_validityFlag == ADAS::TrafficSignValidityFlag::tsValidityDuration)
+   {
+      nAreaEnd += ahat.nLengthCM / 100;
+      nDistanceOrDuration = ahat.nLengthCM / 100;
+      bDuration = true;
+   }
+
+   tsClass.nCount = 0;
+   const RVSignRule* pRule = findSignRule(ahat.type);
+   while (pRule != NULL)
+   {
+      int nNumber = 0;
+      if (pRule->nParam == PARAM_NUMBER)
+      {
+         nNumber = tsi.bits.m_nNumber;
+      }
+      else if (pRule->nParam != PARAM_NONE)
+      {
+         nNumber = getLanesParam(getLanes(source, ahat), pRule->nParam);
+      }
+      tsClass.areas[tsClass.nCount++] = RVAreas(ahat.bIsStart ? pRule->signStart : pRule->signEnd, nAreaStart, nAreaEnd, m_model.nMaxLanes, nNumber,
+                                                pRule->bValidity ? nDistanceOrDuration : 0, pRule->bValidity ? bDuration : false, pRule->bRealSign);
+      pRule = findSignRule(pRule->nAlsoType);
+   }
+};
+
+// Sorts the Traffic Sign Areas and removes the duplicated signs
+void RVRoadModelBuilder::sortTSAreas()
+{
+   // Sort traffic signs by:
+   // * position,
+   // * sign itself,
+   // * additional information.
+   std::sort(m_model.tsAreas.begin(), m_model.tsAreas.end());
+
+   // Then eliminate duplicate signs (same sign may be posted e.g. left and right or over multiple lanes).
+   // We don't expect differences in other properties. One compaction pass, the first of each run of duplicates wins.
+   m_model.tsAreas.erase(std::unique(m_model.tsAreas.begin(), m_model.tsAreas.end(), RVAreas::isSameSign), m_model.tsAreas.end());
+};
+
+
+// Returns the crossing sides between a parent link whose ID is provided and its Child links excluding the next link on the MPP
+RVSign::CrossingSideType RVRoadModelBuilder::getCrossingSide(RVHorizonSource& source, Uint32 nCurrentLinkId, RVSign::ProhibitedSideType* nProhibitedSide)
+{
+   RVStageTimer timer(m_pStageStats, RVStageStats::STAGE_CROSSING_SIDE);
+   // The sides depend on the children of the link and on the one continuing the MPP (none yet for the last link,
+   // until the MPP grows): reuse them while both are the same
+   int nPosition = m_mppIndex.getPosition(nCurrentLinkId);
+   Uint32 nNextLinkId = ((nPosition >= 0) && (nPosition + 1 < m_mppIndex.getSize())) ? m_mppIndex.getId(nPosition + 1) : 0;
+   ULONGLONG nKey = ((ULONGLONG) nCurrentLinkId << 32) | nNextLinkId;
+   CrossingClass* pClass = m_crossingCache.find(nKey);
+   if (pClass == NULL)
+   {
+      pClass = &m_crossingCache.insert(nKey);
+      pClass->nProhibitedSide = RVSign::PROHIBITED_NONE;
+      pClass->nCrossingSide = getChildrenSides(source, nCurrentLinkId, &pClass->nProhibitedSide);
+   }
+   // Prohibited sides accumulate over the crossings at the same distance (LEFT | RIGHT = BOTH)
+   *nProhibitedSide = (RVSign::ProhibitedSideType) (*nProhibitedSide | pClass->nProhibitedSide);
+   return pClass->nCrossingSide;
+};
+
+// Returns the crossing sides and the prohibited sides between a link and its Child links, excluding the MPP
+RVSign::CrossingSideType RVRoadModelBuilder::getChildrenSides(RVHorizonSource& source, Uint32 nCurrentLinkId, RVSign::ProhibitedSideType* nProhibitedSide)
+{
+   RVSign::CrossingSideType nCrossingSide = RVSign::CROSSING_UNKNOWN;
+
+   m_branches.clear();
+   source.getBranches(nCurrentLinkId, m_branches);     // U-turns are not returned
+   for (size_t i = 0; i < m_branches.size(); i++)
+   {
+      const RVBranch& child = m_branches[i];
+
+      if (!isIdOnMPP(child.nLinkId))  // Ignore the link if it's the next link on the MPP.
+      {
+         int nChildTurnAngle = child.nTurnAngleDegrees;
+         if (nChildTurnAngle < 0)  // Left Turn
+         {
+            nCrossingSide = nCrossingSide == RVSign::CROSSING_LEFT ? RVSign::CROSSING_LEFT:
+                            nCrossingSide == RVSign::CROSSING_UNKNOWN ? RVSign::CROSSING_LEFT:
+                            nCrossingSide == RVSign::CROSSING_RIGHT ? RVSign::CROSSING_BOTH:
+                            RVSign::CROSSING_BOTH;
+
+            // Determine if this link is prohibited (wrong-way)
+            if (child.fProbability == 0.0)
+            {
+               *nProhibitedSide = *nProhibitedSide == RVSign::PROHIBITED_RIGHT ? RVSign::PROHIBITED_BOTH:
+                                  *nProhibitedSide == RVSign::PROHIBITED_BOTH ? RVSign::PROHIBITED_BOTH:
+                                   RVSign::PROHIBITED_LEFT;
+            }
+         }
+         if (nChildTurnAngle > 0)  // Right Turn
+         {
+            nCrossingSide = nCrossingSide == RVSign::CROSSING_LEFT ? RVSign::CROSSING_BOTH:
+                            nCrossingSide == RVSign::CROSSING_UNKNOWN ? RVSign::CROSSING_RIGHT:
+                            nCrossingSide == RVSign::CROSSING_RIGHT ? RVSign::CROSSING_RIGHT:
+                            RVSign::CROSSING_BOTH;
+
+            // Determine if this link is prohibited (wrong-way)
+            if (child.fProbability == 0.0)
+            {
+               *nProhibitedSide = *nProhibitedSide == RVSign::PROHIBITED_LEFT ? RVSign::PROHIBITED_BOTH:
+                                  *nProhibitedSide == RVSign::PROHIBITED_BOTH ? RVSign::PROHIBITED_BOTH:
+                                   RVSign::PROHIBITED_RIGHT;
+            }
+         }
+
+      };
+   };
+
+   return nCrossingSide;
+};
+
+// returns Current/ADAS or Expected speed on link with provided Id - added by sdrehe to account for ADAS Speed Limits
+Uint32 RVRoadModelBuilder::getSpeedOnLink(RVHorizonSource& source, Uint32 nLinkId)
+{
+   // Look for speed attributes in the summary of the link
+   const RVLinkSummary& link = getLinkSummary(source, nLinkId);
+   Uint32 nCurrentSpeed = link.nCurrentSpeed;
+   Uint32 nExpectedSpeed = link.nExpectedSpeed;
+
+   // If the Current/ADAS Speed Limit is not defined take the Expected Speed Limit (from the Speed Cat)
+   Uint32 sp = (nCurrentSpeed != 0) ? nCurrentSpeed : nExpectedSpeed;
+   m_model.bIsCurrentSpeed = (nCurrentSpeed != 0) ? true : false;
+
+   return sp;
+};
+
+
+// Check if the link with given ID is on MPP
+bool RVRoadModelBuilder::isIdOnMPP(Uint32 nLinkId)
+{
+   return m_mppIndex.contains(nLinkId);
+};
+
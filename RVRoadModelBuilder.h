@@ -0,0 +1,126 @@
+/**
+ * @file    RVRoadModelBuilder.h
+ * @brief   Builds the road model (Signs, Areas, root link infos) from the Horizon.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The builder runs in the AH listener, where the Horizon is consistent, and publishes complete models to the
+ * painting through an RVModelBuffer. It reads the Horizon through RVHorizonSource only and does not use MFC.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include "RVRoadModel.h"
+#include "RVModelBuffer.h"
+#include "RVHorizonSource.h"
+#include "RVMppIndex.h"
+#include "RVAttributeCache.h"
+#include "RVLinkCache.h"
+#include "RVStageStats.h"
+
+struct RVSignRule;
+
+class RVRoadModelBuilder
+{
+public: // Constructor/Destructor
+
+   RVRoadModelBuilder();
+
+
+public: // Building
+
+   /** Single pass over the Horizon attributes: root link infos, Traffic Signs and MPP attributes for getPathInfos() */
+   void scanHorizon(RVHorizonSource& source, bool bFullRebuild);
+   /** Updates the root link infos (city, speed limit) */
+   void setRootLink(RVHorizonSource& source, Uint32 nLinkId);
+   /** Publishes a copy of the current model */
+   void publish(RVModelBuffer& buffer);
+   /** Sets the stats the extraction stages are timed into (NULL for none) */
+   void setStageStats(RVStageStats* pStats) { m_pStageStats = pStats; };
+
+   /** Returns the model being built (for the AH listener thread only) */
+   const RVRoadModel& getModel() const { return m_model; };
+   /** Returns the counters published with the model */
+   RVUpdateStats&     getStats()       { return m_model.stats; };
+
+
+private: // Worker methods
+
+   /** Gets the MPP of the current Horizon and rebuilds the MPP index used by the methods below */
+   void getMostProbablePath(RVHorizonSource& source);
+   /** Checks if the MPP has the same topology as the previous one (car moved on, links added at the end) */
+   bool isMppContinuation();
+   /** Gets all the infos along the MPP to build the Road View (Crossings, Lane changes, Crossing Sides, Prohibited Roads). */
+   void getPathInfos(RVHorizonSource& source);
+   /** Gets the Side of the Crossing at the end of the link with id nLinkId */
+   RVSign::CrossingSideType getCrossingSide(RVHorizonSource& source, Uint32 nLinkId, RVSign::ProhibitedSideType* nProhibitedSide);
+   RVSign::CrossingSideType getChildrenSides(RVHorizonSource& source, Uint32 nLinkId, RVSign::ProhibitedSideType* nProhibitedSide);
+
+   /** Check if the link with given ID is on the MPP */
+   bool isIdOnMPP(Uint32 nLinkId);
+   /** Retrieves the Speed Limit (Current/ADAS or Expected) on the link whose Id is provided */
+   Uint32 getSpeedOnLink(RVHorizonSource& source, Uint32 nLinkId);
+   /** Get number of lanes on the link that ahat refers to. Add opposing lanes * 64. */
+   int getLanes(RVHorizonSource& source, ADAS::HorizonAttribute &ahat);
+   /** Get the summary of the attributes of a link (lanes, one way, speed limits), cached per Horizon generation */
+   const RVLinkSummary& getLinkSummary(RVHorizonSource& source, Uint32 nLinkId);
+   /** Add the Traffic Sign(s) of an attribute along the MPP to the Traffic Sign Areas */
+   void addTSAreas(RVHorizonSource& source, ADAS::HorizonAttribute& ahat, Sint32 nDist);
+   /** Get the Traffic Sign(s) of an attribute along the MPP, relative to the attribute position */
+   struct TSClass;
+   void classifyTSArea(RVHorizonSource& source, ADAS::HorizonAttribute& ahat, TSClass& tsClass);
+   /** Sorts the Traffic Sign Areas and removes the duplicates */
+   void sortTSAreas();
+   /** Returns the Traffic Sign rule for an attribute type */
+   const RVSignRule* findSignRule(int nType) const;
+
+
+private: // Data members
+
+   /** Model being built, copied to the model buffer by publish() */
+   RVRoadModel        m_model;
+
+   /** Most probable path of the current Horizon and its index (built once per update) */
+   std::vector<Uint32> m_mpp;
+   RVMppIndex         m_mppIndex;
+
+   /** Attribute on the MPP ahead of the car, as collected by scanHorizon(). nDistCM is the distance along the MPP. */
+   struct PathAttribute
+   {
+      ADAS::HorizonAttribute  ahat;
+      Sint32                  nDistCM;
+   };
+   std::vector<PathAttribute> m_pathAttrs;
+   static void sortByDistance(std::vector<PathAttribute>& attrs);
+
+   /** Classification results reused by incremental updates, dropped when the MPP topology changes */
+   struct TSClass
+   {
+      int            nCount;
+      RVAreas        areas[2];     // A Pedestrian Crosswalk also gives a Traffic Light
+   };
+   struct CrossingClass
+   {
+      RVSign::CrossingSideType   nCrossingSide;
+      RVSign::ProhibitedSideType nProhibitedSide;
+   };
+   std::vector<Uint32>                             m_previousMpp;
+   std::vector<Sint32>                             m_previousLinkStartCM;   // Link offsets of the previous MPP
+   Sint32                                          m_nCarOffsetCM;          // Car position from the start of the root link
+   RVAttributeCache<RVAttributeKey, TSClass>       m_tsCache;
+   RVAttributeCache<ULONGLONG, CrossingClass>      m_crossingCache;         // Keyed by the link and the next MPP link
+   /** Link summaries, invalidated with the Horizon */
+   RVLinkCache                                     m_linkCache;
+   std::vector<ADAS::HorizonAttribute>             m_linkAttrs;
+   std::vector<RVBranch>                           m_branches;
+   /** Driving side of the root link, read from the source only when the root link or the Horizon changes */
+   bool                                            m_bDrivingSideKnown;
+   Uint32                                          m_nDrivingSideLinkId;
+   bool                                            m_bRightSideDrive;
+   /** Latency histograms of the stages, owned by the view */
+   RVStageStats*                                   m_pStageStats;
+};
+
+
@@ -0,0 +1,190 @@
+/**
+ * @file    RVSignAtlas.h
+ * @brief   Cache of the Traffic Signs rasterized by TrafficSign, blitted instead of drawn again for each frame.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * A sprite is a bitmap compatible with the window holding one sign drawn by TrafficSign::draw() with its
+ * parameter, its distance or duration label and its pixel size, over a key color made transparent when it is
+ * blitted. The sprites are kept in least recently used order and the oldest ones are deleted when their memory
+ * exceeds the cap. A sign larger than the cap is drawn directly. The hits, misses, evictions and memory are
+ * counted.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <list>
+#include "RVDisplayList.h"
+
+class RVSignAtlas
+{
+public: // Constants
+
+   struct Stats
+   {
+      Uint32   nHits;               // Signs blitted from their sprite
+      Uint32   nMisses;             // Signs rasterized into a new sprite (or drawn directly)
+      Uint32   nEvictions;          // Sprites deleted to stay under the cap
+      Uint32   nSprites;
+      Uint32   nBytes;              // Memory of the sprites (32 bits per pixel)
+   };
+
+   static const Uint32     DEFAULT_MAX_BYTES    = 4 * 1024 * 1024;
+   static const COLORREF   KEY_COLOR            = RGB(255, 0, 255);     // Transparent pixels of the sprites
+
+
+public: // Constructor/Destructor
+
+   RVSignAtlas()
+   {
+      m_nMaxBytes = DEFAULT_MAX_BYTES;
+      memset(&m_stats, 0, sizeof(m_stats));
+   };
+
+   ~RVSignAtlas()
+   {
+      clear();
+   };
+
+
+public: // Cache
+
+   /** Sets the memory cap of the sprites, evicting the oldest ones if needed */
+   void setMaxBytes(Uint32 nMaxBytes)
+   {
+      m_nMaxBytes = nMaxBytes;
+      evict(0);
+   };
+
+   /** Deletes all the sprites (DPI or sign set changed) */
+   void clear()
+   {
+      for (SpriteMap::iterator it = m_sprites.begin(); it != m_sprites.end(); ++it)
+      {
+         delete it->second.pBitmap;
+      }
+      m_sprites.clear();
+      m_lru.clear();
+      m_stats.nSprites = 0;
+      m_stats.nBytes = 0;
+      if (m_dcSprite.GetSafeHdc() != NULL)
+      {
+         m_dcSprite.DeleteDC();
+      }
+   };
+
+   /** Draws the sign into the rectangle of the DC, from its sprite (rasterized by pSigns on first use).
+    *  Returns false if the sign was drawn directly into the DC by pSigns (which may change its state). */
+   bool draw(CDC& dc, TrafficSign* pSigns, const CRect& rect, const RVSignBlit& sign)
+   {
+      Key key = { sign.nSign, sign.nParam, sign.nDistance, sign.bLength, rect.Width(), rect.Height() };
+      Uint32 nBytes = (Uint32) (key.nWidth * key.nHeight * 4);
+      if ((key.nWidth <= 0) || (key.nHeight <= 0) || (nBytes > m_nMaxBytes))
+      {
+         m_stats.nMisses++;
+         pSigns->draw(&dc, rect, (TrafficSign::Sign) sign.nSign, sign.nParam, sign.nDistance, sign.bLength, false);
+         return false;
+      }
+      if (m_dcSprite.GetSafeHdc() == NULL)
+      {
+         m_dcSprite.CreateCompatibleDC(&dc);
+      }
+
+      SpriteMap::iterator it = m_sprites.find(key);
+      if (it != m_sprites.end())
+      {
+         m_stats.nHits++;
+         m_lru.splice(m_lru.begin(), m_lru, it->second.itLru);
+      }
+      else
+      {
+         m_stats.nMisses++;
+         evict(nBytes);
+         Sprite sprite;
+         sprite.pBitmap = new CBitmap();
+         sprite.pBitmap->CreateCompatibleBitmap(&dc, key.nWidth, key.nHeight);
+         sprite.nBytes = nBytes;
+         CBitmap* pOldBitmap = m_dcSprite.SelectObject(sprite.pBitmap);
+            m_dcSprite.FillSolidRect(0, 0, key.nWidth, key.nHeight, KEY_COLOR);
+            pSigns->draw(&m_dcSprite, CRect(0, 0, key.nWidth, key.nHeight), (TrafficSign::Sign) sign.nSign, sign.nParam, sign.nDistance, sign.bLength, false);
+         m_dcSprite.SelectObject(pOldBitmap);
+         m_lru.push_front(key);
+         sprite.itLru = m_lru.begin();
+         it = m_sprites.insert(SpriteMap::value_type(key, sprite)).first;
+         m_stats.nSprites++;
+         m_stats.nBytes += nBytes;
+      }
+
+      CBitmap* pOldBitmap = m_dcSprite.SelectObject(it->second.pBitmap);
+         dc.TransparentBlt(rect.left, rect.top, key.nWidth, key.nHeight, &m_dcSprite, 0, 0, key.nWidth, key.nHeight, KEY_COLOR);
+      m_dcSprite.SelectObject(pOldBitmap);
+      return true;
+   };
+
+
+public: // Getters
+
+   const Stats&   getStats()     const { return m_stats;     };
+   Uint32         getMaxBytes()  const { return m_nMaxBytes; };
+
+
+private: // Worker methods
+
+   /** Deletes the least recently used sprites until nBytes more fit under the cap */
+   void evict(Uint32 nBytes)
+   {
+      while (!m_lru.empty() && (m_stats.nBytes + nBytes > m_nMaxBytes))
+      {
+         SpriteMap::iterator it = m_sprites.find(m_lru.back());
+         m_stats.nBytes -= it->second.nBytes;
+         m_stats.nSprites--;
+         m_stats.nEvictions++;
+         delete it->second.pBitmap;
+         m_sprites.erase(it);
+         m_lru.pop_back();
+      }
+   };
+
+
+private: // Data Members
+
+   /** Everything TrafficSign::draw() paints from, and the pixel size */
+   struct Key
+   {
+      Sint32   nSign;
+      Uint32   nParam;
+      Sint32   nDistance;
+      bool     bLength;
+      int      nWidth;
+      int      nHeight;
+
+      bool operator<(const Key& other) const
+      {
+         if (nSign != other.nSign)           return nSign < other.nSign;
+         if (nParam != other.nParam)         return nParam < other.nParam;
+         if (nDistance != other.nDistance)   return nDistance < other.nDistance;
+         if (bLength != other.bLength)       return bLength < other.bLength;
+         if (nWidth != other.nWidth)         return nWidth < other.nWidth;
+         return nHeight < other.nHeight;
+      };
+   };
+
+   struct Sprite
+   {
+      CBitmap*                   pBitmap;
+      Uint32                     nBytes;
+      std::list<Key>::iterator   itLru;
+   };
+
+   typedef std::map<Key, Sprite> SpriteMap;
+
+   SpriteMap         m_sprites;
+   std::list<Key>    m_lru;               // Most recently used first
+   CDC               m_dcSprite;          // Created with the first sprite, compatible with the window
+   Uint32            m_nMaxBytes;
+   Stats             m_stats;
+};
+
+
@@ -0,0 +1,307 @@
+/**
+ * @file    RVSoftwareBackend.cpp
+ * @brief   Software rasterizer replaying a Road View display list into an RGBA buffer, without GDI.
+ * @version 0.1
+ * @date    16.10.2026.
+ */
+
+#include "RVTypes.h"
+#include "RVSoftwareBackend.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+// SSE2 is always available on x64, and on x86 when the compiler targets it (/arch:SSE2 or -msse2)
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+   #include <emmintrin.h>
+   #define RV_SSE2
+#endif
+
+static const int     HATCH_PERIOD         = 8;           // HS_BDIAGONAL: one diagonal every 8 pixels
+static const Uint32  PLACEHOLDER_COLOR    = 0x808080;    // Signs (COLORREF)
+static const int     TEXT_CHAR_WIDTH      = 8;           // Extent of a char of the text font (Tahoma 16 bold)
+static const int     TEXT_HEIGHT          = 16;
+
+// Fills n pixels with the same value, 4 pixels per store with SSE2
+static void fillPixels(Uint32* p, int n, Uint32 nPixel)
+{
+#ifdef RV_SSE2
+   __m128i v = _mm_set1_epi32((int) nPixel);
+   for (; n >= 4; n -= 4, p += 4)
+   {
+      _mm_storeu_si128((__m128i*) p, v);
+   }
+#endif
+   for (; n > 0; n--)
+   {
+      *p++ = nPixel;
+   }
+};
+
+// Fills n pixels with a pattern of HATCH_PERIOD pixels starting at its first pixel, 4 pixels per store with SSE2
+static void fillPattern(Uint32* p, int n, const Uint32* pPattern)
+{
+   int i = 0;
+#ifdef RV_SSE2
+   __m128i v0 = _mm_loadu_si128((const __m128i*) pPattern);
+   __m128i v1 = _mm_loadu_si128((const __m128i*) (pPattern + 4));
+   for (; i + 8 <= n; i += 8)
+   {
+      _mm_storeu_si128((__m128i*) (p + i), v0);
+      _mm_storeu_si128((__m128i*) (p + i + 4), v1);
+   }
+#endif
+   for (; i < n; i++)
+   {
+      p[i] = pPattern[i % HATCH_PERIOD];
+   }
+};
+
+
+RVSoftwareBackend::RVSoftwareBackend()
+{
+   m_nWidth = 0;
+   m_nHeight = 0;
+   m_nBackColor = toPixel(0xFFFFFF);
+};
+
+//////////
+// Canvas
+
+void RVSoftwareBackend::resize(int nWidth, int nHeight)
+{
+   m_nWidth  = (std::max)(nWidth, 0);
+   m_nHeight = (std::max)(nHeight, 0);
+   m_pixels.resize((size_t) m_nWidth * m_nHeight);
+};
+
+void RVSoftwareBackend::clear(Uint32 nColor)
+{
+   if (!m_pixels.empty())
+   {
+      fillPixels(&m_pixels[0], (int) m_pixels.size(), toPixel(nColor));
+   }
+};
+
+void RVSoftwareBackend::blit(const Uint32* pPixels, int nWidth, int nHeight, int x, int y)
+{
+   int xFirst = (std::max)(x, 0);
+   int xLast  = (std::min)(x + nWidth, m_nWidth);
+   int yFirst = (std::max)(y, 0);
+   int yLast  = (std::min)(y + nHeight, m_nHeight);
+   if ((xFirst >= xLast) || (yFirst >= yLast))
+   {
+      return;
+   }
+   for (int yRow = yFirst; yRow < yLast; yRow++)
+   {
+      memcpy(&m_pixels[yRow * m_nWidth + xFirst], pPixels + (yRow - y) * nWidth + (xFirst - x), (xLast - xFirst) * sizeof(Uint32));
+   }
+};
+
+bool RVSoftwareBackend::writePPM(const char* szPath) const
+{
+   FILE* pFile = fopen(szPath, "wb");
+   if (pFile == NULL)
+   {
+      return false;
+   }
+   fprintf(pFile, "P6\n%d %d\n255\n", m_nWidth, m_nHeight);
+   std::vector<unsigned char> row(m_nWidth * 3);
+   bool bOk = true;
+   for (int y = 0; (y < m_nHeight) && bOk; y++)
+   {
+      const Uint32* pRow = &m_pixels[y * m_nWidth];
+      for (int x = 0; x < m_nWidth; x++)
+      {
+         row[x * 3]     = (unsigned char) (pRow[x]);
+         row[x * 3 + 1] = (unsigned char) (pRow[x] >> 8);
+         row[x * 3 + 2] = (unsigned char) (pRow[x] >> 16);
+      }
+      bOk = row.empty() || (fwrite(&row[0], 1, row.size(), pFile) == row.size());
+   }
+   return (fclose(pFile) == 0) && bOk;
+};
+
+///////////////////
+// RVRenderBackend
+
+void RVSoftwareBackend::fillRect(const RVRect& rect, const RVStyle& style)
+{
+   if (style.nPattern != RVStyle::PATTERN_HATCH)
+   {
+      fillBox(rect.nLeft, rect.nTop, rect.nRight, rect.nBottom, toPixel(style.nColor));
+      return;
+   }
+
+   // Diagonal hatch over the background color: the pixels with (x + y) multiple of the period, as "/" lines
+   int xFirst = (std::max)(rect.nLeft, 0);
+   int xLast  = (std::min)(rect.nRight, m_nWidth);
+   Uint32 nHatch = toPixel(style.nColor);
+   Uint32 pattern[HATCH_PERIOD];
+   for (int y = (std::max)(rect.nTop, 0); (y < rect.nBottom) && (y < m_nHeight) && (xFirst < xLast); y++)
+   {
+      for (int i = 0; i < HATCH_PERIOD; i++)
+      {
+         pattern[i] = (((xFirst + i + y) % HATCH_PERIOD) == 0) ? nHatch : m_nBackColor;
+      }
+      fillPattern(&m_pixels[y * m_nWidth + xFirst], xLast - xFirst, pattern);
+   }
+};
+
+void RVSoftwareBackend::polyline(const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style, int nWidth)
+{
+   Uint32 nPixel = toPixel(style.nColor);
+   for (Uint32 i = 1; i < nPoints; i++)
+   {
+      drawSegment(pPoints[i - 1].x, pPoints[i - 1].y, pPoints[i].x, pPoints[i].y, nWidth, nPixel);
+   }
+};
+
+// Scanline fill with the alternate (even-odd) rule: a pixel is inside if its center is inside
+void RVSoftwareBackend::polygon(const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style)
+{
+   Uint32 nPixel = toPixel(style.nColor);
+   int yMin = pPoints[0].y;
+   int yMax = pPoints[0].y;
+   for (Uint32 i = 1; i < nPoints; i++)
+   {
+      yMin = (std::min)(yMin, (int) pPoints[i].y);
+      yMax = (std::max)(yMax, (int) pPoints[i].y);
+   }
+
+   for (int y = (std::max)(yMin, 0); (y < yMax) && (y < m_nHeight); y++)
+   {
+      double fCenter = y + 0.5;
+      m_crossings.clear();
+      for (Uint32 i = 0; i < nPoints; i++)
+      {
+         const RVPoint& a = pPoints[i];
+         const RVPoint& b = pPoints[(i + 1) % nPoints];
+         if ((a.y > fCenter) != (b.y > fCenter))
+         {
+            double x = a.x + (fCenter - a.y) * (b.x - a.x) / (double) (b.y - a.y);
+            m_crossings.push_back((int) ceil(x - 0.5));
+         }
+      }
+      std::sort(m_crossings.begin(), m_crossings.end());
+      for (size_t i = 0; i + 1 < m_crossings.size(); i += 2)
+      {
+         fillSpan(m_crossings[i], m_crossings[i + 1], y, nPixel);
+      }
+   }
+
+   // Outline with the pen of the style, closed
+   for (Uint32 i = 0; i < nPoints; i++)
+   {
+      const RVPoint& a = pPoints[i];
+      const RVPoint& b = pPoints[(i + 1) % nPoints];
+      drawSegment(a.x, a.y, b.x, b.y, style.nWidth, nPixel);
+   }
+};
+
+// The dashes are clipped to [xStart, xEnd[ without caps, so that a dash cut between two batches joins seamlessly
+void RVSoftwareBackend::dashedLines(int xStart, int xEnd, const RVPoint* pAnchors, Uint32 nLines, int nDash, int nGap, const RVStyle& style)
+{
+   Uint32 nPixel = toPixel(style.nColor);
+   int nWidth = (std::max)((int) style.nWidth, 1);
+   int nCap = (nWidth > 1) ? nWidth / 2 : 0;
+   for (Uint32 i = 0; i < nLines; i++)
+   {
+      int yTop = pAnchors[i].y - nWidth / 2;
+      for (int x = getFirstDash(xStart, pAnchors[i].x, nDash, nGap); x < xEnd; x += nDash + nGap)
+      {
+         fillBox((std::max)(x - nCap, xStart), yTop, (std::min)(x + nDash + nCap, xEnd), yTop + nWidth, nPixel);
+      }
+   }
+};
+
+// No sign bitmaps off Windows: the sign rectangle is framed
+void RVSoftwareBackend::sign(const RVRect& rect, const RVSignBlit& /*sign*/)
+{
+   Uint32 nPixel = toPixel(PLACEHOLDER_COLOR);
+   fillBox(rect.nLeft,      rect.nTop,        rect.nRight,     rect.nTop + 1,    nPixel);
+   fillBox(rect.nLeft,      rect.nBottom - 1, rect.nRight,     rect.nBottom,     nPixel);
+   fillBox(rect.nLeft,      rect.nTop,        rect.nLeft + 1,  rect.nBottom,     nPixel);
+   fillBox(rect.nRight - 1, rect.nTop,        rect.nRight,     rect.nBottom,     nPixel);
+};
+
+// No fonts off Windows: the text is underlined over its approximate extent
+void RVSoftwareBackend::text(int x, int y, const char* /*szText*/, Uint32 nLength, const RVStyle& style)
+{
+   fillBox(x, y + TEXT_HEIGHT - 2, x + (int) nLength * TEXT_CHAR_WIDTH, y + TEXT_HEIGHT, toPixel(style.nColor));
+};
+
+///////////////////
+// Worker methods
+
+void RVSoftwareBackend::fillSpan(int x1, int x2, int y, Uint32 nPixel)
+{
+   if ((y < 0) || (y >= m_nHeight))
+   {
+      return;
+   }
+   x1 = (std::max)(x1, 0);
+   x2 = (std::min)(x2, m_nWidth);
+   if (x1 < x2)
+   {
+      fillPixels(&m_pixels[y * m_nWidth + x1], x2 - x1, nPixel);
+   }
+};
+
+void RVSoftwareBackend::fillBox(int x1, int y1, int x2, int y2, Uint32 nPixel)
+{
+   for (int y = (std::max)(y1, 0); (y < y2) && (y < m_nHeight); y++)
+   {
+      fillSpan(x1, x2, y, nPixel);
+   }
+};
+
+// Horizontal and vertical segments (most of the Road View) are filled as boxes. The others are stepped with
+// Bresenham, a square of the pen width per step. Wide pens get square caps of half the width, close to the round
+// caps of the GDI geometric pens.
+void RVSoftwareBackend::drawSegment(int x1, int y1, int x2, int y2, int nWidth, Uint32 nPixel)
+{
+   nWidth = (std::max)(nWidth, 1);
+   int nHalf = nWidth / 2;
+   int nCap  = (nWidth > 1) ? nHalf : 0;
+
+   if (y1 == y2)
+   {
+      int xFirst = (x1 <= x2) ? x1 : x2 + 1;
+      int xLast  = (x1 <= x2) ? x2 : x1 + 1;
+      fillBox(xFirst - nCap, y1 - nHalf, xLast + nCap, y1 - nHalf + nWidth, nPixel);
+      return;
+   }
+   if (x1 == x2)
+   {
+      int yFirst = (y1 <= y2) ? y1 : y2 + 1;
+      int yLast  = (y1 <= y2) ? y2 : y1 + 1;
+      fillBox(x1 - nHalf, yFirst - nCap, x1 - nHalf + nWidth, yLast + nCap, nPixel);
+      return;
+   }
+
+   int dx  = abs(x2 - x1);
+   int dy  = -abs(y2 - y1);
+   int sx  = (x1 < x2) ? 1 : -1;
+   int sy  = (y1 < y2) ? 1 : -1;
+   int err = dx + dy;
+   while ((x1 != x2) || (y1 != y2))
+   {
+      fillBox(x1 - nHalf, y1 - nHalf, x1 - nHalf + nWidth, y1 - nHalf + nWidth, nPixel);
+      int e2 = 2 * err;
+      if (e2 >= dy)
+      {
+         err += dy;
+         x1  += sx;
+      }
+      if (e2 <= dx)
+      {
+         err += dx;
+         y1  += sy;
+      }
+   }
+};
+
+
@@ -0,0 +1,87 @@
+/**
+ * @file    RVSoftwareBackend.h
+ * @brief   Software rasterizer replaying a Road View display list into an RGBA buffer, without GDI.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * Renders the Road View off Windows, e.g. to review recorded drives or to compare frames on a build box.
+ * Everything is drawn as horizontal spans, filled 4 pixels at a time with SSE2 when the compiler targets it:
+ * solid and hatched (HS_BDIAGONAL) rectangles, solid and dashed lines of any width, convex and concave polygons
+ * (alternate fill, as GDI), bitmap blits. The Traffic Signs and the text have no bitmaps nor fonts here: they are
+ * drawn as placeholders of their extent. The pixels are 0xAABBGGRR (R, G, B, A in memory) and can be written
+ * as a binary PPM.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include "RVDisplayList.h"
+
+class RVSoftwareBackend : public RVRenderBackend
+{
+public: // Constructor/Destructor
+
+   RVSoftwareBackend();
+
+
+public: // Canvas
+
+   /** Sets the size of the canvas. The content is undefined until clear(). */
+   void resize(int nWidth, int nHeight);
+   /** Fills the whole canvas with the color (COLORREF) */
+   void clear(Uint32 nColor);
+   /** Background color of the hatched fills (the DC background color with GDI, white by default) */
+   void setBackColor(Uint32 nColor)    { m_nBackColor = toPixel(nColor); };
+
+   /** Replays the list over the current content */
+   void replay(const RVDisplayList& list)
+   {
+      list.replay(*this);
+   };
+
+   /** Copies a bitmap of RGBA pixels (same format as the canvas) at (x, y), clipped to the canvas */
+   void blit(const Uint32* pPixels, int nWidth, int nHeight, int x, int y);
+
+   /** Writes the canvas as a binary PPM (P6). Returns false if the file cannot be written. */
+   bool writePPM(const char* szPath) const;
+
+   int            getWidth()              const { return m_nWidth;  };
+   int            getHeight()             const { return m_nHeight; };
+   const Uint32*  getPixels()             const { return m_pixels.empty() ? NULL : &m_pixels[0]; };
+   Uint32         getPixel(int x, int y)  const { return m_pixels[y * m_nWidth + x]; };
+
+
+public: // RVRenderBackend
+
+   virtual void fillRect  (const RVRect& rect, const RVStyle& style);
+   virtual void polyline  (const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style, int nWidth);
+   virtual void polygon   (const RVPoint* pPoints, Uint32 nPoints, const RVStyle& style);
+   virtual void dashedLines(int xStart, int xEnd, const RVPoint* pAnchors, Uint32 nLines, int nDash, int nGap, const RVStyle& style);
+   virtual void sign      (const RVRect& rect, const RVSignBlit& sign);
+   virtual void text      (int x, int y, const char* szText, Uint32 nLength, const RVStyle& style);
+
+
+private: // Worker methods
+
+   /** COLORREF to opaque RGBA pixel */
+   static Uint32 toPixel(Uint32 nColor)   { return (nColor & 0x00FFFFFF) | 0xFF000000; };
+
+   /** Fills the pixels [x1, x2[ of the row y, clipped */
+   void fillSpan(int x1, int x2, int y, Uint32 nPixel);
+   /** Fills the rectangle [x1, x2[ x [y1, y2[, clipped */
+   void fillBox(int x1, int y1, int x2, int y2, Uint32 nPixel);
+   /** Draws the segment from (x1, y1) to (x2, y2), the end point excluded, with a square pen of nWidth pixels */
+   void drawSegment(int x1, int y1, int x2, int y2, int nWidth, Uint32 nPixel);
+
+
+private: // Data Members
+
+   std::vector<Uint32>  m_pixels;
+   int                  m_nWidth;
+   int                  m_nHeight;
+   Uint32               m_nBackColor;
+   std::vector<int>     m_crossings;      // Edge crossings of a polygon scanline (kept between polygons)
+};
+
+
@@ -0,0 +1,258 @@
+/**
+ * @file    RVStageStats.h
+ * @brief   Latency histograms of the stages of the Road View, from the Horizon extraction to the paint.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * Each stage has a histogram of its durations in microseconds, with 4 buckets per power of two (about 19% wide)
+ * up to 2^17 us, and counts the items it processed (attributes, primitives). A stage is recorded by a single
+ * thread (the AH listener for the extraction, the window for the layout and the paint) while the window reads
+ * all of them: the counters are atomic, no lock is taken.
+ *
+ * The stages are timed by an RVStageTimer in the scope of the stage, on the steady clock of the C++ library, so
+ * that the builder keeps building without Win32. While the stats are disabled, a timer does not read the clock:
+ * it only tests the flag. The percentiles are the upper bounds of their buckets.
+ */
+
+
+#pragma once
+
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+
+class RVStageStats
+{
+public: // Constants
+
+   enum Stage
+   {
+      STAGE_SCAN_HORIZON,        // RVRoadModelBuilder::scanHorizon(), with the stages below (items: attributes)
+      STAGE_TS_AREAS,            // Traffic Signs of the attributes ahead (items: attributes)
+      STAGE_PATH_INFOS,          // RVRoadModelBuilder::getPathInfos() (items: attributes)
+      STAGE_CROSSING_SIDE,       // RVRoadModelBuilder::getCrossingSide(), per crossing
+      STAGE_LAYOUT,              // Layout of the display list, with the two stages below (items: primitives)
+      STAGE_PAINT_ROAD,          // CAHRoadView::paintRoad() (items: primitives)
+      STAGE_PAINT_SIGNS,         // CAHRoadView::paintSigns() (items: primitives)
+      STAGE_REPLAY,              // Replay of the display list into the frame layer (items: primitives)
+      STAGE_FRAME,               // CAHRoadView::OnPaint()
+      STAGE_COUNT
+   };
+
+   static const int BUCKETS = 64;
+
+
+public: // Constructor/Destructor
+
+   RVStageStats()
+   {
+      m_bEnabled = false;
+      reset();
+   };
+
+
+public: // Recording
+
+   /** Enables or disables the recording. The histograms restart when enabled. */
+   void setEnabled(bool bEnabled)
+   {
+      if (bEnabled && !m_bEnabled.load())
+      {
+         reset();
+      }
+      m_bEnabled = bEnabled;
+   };
+
+   bool isEnabled() const { return m_bEnabled.load(std::memory_order_relaxed); };
+
+   /** Clears the histograms (samples being recorded meanwhile may be lost) */
+   void reset()
+   {
+      for (int i = 0; i < STAGE_COUNT; i++)
+      {
+         Histogram& h = m_histograms[i];
+         for (int b = 0; b < BUCKETS; b++)
+         {
+            h.nCounts[b] = 0;
+         }
+         h.nItems = 0;
+         h.nMaxUs = 0;
+      }
+   };
+
+   /** Records a duration of the stage, in microseconds, and the items it processed */
+   void record(Stage nStage, Uint32 nUs, Uint32 nItems)
+   {
+      Histogram& h = m_histograms[nStage];
+      h.nCounts[getBucket(nUs)].fetch_add(1, std::memory_order_relaxed);
+      h.nItems.fetch_add(nItems, std::memory_order_relaxed);
+      Uint32 nMax = h.nMaxUs.load(std::memory_order_relaxed);
+      while ((nUs > nMax) && !h.nMaxUs.compare_exchange_weak(nMax, nUs, std::memory_order_relaxed))
+      {
+      }
+   };
+
+
+public: // Getters
+
+   struct Summary
+   {
+      Uint32   nSamples;
+      Uint32   nItems;
+      Uint32   nP50Us;
+      Uint32   nP95Us;
+      Uint32   nP99Us;
+      Uint32   nMaxUs;
+   };
+
+   /** Percentiles of the stage, from a copy of its histogram */
+   Summary getSummary(Stage nStage) const
+   {
+      const Histogram& h = m_histograms[nStage];
+      Uint32 nCounts[BUCKETS];
+      Summary summary;
+      summary.nSamples = 0;
+      for (int b = 0; b < BUCKETS; b++)
+      {
+         nCounts[b] = h.nCounts[b].load(std::memory_order_relaxed);
+         summary.nSamples += nCounts[b];
+      }
+      summary.nItems = h.nItems.load(std::memory_order_relaxed);
+      summary.nMaxUs = h.nMaxUs.load(std::memory_order_relaxed);
+      summary.nP50Us = getPercentile(nCounts, summary.nSamples, 50, summary.nMaxUs);
+      summary.nP95Us = getPercentile(nCounts, summary.nSamples, 95, summary.nMaxUs);
+      summary.nP99Us = getPercentile(nCounts, summary.nSamples, 99, summary.nMaxUs);
+      return summary;
+   };
+
+   static const char* getName(Stage nStage)
+   {
+      static const char* NAMES[STAGE_COUNT] = {
+         "scanHorizon", "tsAreas", "getPathInfos", "getCrossingSide", "layout", "paintRoad", "paintSigns", "replay", "frame"
+      };
+      return NAMES[nStage];
+   };
+
+   /** Writes the summary of all the stages to the file (replaced). Returns false if it cannot be written. */
+   bool dump(const char* szPath) const
+   {
+      FILE* pFile = fopen(szPath, "w");
+      if (pFile == NULL)
+      {
+         return false;
+      }
+      fprintf(pFile, "%-16s %10s %10s %8s %8s %8s %8s\n", "stage", "samples", "items", "p50 us", "p95 us", "p99 us", "max us");
+      for (int i = 0; i < STAGE_COUNT; i++)
+      {
+         Summary s = getSummary((Stage) i);
+         fprintf(pFile, "%-16s %10u %10u %8u %8u %8u %8u\n", getName((Stage) i), s.nSamples, s.nItems, s.nP50Us, s.nP95Us, s.nP99Us, s.nMaxUs);
+      }
+      fclose(pFile);
+      return true;
+   };
+
+
+private: // Worker methods
+
+   /** 0..3 us in the first buckets, then 4 buckets per power of two */
+   static int getBucket(Uint32 nUs)
+   {
+      if (nUs < 4)
+      {
+         return (int) nUs;
+      }
+      int nOctave = 2;
+      while ((nOctave < 30) && ((nUs >> (nOctave + 1)) != 0))     // Beyond 2^17 us all fall in the last bucket
+      {
+         nOctave++;
+      }
+      int nBucket = 4 * (nOctave - 1) + (int) ((nUs >> (nOctave - 2)) & 3);
+      return (nBucket < BUCKETS) ? nBucket : BUCKETS - 1;
+   };
+
+   /** Largest duration of the bucket */
+   static Uint32 getBucketMax(int nBucket)
+   {
+      if (nBucket < 4)
+      {
+         return (Uint32) nBucket;
+      }
+      int nOctave = nBucket / 4 + 1;
+      return (Uint32) (((5 + (nBucket % 4)) << (nOctave - 2)) - 1);
+   };
+
+   static Uint32 getPercentile(const Uint32* pCounts, Uint32 nSamples, Uint32 nPercent, Uint32 nMaxUs)
+   {
+      if (nSamples == 0)
+      {
+         return 0;
+      }
+      Uint32 nRank = (Uint32) (((double) nSamples * nPercent + 99) / 100);     // Rounded up, at least 1
+      Uint32 nCount = 0;
+      for (int b = 0; b < BUCKETS; b++)
+      {
+         nCount += pCounts[b];
+         if (nCount >= nRank)
+         {
+            Uint32 nUs = (b < BUCKETS - 1) ? getBucketMax(b) : nMaxUs;     // The last bucket has no upper bound
+            return (nUs < nMaxUs) ? nUs : nMaxUs;
+         }
+      }
+      return nMaxUs;
+   };
+
+
+private: // Data Members
+
+   struct Histogram
+   {
+      std::atomic<Uint32>  nCounts[BUCKETS];
+      std::atomic<Uint32>  nItems;
+      std::atomic<Uint32>  nMaxUs;
+   };
+
+   Histogram            m_histograms[STAGE_COUNT];
+   std::atomic<bool>    m_bEnabled;
+};
+
+
+/** Times the scope it is declared in as a stage of the stats (if given and enabled) */
+class RVStageTimer
+{
+public: // Constructor/Destructor
+
+   RVStageTimer(RVStageStats* pStats, RVStageStats::Stage nStage)
+   {
+      m_pStats = ((pStats != NULL) && pStats->isEnabled()) ? pStats : NULL;
+      m_nStage = nStage;
+      m_nItems = 0;
+      if (m_pStats != NULL)
+      {
+         m_start = std::chrono::steady_clock::now();
+      }
+   };
+
+   ~RVStageTimer()
+   {
+      if (m_pStats != NULL)
+      {
+         std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - m_start;
+         m_pStats->record(m_nStage, (Uint32) std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(), m_nItems);
+      }
+   };
+
+
+public: // Items
+
+   void addItems(Uint32 nItems) { m_nItems += nItems; };
+
+
+private: // Data Members
+
+   RVStageStats*                          m_pStats;         // NULL if not recording
+   RVStageStats::Stage                    m_nStage;
+   Uint32                                 m_nItems;
+   std::chrono::steady_clock::time_point  m_start;
+};
+
+
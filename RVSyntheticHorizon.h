@@ -0,0 +1,404 @@
+/**
+ * @file    RVSyntheticHorizon.h
+ * @brief   Horizon source generated from parameters, to drive the road model builder without a map.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The Horizon is a straight MPP of Params::nLinks links carrying the attributes RVRoadModelBuilder reads: number
+ * of lanes at each link start (changing on some links), ADAS lanes, one way and speed limits, crossings at link
+ * ends with their branches, tunnel and roundabout runs, and Traffic Signs drawn from a mix of types. It is random
+ * but reproducible: the same Params (and seed) give the same Horizon and the same updates.
+ *
+ * generate() builds the first Horizon, advance() moves the car on along the MPP, dropping the links left behind
+ * and adding new ones at the end, as the AH does between two position messages. A run at a given size, e.g.
+ *
+ *    RVSyntheticHorizon::Params params;
+ *    params.nLinks = RVSyntheticHorizon::getLinksFor(params, 100000);     // About 100000 attributes
+ *    horizon.generate(params);
+ *    builder.setStageStats(&stats);                                       // items of scanHorizon = attributes
+ *    for (int i = 0; i < 100; i++, horizon.advance(1000))
+ *       builder.scanHorizon(horizon, false);
+ *
+ * times scanHorizon() per attribute in the STAGE_SCAN_HORIZON histogram of RVStageStats.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "RVHorizonSource.h"
+
+class RVSyntheticHorizon : public RVHorizonSource
+{
+public: // Constants
+
+   struct Params
+   {
+      Uint32            nLinks;                 // Links on the MPP
+      Sint32            nLinkLengthCM;          // Mean link length, the lengths are spread over 50%..150% of it
+      Uint32            nBranches;              // Child links at a crossing, besides the next link of the MPP
+      Uint32            nSignsPerLink;          // Mean number of Traffic Sign attributes on a link
+      std::vector<int>  signTypes;              // Attribute types of the signs, empty for getDefaultSignTypes()
+      Uint32            nLaneChangePercent;     // Links starting with another number of lanes
+      Uint32            nCrossingPercent;       // Links ending at a crossing
+      Uint32            nProhibitedPercent;     // Branches of a crossing which are prohibited (wrong way)
+      Uint32            nTunnelPercent;         // Links in a tunnel, in runs of 1..4 links
+      Uint32            nRoundaboutPercent;     // Links on a roundabout, in runs of 1..4 links
+      bool              bRightSideDrive;
+      Uint32            nSeed;
+
+      Params()
+      {
+         nLinks = 200;
+         nLinkLengthCM = 5000;
+         nBranches = 2;
+         nSignsPerLink = 1;
+         nLaneChangePercent = 10;
+         nCrossingPercent = 30;
+         nProhibitedPercent = 10;
+         nTunnelPercent = 2;
+         nRoundaboutPercent = 2;
+         bRightSideDrive = true;
+         nSeed = 1;
+      };
+   };
+
+   /** First id of the branches, which are never on the MPP */
+   static const Uint32 BRANCH_ID_BASE = 0x80000000;
+
+
+public: // Constructor/Destructor
+
+   RVSyntheticHorizon()
+   {
+      m_nCarCM = 0;
+      m_nFirst = 0;
+      m_nRandom = 1;
+      m_nNextLinkId = 1;
+      m_nNextBranchId = BRANCH_ID_BASE;
+      m_nLanes = 2;
+      m_nTunnelRun = 0;
+      m_nRoundaboutRun = 0;
+   };
+
+
+public: // Generation
+
+   /** Builds the first Horizon, the car being on the first quarter of the root link */
+   void generate(const Params& params)
+   {
+      m_params = params;
+      if (m_params.signTypes.empty())
+      {
+         m_params.signTypes = getDefaultSignTypes();
+      }
+      m_nRandom = (params.nSeed != 0) ? params.nSeed : 1;
+      m_nNextLinkId = 1;
+      m_nNextBranchId = BRANCH_ID_BASE;
+      m_nLanes = 2;
+      m_nTunnelRun = 0;
+      m_nRoundaboutRun = 0;
+      m_links.clear();
+      m_nFirst = 0;
+      addLinks();
+      m_nCarCM = m_links.front().nLengthCM / 4;
+      buildNearest();
+   };
+
+   /** Moves the car on along the MPP: the links left behind are dropped and as many links are added at the end */
+   void advance(Sint32 nDistCM)
+   {
+      m_nCarCM += nDistCM;
+      while ((m_links.size() - m_nFirst > 1) && (m_links[m_nFirst].nStartCM + m_links[m_nFirst].nLengthCM <= m_nCarCM))
+      {
+         m_nFirst++;
+      }
+      if (m_nFirst >= m_links.size() / 2)     // The links left behind are dropped once they are half of the links
+      {
+         m_links.erase(m_links.begin(), m_links.begin() + m_nFirst);
+         m_nFirst = 0;
+      }
+      addLinks();
+      buildNearest();
+   };
+
+   /** Number of MPP links giving about nAttributes attributes with the other parameters */
+   static Uint32 getLinksFor(const Params& params, Uint32 nAttributes)
+   {
+      // Number of lanes, ADAS lanes, one way or opposite lanes and speed limit on each link, plus the optional ones
+      Uint32 nPerLinkPercent = 400 + 100 * params.nSignsPerLink + params.nCrossingPercent + params.nTunnelPercent + params.nRoundaboutPercent;
+      Uint32 nLinks = (Uint32) (((ULONGLONG) nAttributes * 100 + nPerLinkPercent - 1) / nPerLinkPercent);
+      return (nLinks > 0) ? nLinks : 1;
+   };
+
+   /** Common Traffic Signs: speed limits, overtaking, curves, crossings, lanes, prohibitions */
+   static const std::vector<int>& getDefaultSignTypes()
+   {
+      static const int TYPES[] = {
+         ADAS::ahatTSSpeedLimit, ADAS::ahatTSSpeedLimit, ADAS::ahatTSOvertakeCC, ADAS::ahatTSSharpCurveLeft, ADAS::ahatTSSharpCurveRight,
+         ADAS::ahatTSPedestrianCrosswalk, ADAS::ahatTSYield, ADAS::ahatTSStop, ADAS::ahatTSSteepDownhill, ADAS::ahatTSSignLanes,
+         ADAS::ahatTSSignLaneMergeRight, ADAS::ahatTSEndOfAllProhibitions, ADAS::ahatTSRailwayCrossingGates
+      };
+      static const std::vector<int> types(TYPES, TYPES + sizeof(TYPES) / sizeof(TYPES[0]));
+      return types;
+   };
+
+
+public: // RVHorizonSource
+
+   virtual void getMostProbablePath(std::vector<Uint32>& mpp)
+   {
+      for (size_t i = m_nFirst; i < m_links.size(); i++)
+      {
+         mpp.push_back(m_links[i].nLinkId);
+      }
+   };
+
+   virtual Sint32 getLinkLengthCM(Uint32 nLinkId)
+   {
+      const Link* pLink = findLink(nLinkId);
+      return (pLink != NULL) ? pLink->nLengthCM : 0;
+   };
+
+   virtual bool isInCity(Uint32 nLinkId)
+   {
+      const Link* pLink = findLink(nLinkId);
+      return (pLink != NULL) ? pLink->bInCity : false;
+   };
+
+   virtual bool isRightSideDrive(Uint32 /*nLinkId*/)
+   {
+      return m_params.bRightSideDrive;
+   };
+
+   virtual void getBranches(Uint32 nLinkId, std::vector<RVBranch>& branches)
+   {
+      const Link* pLink = findLink(nLinkId);
+      if (pLink != NULL)
+      {
+         branches.insert(branches.end(), pLink->branches.begin(), pLink->branches.end());
+      }
+   };
+
+   virtual Uint32 getAttributeCount()
+   {
+      return (Uint32) m_nearest.size();
+   };
+
+   virtual Sint32 getNearestAttribute(Uint32 nIndex, Float64* pfProbability, ADAS::HorizonAttribute* pAttr)
+   {
+      const Nearest& nearest = m_nearest[nIndex];
+      *pfProbability = 1.0;
+      *pAttr = m_links[nearest.nLink].attrs[nearest.nAttr];
+      return nearest.nDistCM;
+   };
+
+   virtual void getLinkAttributes(Uint32 nLinkId, std::vector<ADAS::HorizonAttribute>& attrs)
+   {
+      const Link* pLink = findLink(nLinkId);
+      if (pLink != NULL)
+      {
+         attrs.insert(attrs.end(), pLink->attrs.begin(), pLink->attrs.end());
+      }
+   };
+
+
+private: // Worker methods
+
+   struct Link;
+
+   /** The link ids of the MPP are consecutive */
+   const Link* findLink(Uint32 nLinkId) const
+   {
+      if ((m_nFirst >= m_links.size()) || (nLinkId < m_links[m_nFirst].nLinkId) || (nLinkId - m_links[m_nFirst].nLinkId >= m_links.size() - m_nFirst))
+      {
+         return NULL;
+      }
+      return &m_links[m_nFirst + nLinkId - m_links[m_nFirst].nLinkId];
+   };
+
+   void addLinks()
+   {
+      while (m_links.size() - m_nFirst < m_params.nLinks)
+      {
+         LONGLONG nStartCM = m_links.empty() ? 0 : m_links.back().nStartCM + m_links.back().nLengthCM;
+         m_links.push_back(Link());
+         addLink(m_links.back(), nStartCM);
+      }
+   };
+
+   void addLink(Link& link, LONGLONG nStartCM)
+   {
+      link.nLinkId = m_nNextLinkId++;
+      link.nStartCM = nStartCM;
+      link.nLengthCM = m_params.nLinkLengthCM / 2 + (Sint32) getRandom((Uint32) m_params.nLinkLengthCM + 1);
+      Uint32 nSpeed = 30 + 10 * getRandom(11);
+      link.bInCity = (nSpeed <= 50);
+
+      // Number of lanes at the link start, and the ADAS lanes, one way and speed limit of the link
+      Uint32 nPreviousLanes = m_nLanes;
+      if (isRandom(m_params.nLaneChangePercent))
+      {
+         m_nLanes = (m_nLanes <= 1) ? 2 : ((m_nLanes >= 4) ? 3 : m_nLanes + (getRandom(2) ? 1 : -1));
+      }
+      addAttribute(link, ADAS::ahatNumberOfLanesFromSC, m_nLanes | (nPreviousLanes << 16), 0, 0);
+      addAttribute(link, ADAS::ahatADASNumberOfLanes, m_nLanes, 0, link.nLengthCM);
+      if (m_nLanes >= 3)
+      {
+         addAttribute(link, ADAS::ahatRightWay, 0, 0, link.nLengthCM);
+      }
+      else
+      {
+         addAttribute(link, ADAS::ahatADASOppositeNumberOfLanes, m_nLanes, 0, link.nLengthCM);
+      }
+      addAttribute(link, ADAS::ahatCurrentSpeed, nSpeed, 0, link.nLengthCM);
+
+      // Tunnels and roundabouts cover runs of links
+      if ((m_nTunnelRun == 0) && isRandom(m_params.nTunnelPercent))
+      {
+         m_nTunnelRun = 1 + getRandom(4);
+      }
+      if ((m_nRoundaboutRun == 0) && (m_nTunnelRun == 0) && isRandom(m_params.nRoundaboutPercent))
+      {
+         m_nRoundaboutRun = 1 + getRandom(4);
+      }
+      if (m_nTunnelRun > 0)
+      {
+         addAttribute(link, ADAS::ahatTunnel, 0, 0, link.nLengthCM);
+         m_nTunnelRun--;
+      }
+      else if (m_nRoundaboutRun > 0)
+      {
+         addAttribute(link, ADAS::ahatRoundabout, 0, 0, link.nLengthCM);
+         m_nRoundaboutRun--;
+      }
+
+      // Traffic Signs anywhere on the link
+      Uint32 nSigns = getRandom(2 * m_params.nSignsPerLink + 1);
+      for (Uint32 i = 0; i < nSigns; i++)
+      {
+         addSign(link);
+      }
+
+      // Crossing at the link end: the next MPP link goes straight on, the branches turn left or right
+      link.branches.clear();
+      if (isRandom(m_params.nCrossingPercent))
+      {
+         static const ADAS::AttributeType CROSSINGS[] = { ADAS::ahatCrossingSame, ADAS::ahatCrossingSmall, ADAS::ahatCrossingBig };
+         addAttribute(link, CROSSINGS[getRandom(3)], 0, link.nLengthCM, 0);
+         RVBranch next = { link.nLinkId + 1, 0, 1.0 };
+         link.branches.push_back(next);
+         for (Uint32 i = 0; i < m_params.nBranches; i++)
+         {
+            int nAngle = 20 + (int) getRandom(140);
+            RVBranch branch = { m_nNextBranchId++, getRandom(2) ? nAngle : -nAngle, isRandom(m_params.nProhibitedPercent) ? 0.0 : 0.5 };
+            link.branches.push_back(branch);
+         }
+      }
+
+      std::stable_sort(link.attrs.begin(), link.attrs.end(), isBeforeOnLink);
+   };
+
+   void addSign(Link& link)
+   {
+      int nType = m_params.signTypes[getRandom((Uint32) m_params.signTypes.size())];
+      union ADAS::TrafficSignInfo tsi;
+      tsi.unit = 0;
+      tsi.bits.m_validityFlag = getRandom(3);      // None, start or duration
+      tsi.bits.m_nNumber = (nType == ADAS::ahatTSSpeedLimit) ? 30 + 10 * getRandom(11) : 5 + getRandom(11);
+      Sint32 nValidityCM = 100 * (10 + (Sint32) getRandom(500));
+      addAttribute(link, (ADAS::AttributeType) nType, tsi.unit, (Sint32) getRandom((Uint32) link.nLengthCM + 1), nValidityCM, !isRandom(20));
+   };
+
+   void addAttribute(Link& link, ADAS::AttributeType nType, Uint32 nInfo, Sint32 nOffsetCM, Sint32 nLengthCM, bool bIsStart = true)
+   {
+      ADAS::HorizonAttribute ahat;
+      ahat.nLinkId = link.nLinkId;
+      ahat.type = nType;
+      ahat.info = nInfo;
+      ahat.nLengthCM = nLengthCM;
+      ahat.nOffsetCM = nOffsetCM;
+      ahat.bIsStart = bIsStart;
+      link.attrs.push_back(ahat);
+   };
+
+   static bool isBeforeOnLink(const ADAS::HorizonAttribute& a, const ADAS::HorizonAttribute& b)
+   {
+      return a.nOffsetCM < b.nOffsetCM;
+   };
+
+   /** Orders the attributes by distance from the car, as the AH returns them. Behind the car on the root link they
+       are at negative distances. */
+   void buildNearest()
+   {
+      m_nearest.clear();
+      for (size_t nLink = m_nFirst; nLink < m_links.size(); nLink++)
+      {
+         const Link& link = m_links[nLink];
+         for (size_t nAttr = 0; nAttr < link.attrs.size(); nAttr++)
+         {
+            Nearest nearest;
+            nearest.nDistCM = (Sint32) (link.nStartCM + link.attrs[nAttr].nOffsetCM - m_nCarCM);
+            nearest.nLink = (Uint32) nLink;
+            nearest.nAttr = (Uint32) nAttr;
+            m_nearest.push_back(nearest);
+         }
+      }
+      std::stable_sort(m_nearest.begin(), m_nearest.end(), isNearer);
+   };
+
+   struct Nearest;
+   static bool isNearer(const Nearest& a, const Nearest& b)
+   {
+      return abs(a.nDistCM) < abs(b.nDistCM);
+   };
+
+   /** xorshift32: reproducible on all platforms, independent of rand() */
+   Uint32 getRandom(Uint32 nRange)
+   {
+      m_nRandom ^= m_nRandom << 13;
+      m_nRandom ^= m_nRandom >> 17;
+      m_nRandom ^= m_nRandom << 5;
+      return (nRange > 0) ? m_nRandom % nRange : 0;
+   };
+
+   bool isRandom(Uint32 nPercent)
+   {
+      return getRandom(100) < nPercent;
+   };
+
+
+private: // Data Members
+
+   struct Link
+   {
+      Uint32                              nLinkId;
+      LONGLONG                            nStartCM;      // From the start of the first generated link
+      Sint32                              nLengthCM;
+      bool                                bInCity;
+      std::vector<ADAS::HorizonAttribute> attrs;         // By offset on the link
+      std::vector<RVBranch>               branches;
+   };
+
+   struct Nearest
+   {
+      Sint32   nDistCM;
+      Uint32   nLink;         // Index in m_links
+      Uint32   nAttr;         // Index in the attributes of the link
+   };
+
+   Params               m_params;
+   std::vector<Link>    m_links;             // Root link at m_nFirst, then the MPP
+   size_t               m_nFirst;            // Links before it have been left behind
+   std::vector<Nearest> m_nearest;
+   LONGLONG             m_nCarCM;            // Car position, from the start of the first generated link
+   Uint32               m_nRandom;
+   Uint32               m_nNextLinkId;
+   Uint32               m_nNextBranchId;
+   Uint32               m_nLanes;            // Number of lanes at the end of the last link
+   Uint32               m_nTunnelRun;        // Links left in the current tunnel
+   Uint32               m_nRoundaboutRun;
+};
+
+
@@ -0,0 +1,134 @@
+/**
+ * @file    RVTypes.h
+ * @brief   Types used by the road model and the display list, with or without MFC.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The plug-in gets them from stdafx.h (MFC, Win32, EHPI and the ADASRP libraries). With RV_HEADLESS defined,
+ * the builder, the replay and the software backend are compiled without them, e.g. by the tests and the
+ * benchmarks of tests/: this header then declares the subset they use, with the same names and values.
+ */
+
+
+#pragma once
+
+#ifndef RV_HEADLESS
+
+#include "stdafx.h"
+
+#else
+
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+/////////////
+// ADASRP/EHPI
+
+typedef uint8_t            Uint8;
+typedef uint16_t           Uint16;
+typedef uint32_t           Uint32;
+typedef int16_t            Sint16;
+typedef int32_t            Sint32;
+typedef double             Float64;
+
+//////
+// Win32
+
+typedef unsigned int       UINT;
+typedef unsigned char      BYTE;
+typedef unsigned short     WORD;
+typedef unsigned long      DWORD;
+typedef long               LONG;
+typedef long long          LONGLONG;
+typedef unsigned long long ULONGLONG;
+typedef DWORD              COLORREF;
+
+struct POINT { LONG x; LONG y; };
+struct RECT  { LONG left; LONG top; LONG right; LONG bottom; };
+
+#define RGB(r, g, b)       ((COLORREF) (((BYTE) (r) | ((WORD) ((BYTE) (g)) << 8)) | (((DWORD) (BYTE) (b)) << 16)))
+#define GetRValue(rgb)     ((BYTE) (rgb))
+#define GetGValue(rgb)     ((BYTE) (((WORD) (rgb)) >> 8))
+#define GetBValue(rgb)     ((BYTE) ((rgb) >> 16))
+
+#define HS_BDIAGONAL       3
+
+//////////////
+// Traffic Signs
+
+class TrafficSign
+{
+public:
+   enum Sign {
+      tsInvalid = -1, tsLanesInc, tsLanesIncRight, tsLanesDec, tsLanesDecRight, tsLanesDecCenter, tsLanes, tsCrossing,
+      tsPriorityCrossing, tsGiveWay, tsTunnel, tsRoundabout, tsPedestrian, tsPedestrianCrossing, tsTrafficLight,
+      tsRightOfWay, tsUrbanAreaEnd, tsStop, tsWarning, tsLeftTurn, tsRightTurn, tsSCurveLeft, tsSCurveRight,
+      tsUnevenRoad, tsIcyRoad, tsSlipperyRoad, tsFallingRocks, tsRoadNarrowingLeft, tsRoadNarrowingRight,
+      tsRoadNarrowingBothSides, tsTrafficCongestion, tsAnimals, tsChildren, tsOvertakeAllowed, tsOvertakeProhibited,
+      tsOvertakeTCAllowed, tsOvertakeTCProhibited, tsEndOfAllProhibitions, tsEndPriorityRoad, tsRailwayCrossingGates,
+      tsRailwayCrossingNoGates, tsTramway, tsRailwayCrossing, tsCompulsoryRoundabout, tsCrossWind, tsAccidentHazard,
+      tsRiskOfGrounding, tsPriorityOncomingTraffic, tsYieldOncomingTraffic, tsSlope, tsSlopeNeg, tsSpeedLimit,
+      tsSpeedLimitEnd, tsFree, tsPrivate, tsUrbanArea, tsExpectedSpeedLimit
+   };
+};
+
+namespace TrafficSignView
+{
+   struct Hint
+   {
+      TrafficSign::Sign sign;
+      UINT              param;
+      bool              bIsSign;
+   };
+}
+
+//////////////////
+// Horizon (ADAS)
+
+namespace ADAS
+{
+   enum AttributeType {
+      ahatNumberOfLanesFromSC, ahatCrossingSame, ahatCrossingSmall, ahatCrossingBig, ahatTunnel, ahatRoundabout,
+      ahatADASNumberOfLanes, ahatRightWay, ahatADASOppositeNumberOfLanes, ahatCurrentSpeed, ahatExpectedSpeedFromSC,
+      ahatTSPedestrianXing, ahatTSPedestrianCrosswalk, ahatTSTrafficLight, ahatTSTrafficLightSign, ahatTSRightofWayRoad,
+      ahatTSRightOfWayCrossing, ahatTSEndOfTown, ahatTSEqualIntersection, ahatTSYield, ahatTSStop, ahatTSWarning,
+      ahatTSSharpCurveLeft, ahatTSSharpCurveRight, ahatTSSCurveLeft, ahatTSSCurveRight, ahatTSUnevenRoad, ahatTSIcyRoad,
+      ahatTSSlipperyRoad, ahatTSFallingRocks, ahatTSRoadNarrowingLeft, ahatTSRoadNarrowingRight,
+      ahatTSRoadNarrowingBothSides, ahatTSTrafficCongestion, ahatTSAnimals, ahatTSChildren, ahatTSOvertakeCC,
+      ahatTSOvertakeTC, ahatTSEndOfAllProhibitions, ahatTSEndPriorityRoad, ahatTSRailwayCrossingGates,
+      ahatTSRailwayCrossingNoGates, ahatTSTramway, ahatTSRailwayCrossing, ahatTSCompulsoryRoundabout, ahatTSCrossWind,
+      ahatTSAccidentHazard, ahatTSRiskOfGrounding, ahatTSPriorityOncomingTraffic, ahatTSYieldOncomingTraffic,
+      ahatTSSteepUphill, ahatTSSteepDownhill, ahatTSSpeedLimit, ahatTSSignLanes, ahatTSSignExtraLaneLeft,
+      ahatTSSignExtraLaneRight, ahatTSSignLaneMergeLeft, ahatTSSignLaneMergeRight, ahatTSSignLaneMergeCenter,
+      ahatCustom3
+   };
+
+   struct HorizonAttribute
+   {
+      Uint32         nLinkId;
+      AttributeType  type;
+      Uint32         info;
+      Sint32         nLengthCM;
+      Sint32         nOffsetCM;
+      bool           bIsStart;
+   };
+
+   namespace TrafficSignValidityFlag
+   {
+      enum E { tsValidityNone, tsValidityStart, tsValidityDuration };
+   }
+
+   union TrafficSignInfo
+   {
+      Uint32 unit;
+      struct
+      {
+         Uint32 m_nNumber        : 16;
+         Uint32 m_validityFlag   : 4;
+      } bits;
+   };
+}
+
+#endif // RV_HEADLESS
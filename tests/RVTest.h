@@ -0,0 +1,50 @@
+/**
+ * @file    RVTest.h
+ * @brief   Checks and timing for the headless tests and benchmarks of the road model.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * Each test is a program: RV_CHECK() reports the failed checks and RV_TEST_RESULT() is returned by main(). The
+ * benchmarks print one line per measurement with RVBenchTimer. The programs are built and run by tests/Makefile.
+ */
+
+
+#pragma once
+
+#include "RVTypes.h"
+
+#include <stdio.h>
+#include <chrono>
+
+int g_nTestFailures = 0;          // Not static: the benchmarks do not use them
+int g_nTestChecks   = 0;
+
+#define RV_CHECK(cond) \
+   do { g_nTestChecks++; if (!(cond)) { g_nTestFailures++; printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #cond); } } while (0)
+
+#define RV_CHECK_EQUAL(expected, actual) \
+   do { g_nTestChecks++; long long nExp = (long long) (expected), nAct = (long long) (actual); \
+        if (nExp != nAct) { g_nTestFailures++; printf("%s(%d): check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #expected, #actual, nExp, nAct); } } while (0)
+
+/** Prints the summary of the checks and returns the exit code of the test */
+#define RV_TEST_RESULT() \
+   (printf("%s: %d checks, %d failed\n", __FILE__, g_nTestChecks, g_nTestFailures), (g_nTestFailures == 0) ? 0 : 1)
+
+
+/** Wall clock time since construction (or restart()) */
+class RVBenchTimer
+{
+public:
+
+   RVBenchTimer() { restart(); };
+
+   void     restart()   { m_start = std::chrono::steady_clock::now(); };
+   double   getMs() const
+   {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+   };
+
+private:
+
+   std::chrono::steady_clock::time_point m_start;
+};
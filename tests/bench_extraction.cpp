@@ -0,0 +1,100 @@
+/**
+ * @file    bench_extraction.cpp
+ * @brief   Cost of the extraction of the road model from synthetic Horizons of 100 to 1,000,000 attributes.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * For each size, the car drives on through an RVSyntheticHorizon and the model is rebuilt at each update, with
+ * incremental updates and with full rebuilds (as after a Clear message). Printed per size: the ns per attribute of
+ * scanHorizon(), and the allocations per update of scanHorizon() and publish() once the first update has sized
+ * the storage. The sizes step by x10 (and x3 in between), so that the cliffs show as jumps of ns/attribute.
+ */
+
+#include "RVTypes.h"
+#include "RVRoadModelBuilder.h"
+#include "RVSyntheticHorizon.h"
+#include "RVTest.h"
+
+#include <stdlib.h>
+#include <new>
+
+static bool   g_bCounting    = false;
+static size_t g_nAllocations = 0;
+
+void* operator new(size_t nSize)
+{
+   if (g_bCounting)
+   {
+      g_nAllocations++;
+   }
+   void* p = malloc((nSize > 0) ? nSize : 1);
+   if (p == NULL)
+   {
+      throw std::bad_alloc();
+   }
+   return p;
+}
+
+void operator delete(void* p) noexcept
+{
+   free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+   free(p);
+}
+
+/** Drives through the Horizon of about nAttributes attributes and prints a line of the curve */
+static void benchSize(Uint32 nAttributes, bool bFullRebuild)
+{
+   RVSyntheticHorizon::Params params;
+   params.nLinks = RVSyntheticHorizon::getLinksFor(params, nAttributes);
+   RVSyntheticHorizon horizon;
+   horizon.generate(params);
+   RVRoadModelBuilder builder;
+   RVModelBuffer buffer;
+
+   // First update: sizes the storage, not measured
+   builder.scanHorizon(horizon, true);
+   builder.publish(buffer);
+   buffer.acquire();
+   horizon.advance(params.nLinkLengthCM / 3);
+
+   double fScanMs = 0;
+   ULONGLONG nScanned = 0;
+   size_t nAllocations = 0;
+   int nUpdates = 0;
+   RVBenchTimer timerTotal;
+   while ((nUpdates < 5) || ((timerTotal.getMs() < 300) && (nUpdates < 1000)))
+   {
+      g_nAllocations = 0;
+      g_bCounting = true;
+      RVBenchTimer timer;
+      builder.scanHorizon(horizon, bFullRebuild);
+      fScanMs += timer.getMs();
+      builder.publish(buffer);
+      buffer.acquire();
+      g_bCounting = false;
+      nAllocations += g_nAllocations;
+      nScanned += builder.getStats().nAttributes;
+      nUpdates++;
+      horizon.advance(params.nLinkLengthCM / 3);
+   }
+   printf("%8u attributes  %-11s  %8.2f ns/attribute  %10.3f ms/update  %6.2f allocations/update  (%d updates)\n",
+          (unsigned) (nScanned / nUpdates), bFullRebuild ? "full" : "incremental", fScanMs * 1e6 / (double) nScanned,
+          fScanMs / nUpdates, (double) nAllocations / nUpdates, nUpdates);
+}
+
+int main()
+{
+   static const Uint32 SIZES[] = { 100, 300, 1000, 3000, 10000, 30000, 100000, 300000, 1000000 };
+   for (int nFull = 0;  nFull < 2;  nFull++)
+   {
+      for (size_t i = 0;  i < sizeof(SIZES) / sizeof(SIZES[0]);  i++)
+      {
+         benchSize(SIZES[i], nFull != 0);
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file    bench_lane_lines.cpp
+ * @brief   Dashed lane lines drawn one line per dash, as the former paintLaneLine(), against one batch per segment.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The road has 4 lanes (3 dashed separators) over the width of the window, cut into 8 or 32 segments (short links
+ * at 1 km scale), with the dash pattern of the Road View (7 on, 10 off). Printed per case: the primitives of the
+ * display list, the GDI calls they cost (a MoveTo/LineTo pair per dash, a PolyPolyline per batch) and the ms per
+ * frame of the replay by RVSoftwareBackend.
+ */
+
+#include "RVTypes.h"
+#include "RVSoftwareBackend.h"
+#include "RVTest.h"
+
+static const int LANES  = 4;
+static const int DASH   = 7;
+static const int GAP    = 10;
+
+/** Lays the lane lines out, per dash or batched */
+static void layout(RVDisplayList& list, int nWidth, int nSegments, bool bBatched)
+{
+   list.clear();
+   list.setStyle(RVDisplayList::STYLE_LINES,      RGB(255, 255, 255), RVStyle::PATTERN_SOLID, 3);
+   list.setStyle(RVDisplayList::STYLE_LINES_DASH, RGB(255, 255, 255), RVStyle::PATTERN_DASH,  3);
+   int xRoad = nWidth / 10;
+   int wSegment = (nWidth - xRoad) / nSegments;
+   for (int nSegment = 0;  nSegment < nSegments;  nSegment++)
+   {
+      int nStart = xRoad + nSegment * wSegment;
+      int nEnd = nStart + wSegment;
+      if (bBatched)
+      {
+         list.beginDashedLines(RVDisplayList::STYLE_LINES_DASH, nStart, nEnd, DASH, GAP);
+         for (int nLane = 1;  nLane < LANES;  nLane++)
+         {
+            list.addPoint(RVDisplayList::getDashPhase(xRoad, DASH, GAP), 100 + 20 * nLane);
+         }
+         continue;
+      }
+      for (int nLane = 1;  nLane < LANES;  nLane++)
+      {
+         // One MoveTo/LineTo per dash, restarting the pattern at the segment start
+         for (int x = nStart;  x < nEnd;  x += DASH + GAP)
+         {
+            list.line(RVDisplayList::STYLE_LINES, x, 100 + 20 * nLane, (std::min)(x + DASH, nEnd), 100 + 20 * nLane);
+         }
+      }
+   }
+}
+
+static void benchCase(int nWidth, int nSegments, bool bBatched)
+{
+   RVDisplayList list;
+   layout(list, nWidth, nSegments, bBatched);
+   Uint32 nGdiCalls = bBatched ? list.getCount(RVDisplayList::CMD_DASHED_LINES) : 2 * list.getCount(RVDisplayList::CMD_LINE);
+
+   RVSoftwareBackend backend;
+   backend.resize(nWidth, 200);
+   backend.clear(RGB(0, 0, 0));
+   int nFrames = 0;
+   RVBenchTimer timer;
+   while ((nFrames < 100) || (timer.getMs() < 200))
+   {
+      backend.replay(list);
+      nFrames++;
+   }
+   printf("%4d px, %2d segments, %-8s: %5u primitives  %5u GDI calls  %8.4f ms/frame\n",
+          nWidth, nSegments, bBatched ? "batched" : "per dash", (unsigned) list.getSize(), (unsigned) nGdiCalls, timer.getMs() / nFrames);
+}
+
+int main()
+{
+   static const int WIDTHS[]   = { 640, 1024, 1920 };
+   static const int SEGMENTS[] = { 8, 32 };
+   for (size_t i = 0;  i < sizeof(WIDTHS) / sizeof(WIDTHS[0]);  i++)
+   {
+      for (size_t j = 0;  j < sizeof(SEGMENTS) / sizeof(SEGMENTS[0]);  j++)
+      {
+         benchCase(WIDTHS[i], SEGMENTS[j], false);
+         benchCase(WIDTHS[i], SEGMENTS[j], true);
+      }
+   }
+   return 0;
+}
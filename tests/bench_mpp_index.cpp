@@ -0,0 +1,80 @@
+/**
+ * @file    bench_mpp_index.cpp
+ * @brief   Lookups of RVMppIndex against the linear scan of the MPP they replaced, on MPPs of 10 to 10,000 links.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The MPP link ids are scattered as map link ids are; half of the looked up ids are on the MPP (the links of the
+ * attributes), half are not (the branches of getCrossingSide()). Printed per MPP size: the build time of the index
+ * and the ns per lookup of the index and of std::find() over the MPP vector.
+ */
+
+#include "RVTypes.h"
+#include "RVMppIndex.h"
+#include "RVTest.h"
+
+#include <algorithm>
+#include <vector>
+
+static const int LOOKUPS = 200000;
+
+static Uint32 random(Uint32& nState)
+{
+   nState = nState * 1103515245 + 12345;
+   return nState >> 8;
+}
+
+static void benchSize(int nLinks)
+{
+   Uint32 nState = 1;
+   std::vector<Uint32> mpp(nLinks);
+   for (int i = 0;  i < nLinks;  i++)
+   {
+      mpp[i] = 1000000 + 7 * i + random(nState) % 5;     // Increasing with gaps, as along a road of a map
+   }
+   std::vector<Uint32> ids(LOOKUPS);
+   for (int i = 0;  i < LOOKUPS;  i++)
+   {
+      ids[i] = ((i % 2) == 0) ? mpp[random(nState) % nLinks] : 0x80000000 + random(nState) % 100000;
+   }
+
+   RVMppIndex index;
+   int nBuilds = (std::max)(100000 / nLinks, 10);
+   RVBenchTimer timer;
+   for (int i = 0;  i < nBuilds;  i++)
+   {
+      index.build(mpp);
+   }
+   double fBuildUs = timer.getMs() * 1000.0 / nBuilds;
+
+   int nFound = 0;
+   timer.restart();
+   for (int i = 0;  i < LOOKUPS;  i++)
+   {
+      nFound += (index.getPosition(ids[i]) >= 0) ? 1 : 0;
+   }
+   double fIndexNs = timer.getMs() * 1e6 / LOOKUPS;
+
+   // The linear scan is run on fewer lookups on long MPPs
+   int nLinear = (std::min)(LOOKUPS, (std::max)(2000, 20000000 / nLinks));
+   int nFoundLinear = 0;
+   timer.restart();
+   for (int i = 0;  i < nLinear;  i++)
+   {
+      nFoundLinear += (std::find(mpp.begin(), mpp.end(), ids[i]) != mpp.end()) ? 1 : 0;
+   }
+   double fLinearNs = timer.getMs() * 1e6 / nLinear;
+
+   printf("%6d links: build %9.2f us   index %7.2f ns/lookup   linear %10.2f ns/lookup   (%d%% / %d%% on the MPP)\n",
+          nLinks, fBuildUs, fIndexNs, fLinearNs, nFound * 100 / LOOKUPS, nFoundLinear * 100 / nLinear);
+}
+
+int main()
+{
+   static const int SIZES[] = { 10, 30, 100, 300, 1000, 3000, 10000 };
+   for (size_t i = 0;  i < sizeof(SIZES) / sizeof(SIZES[0]);  i++)
+   {
+      benchSize(SIZES[i]);
+   }
+   return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file    bench_sign_dedup.cpp
+ * @brief   Removal of the duplicated Traffic Sign areas: the erase loop it replaced against the std::unique pass.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The sign sets are sorted as by RVRoadModelBuilder::sortTSAreas(), with each sign posted 1 to 8 times at the
+ * same position (both sides, over every lane of a gantry). Printed per set: the ms of both removals. Both must keep
+ * the same areas (the first of each run of duplicates).
+ */
+
+#include "RVTypes.h"
+#include "RVAreas.h"
+#include "RVTest.h"
+
+#include <algorithm>
+#include <vector>
+
+/** Removal of the baseline getTSAreas(): one erase per duplicate */
+static void eraseLoop(std::vector<RVAreas>& areas)
+{
+   int iSign = 0;
+   while (iSign < (int) areas.size() - 1)
+   {
+      if ((areas[iSign].getStart() == areas[iSign + 1].getStart()) && (areas[iSign].getSign() == areas[iSign + 1].getSign()))
+      {
+         areas.erase(areas.begin() + iSign + 1);
+      }
+      else
+      {
+         iSign++;
+      }
+   }
+}
+
+static bool isSame(const std::vector<RVAreas>& a, const std::vector<RVAreas>& b)
+{
+   if (a.size() != b.size())
+   {
+      return false;
+   }
+   for (size_t i = 0; i < a.size(); i++)
+   {
+      if ((a[i] < b[i]) || (b[i] < a[i]))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+/** nSigns signs, each posted nPosted times, with a different width so that the first one kept can be told apart */
+static void benchSet(int nSigns, int nPosted)
+{
+   std::vector<RVAreas> sorted;
+   sorted.reserve(nSigns * nPosted);
+   for (int i = 0; i < nSigns; i++)
+   {
+      for (int j = 0; j < nPosted; j++)
+      {
+         sorted.push_back(RVAreas((TrafficSign::Sign) (i % 7 + 1), 2000 * (i / 7), 2000 * (i / 7) + 50000, 3 + j, i % 3));
+      }
+   }
+   std::sort(sorted.begin(), sorted.end());
+
+   std::vector<RVAreas> unique(sorted);
+   RVBenchTimer timer;
+   unique.erase(std::unique(unique.begin(), unique.end(), RVAreas::isSameSign), unique.end());
+   double fUniqueMs = timer.getMs();
+
+   std::vector<RVAreas> erased(sorted);
+   timer.restart();
+   eraseLoop(erased);
+   double fLoopMs = timer.getMs();
+
+   printf("%7d areas (%6d signs x %d): erase loop %10.3f ms   unique %8.3f ms\n", (int) sorted.size(), nSigns, nPosted, fLoopMs, fUniqueMs);
+   RV_CHECK(isSame(unique, erased));
+}
+
+int main()
+{
+   static const int SIGNS[]  = { 100, 1000, 10000 };
+   static const int POSTED[] = { 1, 2, 4, 8 };
+   for (size_t i = 0; i < sizeof(SIGNS) / sizeof(SIGNS[0]); i++)
+   {
+      for (size_t j = 0; j < sizeof(POSTED) / sizeof(POSTED[0]); j++)
+      {
+         benchSet(SIGNS[i], POSTED[j]);
+      }
+   }
+   return RV_TEST_RESULT();
+}
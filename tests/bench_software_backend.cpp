@@ -0,0 +1,119 @@
+/**
+ * @file    bench_software_backend.cpp
+ * @brief   Frames per second of RVSoftwareBackend at common window sizes.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The frame is a display list laid out as the Road View does at 1 km scale on a 4-lane road: 8 road segments with
+ * their edge lines and batched dashed lane lines, a hatched complex intersection, tunnel and sign areas, a lane
+ * increase polygon, the car arrow, 6 Traffic Signs and their distances. Each frame clears the canvas and replays
+ * the whole list.
+ */
+
+#include "RVTypes.h"
+#include "RVSoftwareBackend.h"
+#include "RVTest.h"
+
+#include <math.h>
+
+static const int LANES     = 4;
+static const int SEGMENTS  = 8;
+
+static void setStyles(RVDisplayList& list)
+{
+   list.setStyle(RVDisplayList::STYLE_ROAD,            RGB(  0,   0,   0), RVStyle::PATTERN_SOLID, 1);
+   list.setStyle(RVDisplayList::STYLE_LINES,           RGB(255, 255, 255), RVStyle::PATTERN_SOLID, 3);
+   list.setStyle(RVDisplayList::STYLE_LINES_DASH,      RGB(255, 255, 255), RVStyle::PATTERN_DASH,  3);
+   list.setStyle(RVDisplayList::STYLE_ARROW,           RGB(210, 210, 210), RVStyle::PATTERN_SOLID, 1);
+   list.setStyle(RVDisplayList::STYLE_COMPLEX,         RGB(255,   0,   0), RVStyle::PATTERN_HATCH, 1);
+   list.setStyle(RVDisplayList::STYLE_AREA_ROUNDABOUT, RGB(220, 170, 170), RVStyle::PATTERN_SOLID, 1);
+   list.setStyle(RVDisplayList::STYLE_AREA_TUNNEL,     RGB( 78, 177, 130), RVStyle::PATTERN_SOLID, 1);
+   list.setStyle(RVDisplayList::STYLE_AREA_SIGNS,      RGB(  0, 172, 255), RVStyle::PATTERN_SOLID, 1);
+   list.setStyle(RVDisplayList::STYLE_POLE,            RGB(170, 170, 170), RVStyle::PATTERN_SOLID, 1);
+   list.setStyle(RVDisplayList::STYLE_POLE_DOTTED,     RGB(170, 170, 170), RVStyle::PATTERN_DOT,   1);
+   list.setStyle(RVDisplayList::STYLE_DEBUG,           RGB(255, 127,   0), RVStyle::PATTERN_SOLID, 1);
+}
+
+/** Lays a Road View frame of nWidth x nHeight pixels out */
+static void layoutFrame(RVDisplayList& list, int nWidth, int nHeight)
+{
+   list.clear();
+   int yTop     = nHeight * 2 / 5;
+   int wLane    = (std::max)(nHeight / 12, 4);
+   int yBottom  = yTop + LANES * wLane;
+   int xCar     = nWidth / 10;
+   int wSegment = (nWidth - xCar) / SEGMENTS;
+
+   list.fillRect(RVDisplayList::STYLE_AREA_TUNNEL, xCar + wSegment, yTop - wLane, 3 * wSegment, wLane / 2);
+   list.fillRect(RVDisplayList::STYLE_AREA_SIGNS, xCar, yTop - wLane / 2, nWidth - xCar, wLane / 3);
+   for (int nSegment = 0;  nSegment < SEGMENTS;  nSegment++)
+   {
+      int x1 = xCar + nSegment * wSegment;
+      int x2 = x1 + wSegment;
+      list.fillRect((nSegment == 5) ? RVDisplayList::STYLE_COMPLEX : RVDisplayList::STYLE_ROAD, x1, yTop, wSegment, yBottom - yTop);
+      list.line(RVDisplayList::STYLE_LINES, x1, yTop, x2, yTop);
+      list.line(RVDisplayList::STYLE_LINES, x1, yBottom, x2, yBottom);
+      list.beginDashedLines(RVDisplayList::STYLE_LINES_DASH, x1, x2, 7, 10);
+      for (int nLane = 1;  nLane < LANES;  nLane++)
+      {
+         list.addPoint(xCar, yTop + nLane * wLane);
+      }
+   }
+
+   // Lane increase at the end of the 3rd segment: quarter arc from the road edge to one lane further
+   int xArc = xCar + 3 * wSegment;
+   list.beginPolygon(RVDisplayList::STYLE_ROAD);
+   for (int i = 0;  i <= 16;  i++)
+   {
+      double fAngle = i * 3.14159265358979 / 32;
+      list.addPoint(xArc + (int) (wSegment * sin(fAngle)), yBottom + wLane - (int) (wLane * cos(fAngle)));
+   }
+   list.addPoint(xArc + wSegment, yBottom);
+   list.addPoint(xArc, yBottom);
+
+   // Car arrow
+   list.beginPolygon(RVDisplayList::STYLE_ARROW);
+   list.addPoint(xCar - 2 * wLane, yTop + wLane / 4);
+   list.addPoint(xCar, yTop + wLane / 2);
+   list.addPoint(xCar - 2 * wLane, yTop + 3 * wLane / 4);
+
+   // Traffic Signs and their distances
+   for (int nSign = 0;  nSign < 6;  nSign++)
+   {
+      int x = xCar + (nSign + 1) * (nWidth - xCar) / 7;
+      list.line(RVDisplayList::STYLE_POLE, x, yTop - 2 * wLane, x, yTop);
+      list.sign(x - wLane, yTop - 4 * wLane, x + wLane, yTop - 2 * wLane, 0, 0, 100 * nSign, false);
+      list.text(RVDisplayList::STYLE_POLE, x, yBottom + wLane, "250 m");
+   }
+}
+
+/** Prints the frames per second of the replay at the size */
+static void benchSize(int nWidth, int nHeight)
+{
+   RVDisplayList list;
+   setStyles(list);
+   layoutFrame(list, nWidth, nHeight);
+
+   RVSoftwareBackend backend;
+   backend.resize(nWidth, nHeight);
+   int nFrames = 0;
+   RVBenchTimer timer;
+   while ((nFrames < 20) || (timer.getMs() < 500))
+   {
+      backend.clear(RGB(255, 255, 255));
+      backend.replay(list);
+      nFrames++;
+   }
+   double fMs = timer.getMs();
+   printf("%4d x %4d: %8.1f frames/s  (%.3f ms/frame, %u commands)\n", nWidth, nHeight, nFrames * 1000.0 / fMs, fMs / nFrames, (unsigned) list.getSize());
+}
+
+int main()
+{
+   benchSize(640, 480);
+   benchSize(800, 300);
+   benchSize(1024, 768);
+   benchSize(1280, 720);
+   benchSize(1920, 1080);
+   return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file    test_allocations.cpp
+ * @brief   Checks that the updates of the road model do not allocate in the steady state.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The global operator new is replaced by a counting one. The car drives on through a synthetic Horizon of constant
+ * size: once the storage has grown to the largest Horizon seen, scanHorizon() and publish() must not allocate.
+ * The allocations of RVSyntheticHorizon::advance() are not counted.
+ */
+
+#include "RVTypes.h"
+#include "RVRoadModelBuilder.h"
+#include "RVSyntheticHorizon.h"
+#include "RVTest.h"
+
+#include <stdlib.h>
+#include <new>
+
+static bool   g_bCounting    = false;
+static size_t g_nAllocations = 0;
+
+void* operator new(size_t nSize)
+{
+   if (g_bCounting)
+   {
+      g_nAllocations++;
+   }
+   void* p = malloc((nSize > 0) ? nSize : 1);
+   if (p == NULL)
+   {
+      throw std::bad_alloc();
+   }
+   return p;
+}
+
+void operator delete(void* p) noexcept
+{
+   free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+   free(p);
+}
+
+/** Drives nUpdates times through the Horizon of the parameters and returns the allocations of the updates from
+    the nCountFrom'th one */
+static size_t drive(RVRoadModelBuilder& builder, RVModelBuffer& buffer, const RVSyntheticHorizon::Params& params, int nUpdates, bool bFullRebuild, int nCountFrom = 0)
+{
+   RVSyntheticHorizon horizon;
+   horizon.generate(params);
+   size_t nAllocations = 0;
+   for (int nUpdate = 0;  nUpdate < nUpdates;  nUpdate++)
+   {
+      g_nAllocations = 0;
+      g_bCounting = true;
+      builder.scanHorizon(horizon, bFullRebuild);
+      builder.publish(buffer);
+      buffer.acquire();
+      g_bCounting = false;
+      nAllocations += (nUpdate >= nCountFrom) ? g_nAllocations : 0;
+      horizon.advance(params.nLinkLengthCM / 3);
+   }
+   return nAllocations;
+}
+
+/** Drives twice through the same Horizons: the second drive sees no Horizon larger than the first one did, so
+    its updates must not allocate. Returns the allocations of the second drive. */
+static size_t countAllocations(const RVSyntheticHorizon::Params& params, int nUpdates, bool bFullRebuild)
+{
+   RVRoadModelBuilder builder;
+   RVModelBuffer buffer;
+   drive(builder, buffer, params, nUpdates, bFullRebuild);
+   return drive(builder, buffer, params, nUpdates, bFullRebuild);
+}
+
+static void testIncrementalUpdates()
+{
+   RVSyntheticHorizon::Params params;
+   params.nLinks = 100;
+   for (Uint32 nSeed = 1;  nSeed <= 5;  nSeed++)
+   {
+      params.nSeed = nSeed;
+      RV_CHECK_EQUAL(0, countAllocations(params, 300, false));
+   }
+}
+
+static void testFullRebuilds()
+{
+   RVSyntheticHorizon::Params params;
+   params.nLinks = 100;
+   params.nSignsPerLink = 3;
+   RV_CHECK_EQUAL(0, countAllocations(params, 300, true));
+}
+
+// On a long drive the Horizon gets larger than ever before now and then: the storage grows by blocks, so that
+// these updates are rare (a node or an element at a time, the 300 updates allocated 40 to 80 times).
+static void testLongDrive()
+{
+   RVSyntheticHorizon::Params params;
+   params.nLinks = 100;
+   for (Uint32 nSeed = 1;  nSeed <= 5;  nSeed++)
+   {
+      params.nSeed = nSeed;
+      RVRoadModelBuilder builder;
+      RVModelBuffer buffer;
+      RV_CHECK(drive(builder, buffer, params, 600, false, 300) <= 10);
+   }
+}
+
+// Sanity check of the counter: the first drive allocates the storage
+static void testCounter()
+{
+   RVSyntheticHorizon::Params params;
+   RVRoadModelBuilder builder;
+   RVModelBuffer buffer;
+   RV_CHECK(drive(builder, buffer, params, 1, false) > 0);
+}
+
+int main()
+{
+   testCounter();
+   testLongDrive();        // First: the free lists of the pool are shared by all the builders
+   testIncrementalUpdates();
+   testFullRebuilds();
+   return RV_TEST_RESULT();
+}
@@ -0,0 +1,151 @@
+/**
+ * @file    test_areas_order.cpp
+ * @brief   Checks the packed order of RVAreas against the field by field comparison it replaced.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The fields are drawn from sets holding the limits of their types (INT_MIN and INT_MAX for the start, the end and
+ * the distance or duration), so that the bias of the signed fields and the packing of the words are exercised.
+ */
+
+#include "RVTypes.h"
+#include "RVAreas.h"
+#include "RVTest.h"
+
+#include <limits.h>
+
+struct Fields
+{
+   TrafficSign::Sign sign;
+   int               nStart;
+   int               nEnd;
+   unsigned int      nWidth;
+   unsigned int      nNumber;
+   int               nDistanceOrDuration;
+   bool              bDuration;
+   bool              bRealSign;
+
+   RVAreas toAreas() const
+   {
+      return RVAreas(sign, nStart, nEnd, (int) nWidth, (int) nNumber, nDistanceOrDuration, bDuration, bRealSign);
+   };
+};
+
+/** operator< of the baseline RVAreas */
+static bool isLess(const Fields& a, const Fields& b)
+{
+   if (a.nStart != b.nStart)                             return a.nStart < b.nStart;
+   if (a.bRealSign != b.bRealSign)                       return a.bRealSign > b.bRealSign;      // Reversed
+   if (a.sign != b.sign)                                 return a.sign < b.sign;
+   if (a.nEnd != b.nEnd)                                 return a.nEnd < b.nEnd;
+   if (a.nWidth != b.nWidth)                             return a.nWidth < b.nWidth;
+   if (a.nNumber != b.nNumber)                           return a.nNumber < b.nNumber;
+   if (a.nDistanceOrDuration != b.nDistanceOrDuration)   return a.nDistanceOrDuration < b.nDistanceOrDuration;
+   if (a.bDuration != b.bDuration)                       return a.bDuration < b.bDuration;
+   return false;
+}
+
+static const int INTS[] = { INT_MIN, INT_MIN + 1, -100000, -1, 0, 1, 100000, INT_MAX - 1, INT_MAX };
+static const unsigned int UINTS[] = { 0, 1, 4, 0x7FFFFFFF, 0x80000000, UINT_MAX };
+static const TrafficSign::Sign SIGNS[] = { TrafficSign::tsInvalid, TrafficSign::tsLanesInc, TrafficSign::tsCrossing, TrafficSign::tsOvertakeProhibited };
+
+static Uint32 random(Uint32& nState)
+{
+   nState = nState * 1103515245 + 12345;
+   return nState >> 8;
+}
+
+#define PICK(values) values[random(nState) % (sizeof(values) / sizeof(values[0]))]
+
+static Fields draw(Uint32& nState)
+{
+   Fields f;
+   f.sign                  = PICK(SIGNS);
+   f.nStart                = PICK(INTS);
+   f.nEnd                  = PICK(INTS);
+   f.nWidth                = PICK(UINTS);
+   f.nNumber               = PICK(UINTS);
+   f.nDistanceOrDuration   = PICK(INTS);
+   f.bDuration             = (random(nState) % 2) != 0;
+   f.bRealSign             = (random(nState) % 2) != 0;
+   return f;
+}
+
+// The getters give the fields back
+static void testFields()
+{
+   Uint32 nState = 1;
+   for (int i = 0;  i < 1000;  i++)
+   {
+      Fields f = draw(nState);
+      RVAreas areas = f.toAreas();
+      RV_CHECK_EQUAL(f.sign, areas.getSign());
+      RV_CHECK_EQUAL(f.nStart, areas.getStart());
+      RV_CHECK_EQUAL(f.nEnd, areas.getEnd());
+      RV_CHECK_EQUAL(f.nWidth, areas.getWidth());
+      RV_CHECK_EQUAL(f.nNumber, areas.getNumber());
+      RV_CHECK_EQUAL(f.nDistanceOrDuration, areas.getDistanceOrDuration());
+      RV_CHECK_EQUAL(f.bDuration, areas.isDuration());
+      RV_CHECK_EQUAL(f.bRealSign, areas.isRealSign());
+   }
+}
+
+// Random pairs, most of them equal up to a field so that the later fields decide
+static void testOrder()
+{
+   Uint32 nState = 7;
+   int nMismatches = 0;
+   for (int i = 0;  i < 200000;  i++)
+   {
+      Fields a = draw(nState);
+      Fields b = a;
+      switch (random(nState) % 9)
+      {
+         case 0: b = draw(nState);                                   break;
+         case 1: b.nStart = PICK(INTS);                              break;
+         case 2: b.bRealSign = !b.bRealSign;                         break;
+         case 3: b.sign = PICK(SIGNS);                               break;
+         case 4: b.nEnd = PICK(INTS);                                break;
+         case 5: b.nWidth = PICK(UINTS);                             break;
+         case 6: b.nNumber = PICK(UINTS);                            break;
+         case 7: b.nDistanceOrDuration = PICK(INTS);                 break;
+         case 8: b.bDuration = !b.bDuration;                         break;
+      }
+      RVAreas x = a.toAreas();
+      RVAreas y = b.toAreas();
+      nMismatches += ((x < y) != isLess(a, b)) ? 1 : 0;
+      nMismatches += ((y < x) != isLess(b, a)) ? 1 : 0;
+   }
+   RV_CHECK_EQUAL(0, nMismatches);
+}
+
+// The limits of the signed fields, each against all the others
+static void testLimits()
+{
+   Fields base = { TrafficSign::tsCrossing, 0, 0, 3, 0, 0, false, true };
+   const int N = (int) (sizeof(INTS) / sizeof(INTS[0]));
+   for (int nField = 0;  nField < 3;  nField++)
+   {
+      for (int i = 0;  i < N;  i++)
+      {
+         for (int j = 0;  j < N;  j++)
+         {
+            Fields a = base;
+            Fields b = base;
+            int* pA = (nField == 0) ? &a.nStart : (nField == 1) ? &a.nEnd : &a.nDistanceOrDuration;
+            int* pB = (nField == 0) ? &b.nStart : (nField == 1) ? &b.nEnd : &b.nDistanceOrDuration;
+            *pA = INTS[i];
+            *pB = INTS[j];
+            RV_CHECK_EQUAL(isLess(a, b), a.toAreas() < b.toAreas());
+         }
+      }
+   }
+}
+
+int main()
+{
+   testFields();
+   testOrder();
+   testLimits();
+   return RV_TEST_RESULT();
+}
@@ -0,0 +1,348 @@
+/**
+ * @file    test_builder.cpp
+ * @brief   Builds a road model from a hand-written Horizon, without ADASRP.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The stand-in RVHorizonSource below describes a short MPP of four links of 100 m with the car 20 m into the
+ * root link: a tunnel over the first two links, a lane increase, a priority crossing with a wrong-way road on
+ * the left and a speed limit. The test checks the signs, the areas and the root link infos built from it.
+ */
+
+#include "RVTypes.h"
+#include "RVRoadModelBuilder.h"
+#include "RVTest.h"
+
+#include <algorithm>
+
+class StandInHorizon : public RVHorizonSource
+{
+public: // Constructor/Destructor
+
+   StandInHorizon(Sint32 nCarOffsetCM) : m_nCarOffsetCM(nCarOffsetCM), m_bInCity(false) {};
+
+
+public: // Horizon description
+
+   void addLink(Uint32 nLinkId, Sint32 nLengthCM)
+   {
+      m_mpp.push_back(nLinkId);
+      m_lengths.push_back(nLengthCM);
+   };
+
+   void addBranch(Uint32 nLinkId, Uint32 nChildId, int nTurnAngleDegrees, Float64 fProbability)
+   {
+      Branch branch = { nLinkId, { nChildId, nTurnAngleDegrees, fProbability } };
+      m_branches.push_back(branch);
+   };
+
+   /** Adds an attribute of the Horizon. The attributes are returned in the order they are added. */
+   void addAttribute(Uint32 nLinkId, ADAS::AttributeType type, Uint32 info, Sint32 nOffsetCM, Sint32 nLengthCM = 0, bool bIsStart = true)
+   {
+      ADAS::HorizonAttribute ahat = { nLinkId, type, info, nLengthCM, nOffsetCM, bIsStart };
+      m_attrs.push_back(ahat);
+   };
+
+   void setInCity(bool bInCity) { m_bInCity = bInCity; };
+
+
+public: // RVHorizonSource
+
+   virtual void getMostProbablePath(std::vector<Uint32>& mpp)
+   {
+      mpp.insert(mpp.end(), m_mpp.begin(), m_mpp.end());
+   };
+
+   virtual Sint32 getLinkLengthCM(Uint32 nLinkId)
+   {
+      int nPosition = findLink(nLinkId);
+      return (nPosition >= 0) ? m_lengths[nPosition] : 0;
+   };
+
+   virtual bool isInCity(Uint32 /*nLinkId*/)          { return m_bInCity; };
+   virtual bool isRightSideDrive(Uint32 /*nLinkId*/)  { return true; };
+
+   virtual void getBranches(Uint32 nLinkId, std::vector<RVBranch>& branches)
+   {
+      for (size_t i = 0;  i < m_branches.size();  i++)
+      {
+         if (m_branches[i].nLinkId == nLinkId)
+         {
+            branches.push_back(m_branches[i].branch);
+         }
+      }
+   };
+
+   virtual Uint32 getAttributeCount() { return (Uint32) m_attrs.size(); };
+
+   // The distance from the car is the distance along the MPP, the attributes being all on the MPP
+   virtual Sint32 getNearestAttribute(Uint32 nIndex, Float64* pfProbability, ADAS::HorizonAttribute* pAttr)
+   {
+      *pAttr = m_attrs[nIndex];
+      *pfProbability = 1.0;
+      Sint32 nStartCM = 0;
+      for (int nPosition = 0;  nPosition < findLink(pAttr->nLinkId);  nPosition++)
+      {
+         nStartCM += m_lengths[nPosition];
+      }
+      return nStartCM + pAttr->nOffsetCM - m_nCarOffsetCM;
+   };
+
+   virtual void getLinkAttributes(Uint32 nLinkId, std::vector<ADAS::HorizonAttribute>& attrs)
+   {
+      for (size_t i = 0;  i < m_attrs.size();  i++)
+      {
+         if (m_attrs[i].nLinkId == nLinkId)
+         {
+            attrs.push_back(m_attrs[i]);
+         }
+      }
+   };
+
+
+private: // Worker methods
+
+   int findLink(Uint32 nLinkId) const
+   {
+      std::vector<Uint32>::const_iterator it = std::find(m_mpp.begin(), m_mpp.end(), nLinkId);
+      return (it != m_mpp.end()) ? (int) (it - m_mpp.begin()) : -1;
+   };
+
+
+private: // Data Members
+
+   struct Branch
+   {
+      Uint32   nLinkId;
+      RVBranch branch;
+   };
+
+   Sint32                              m_nCarOffsetCM;
+   bool                                m_bInCity;
+   std::vector<Uint32>                 m_mpp;
+   std::vector<Sint32>                 m_lengths;
+   std::vector<Branch>                 m_branches;
+   std::vector<ADAS::HorizonAttribute> m_attrs;
+};
+
+
+static void makeHorizon(StandInHorizon& horizon)
+{
+   for (Uint32 nLinkId = 1;  nLinkId <= 4;  nLinkId++)
+   {
+      horizon.addLink(nLinkId, 10000);
+   }
+   horizon.addBranch(3, 4, 0, 0.9);             // Next link on the MPP: ignored
+   horizon.addBranch(3, 10, -90, 0.0);          // Wrong-way road on the left
+   horizon.setInCity(true);
+
+   horizon.addAttribute(1, ADAS::ahatCurrentSpeed, 50, 2000);              // The first attribute is not used for the root link
+   horizon.addAttribute(1, ADAS::ahatNumberOfLanesFromSC, 2, 0);           // -20 m: root link infos
+   horizon.addAttribute(1, ADAS::ahatTunnel, 0, 0);
+   horizon.addAttribute(2, ADAS::ahatNumberOfLanesFromSC, 3, 0, 10000);    // 80 m: lane increase, the tunnel goes on
+   horizon.addAttribute(2, ADAS::ahatTunnel, 0, 0);
+   horizon.addAttribute(3, ADAS::ahatCrossingSmall, 0, 0);                 // 180 m: priority crossing
+
+   ADAS::TrafficSignInfo tsi;
+   tsi.unit = 0;
+   tsi.bits.m_nNumber = 80;
+   tsi.bits.m_validityFlag = ADAS::TrafficSignValidityFlag::tsValidityDuration;
+   horizon.addAttribute(4, ADAS::ahatTSSpeedLimit, tsi.unit, 5000, 20000); // 330 m: 80 km/h for 200 m
+}
+
+static void testRootLink()
+{
+   StandInHorizon horizon(2000);
+   makeHorizon(horizon);
+   RVRoadModelBuilder builder;
+   builder.setRootLink(horizon, 1);
+   builder.scanHorizon(horizon, true);
+   const RVRoadModel& model = builder.getModel();
+
+   RV_CHECK(model.bIsInCity);
+   RV_CHECK_EQUAL(50, model.nSpeedOnRootLink);
+   RV_CHECK(model.bIsCurrentSpeed);
+   RV_CHECK_EQUAL(2, model.nStartNbOfLanes);
+   RV_CHECK(model.bIsStartInTunnel);
+   RV_CHECK(!model.bIsStartInRoundabout);
+   RV_CHECK_EQUAL(3, model.nMaxLanes);
+}
+
+static void testSigns()
+{
+   StandInHorizon horizon(2000);
+   makeHorizon(horizon);
+   RVRoadModelBuilder builder;
+   builder.scanHorizon(horizon, true);
+   const std::vector<RVSign>& signs = builder.getModel().signs;
+
+   RV_CHECK_EQUAL(3, signs.size());
+   if (signs.size() != 3)
+   {
+      return;
+   }
+   RV_CHECK_EQUAL(80, signs[0].getDistanceToSignM());
+   RV_CHECK_EQUAL(TrafficSign::tsLanesInc, signs[0].getSignLanes());
+   RV_CHECK_EQUAL(3, signs[0].getSignLanesParam());
+   RV_CHECK_EQUAL(TrafficSign::tsInvalid, signs[0].getSignCrossing());
+
+   RV_CHECK_EQUAL(180, signs[1].getDistanceToSignM());
+   RV_CHECK_EQUAL(TrafficSign::tsPriorityCrossing, signs[1].getSignCrossing());
+   RV_CHECK_EQUAL(3, signs[1].getSignLanesParam());
+   RV_CHECK(signs[1].getSizeOfCrossing() == 0.5f);
+   RV_CHECK_EQUAL(RVSign::CROSSING_LEFT, signs[1].getCrossingSide());
+   RV_CHECK_EQUAL(RVSign::PROHIBITED_LEFT, signs[1].getProhibitedSide());
+   RV_CHECK_EQUAL(3, signs[1].getLinkId());
+
+   // Last entry: end of the Horizon to be drawn
+   RV_CHECK_EQUAL(TrafficSign::tsInvalid, signs[2].getSignLanes());
+   RV_CHECK_EQUAL(TrafficSign::tsInvalid, signs[2].getSignCrossing());
+   RV_CHECK_EQUAL(330 + 100, signs[2].getDistanceToSignM());
+}
+
+static void testAreas()
+{
+   StandInHorizon horizon(2000);
+   makeHorizon(horizon);
+   RVRoadModelBuilder builder;
+   builder.scanHorizon(horizon, true);
+   const RVRoadModel& model = builder.getModel();
+
+   // The tunnel the car is in goes on over link 2, to the crossing
+   RV_CHECK_EQUAL(1, model.areas.size());
+   if (model.areas.size() == 1)
+   {
+      RV_CHECK_EQUAL(TrafficSign::tsTunnel, model.areas[0].getSign());
+      RV_CHECK_EQUAL(0, model.areas[0].getStart());
+      RV_CHECK_EQUAL(180, model.areas[0].getEnd());
+   }
+
+   // Traffic Signs: the lane increase, the speed limit and the tunnel, sorted by position
+   bool bLanes = false, bSpeedLimit = false, bTunnel = false;
+   for (size_t i = 0;  i < model.tsAreas.size();  i++)
+   {
+      const RVAreas& area = model.tsAreas[i];
+      RV_CHECK((i == 0) || !(area < model.tsAreas[i-1]));
+      if (area.getSign() == TrafficSign::tsLanesInc)
+      {
+         bLanes = true;
+         RV_CHECK_EQUAL(80, area.getStart());
+         RV_CHECK_EQUAL(3, area.getNumber());
+      }
+      if (area.getSign() == TrafficSign::tsSpeedLimit)
+      {
+         bSpeedLimit = true;
+         RV_CHECK_EQUAL(330, area.getStart());
+         RV_CHECK_EQUAL(330 + 200, area.getEnd());
+         RV_CHECK_EQUAL(80, area.getNumber());
+         RV_CHECK_EQUAL(200, area.getDistanceOrDuration());
+         RV_CHECK(area.isDuration());
+         RV_CHECK(area.isRealSign());
+         RV_CHECK_EQUAL(3, area.getWidth());
+      }
+      bTunnel |= (area.getSign() == TrafficSign::tsTunnel);
+   }
+   RV_CHECK(bLanes);
+   RV_CHECK(bSpeedLimit);
+   RV_CHECK(bTunnel);
+   RV_CHECK_EQUAL(3, model.tsAreas.size());
+}
+
+/** MPP of nLinks links of 100 m ending with link 3 or 4, the crossing at the end of link 3 turning right into
+    link 4 and left into a wrong-way road */
+static void makeGrowingHorizon(StandInHorizon& horizon, Uint32 nLinks)
+{
+   for (Uint32 nLinkId = 1;  nLinkId <= nLinks;  nLinkId++)
+   {
+      horizon.addLink(nLinkId, 10000);
+   }
+   horizon.addBranch(3, 4, 45, 0.9);
+   horizon.addBranch(3, 10, -90, 0.0);
+   horizon.addAttribute(1, ADAS::ahatNumberOfLanesFromSC, 2, 0);
+   horizon.addAttribute(3, ADAS::ahatCrossingSmall, 0, 0);
+}
+
+static const RVSign* findCrossing(const RVRoadModel& model)
+{
+   for (size_t i = 0;  i < model.signs.size();  i++)
+   {
+      if (model.signs[i].getSignCrossing() != TrafficSign::tsInvalid)
+      {
+         return &model.signs[i];
+      }
+   }
+   return NULL;
+}
+
+// The MPP grows by a branch of its last link: that branch is no longer a side of the crossing
+static void testMppGrowsByBranch()
+{
+   StandInHorizon horizon(2000);
+   makeGrowingHorizon(horizon, 3);
+   StandInHorizon grown(2000);
+   makeGrowingHorizon(grown, 4);
+   RVRoadModelBuilder builder;
+
+   builder.scanHorizon(horizon, true);
+   const RVSign* pCrossing = findCrossing(builder.getModel());
+   RV_CHECK(pCrossing != NULL);
+   if (pCrossing != NULL)
+   {
+      RV_CHECK_EQUAL(RVSign::CROSSING_BOTH, pCrossing->getCrossingSide());
+   }
+
+   builder.scanHorizon(grown, false);
+   RV_CHECK_EQUAL(1, builder.getStats().nIncrementalUpdates);
+   pCrossing = findCrossing(builder.getModel());
+   RV_CHECK(pCrossing != NULL);
+   if (pCrossing != NULL)
+   {
+      RV_CHECK_EQUAL(RVSign::CROSSING_LEFT, pCrossing->getCrossingSide());
+      RV_CHECK_EQUAL(RVSign::PROHIBITED_LEFT, pCrossing->getProhibitedSide());
+   }
+}
+
+// The car moves on by 30 m: the MPP continues, the distances are 30 m shorter and the travel follows
+static void testIncrementalUpdate()
+{
+   StandInHorizon horizon(2000);
+   makeHorizon(horizon);
+   StandInHorizon moved(5000);
+   makeHorizon(moved);
+   RVRoadModelBuilder builder;
+   builder.scanHorizon(horizon, true);
+   builder.scanHorizon(moved, false);
+   const RVRoadModel& model = builder.getModel();
+
+   RV_CHECK_EQUAL(1, model.stats.nFullRebuilds);
+   RV_CHECK_EQUAL(1, model.stats.nIncrementalUpdates);
+   RV_CHECK_EQUAL(3000, model.nTravelCM);
+   RV_CHECK(model.stats.nReusedAttrs > 0);
+   RV_CHECK(!model.signs.empty() && (model.signs[0].getDistanceToSignM() == 50));
+}
+
+static void testPublish()
+{
+   StandInHorizon horizon(2000);
+   makeHorizon(horizon);
+   RVRoadModelBuilder builder;
+   RVModelBuffer buffer;
+   builder.scanHorizon(horizon, true);
+   builder.publish(buffer);
+   const RVRoadModel& model = buffer.acquire();
+
+   RV_CHECK_EQUAL(1, model.nGeneration);
+   RV_CHECK_EQUAL(builder.getModel().signs.size(), model.signs.size());
+   RV_CHECK_EQUAL(builder.getModel().tsAreas.size(), model.tsAreas.size());
+}
+
+int main()
+{
+   testRootLink();
+   testSigns();
+   testAreas();
+   testIncrementalUpdate();
+   testMppGrowsByBranch();
+   testPublish();
+   return RV_TEST_RESULT();
+}
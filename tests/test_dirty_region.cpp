@@ -0,0 +1,148 @@
+/**
+ * @file    test_dirty_region.cpp
+ * @brief   Checks that scrolling the road strip and repainting the dirty region paints the frame of the new layout.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * The frames are rendered by RVSoftwareBackend, whose hatch is anchored to the canvas as the one of GDI. The
+ * previous frame is scrolled and the rectangles of RVDirtyRegion are copied from a full render of the new layout,
+ * as CAHRoadView::OnModelPublished() and OnPaint() do: the result must be the full render.
+ */
+
+#include "RVTypes.h"
+#include "RVDirtyRegion.h"
+#include "RVSoftwareBackend.h"
+#include "RVTest.h"
+
+static const int WIDTH     = 400;
+static const int HEIGHT    = 200;
+static const RVRect STRIP  = { 40, 60, WIDTH, 140 };
+
+/** Styles of the painted list, set once as CAHRoadView::OnCreate() does */
+static void setStyles(RVDisplayList& list)
+{
+   list.setStyle(RVDisplayList::STYLE_ROAD,       RGB(  0,   0,   0), RVStyle::PATTERN_SOLID, 1);
+   list.setStyle(RVDisplayList::STYLE_LINES,      RGB(255, 255, 255), RVStyle::PATTERN_SOLID, 3);
+   list.setStyle(RVDisplayList::STYLE_LINES_DASH, RGB(255, 255, 255), RVStyle::PATTERN_DASH,  3);
+   list.setStyle(RVDisplayList::STYLE_COMPLEX,    RGB(255,   0,   0), RVStyle::PATTERN_HATCH, 1);
+}
+
+/** Road of 3 segments, the middle one a complex intersection, laid out for the car xTravel pixels further */
+static void layout(RVDisplayList& list, int xTravel)
+{
+   list.clear();
+   int x = STRIP.nLeft + 60 - xTravel;
+   list.fillRect(RVDisplayList::STYLE_ROAD, STRIP.nLeft, 80, x + 100 - STRIP.nLeft, 40);
+   list.fillRect(RVDisplayList::STYLE_COMPLEX, x + 100, 80, 90, 40);
+   list.fillRect(RVDisplayList::STYLE_ROAD, x + 190, 80, WIDTH - x - 190, 40);
+   list.line(RVDisplayList::STYLE_LINES, STRIP.nLeft, 80, WIDTH, 80);
+   list.line(RVDisplayList::STYLE_LINES, STRIP.nLeft, 120, WIDTH, 120);
+   list.beginDashedLines(RVDisplayList::STYLE_LINES_DASH, STRIP.nLeft, WIDTH, 7, 10);
+   list.addPoint(RVDisplayList::getDashPhase(x, 7, 10), 100);
+}
+
+static void render(RVSoftwareBackend& backend, const RVDisplayList& list)
+{
+   backend.resize(WIDTH, HEIGHT);
+   backend.clear(RGB(255, 255, 255));
+   backend.replay(list);
+}
+
+/** Moves the pixels of the strip by dx, as ScrollDC() (the band scrolled in keeps its pixels) */
+static void scroll(std::vector<Uint32>& pixels, int dx)
+{
+   for (int y = STRIP.nTop; y < STRIP.nBottom; y++)
+   {
+      Uint32* pRow = &pixels[y * WIDTH];
+      std::vector<Uint32> row(pRow + STRIP.nLeft, pRow + STRIP.nRight);
+      for (int x = STRIP.nLeft; x < STRIP.nRight; x++)
+      {
+         if ((x - dx >= STRIP.nLeft) && (x - dx < STRIP.nRight))
+         {
+            pRow[x] = row[x - dx - STRIP.nLeft];
+         }
+      }
+   }
+}
+
+/** Scrolls the frame of the layout at xTravel to the one at xTravel + nMove and returns the pixels differing from
+    a full render */
+static int countWrongPixels(int xTravel, int nMove)
+{
+   // Swapped as the lists of the plug-in: only the painted one got setStyle()
+   RVDisplayList painted;
+   RVDisplayList next;
+   setStyles(painted);
+   next.setStyles(painted);
+   layout(next, xTravel);
+   painted.swap(next);
+
+   RVSoftwareBackend backend;
+   render(backend, painted);
+   std::vector<Uint32> frame(backend.getPixels(), backend.getPixels() + WIDTH * HEIGHT);
+   layout(next, xTravel + nMove);
+
+   int dx = -nMove;
+   RVDirtyRegion region;
+   scroll(frame, dx);
+   region.scroll(STRIP, dx);
+   region.addChanges(painted, next, STRIP, false);
+   painted.translate(dx);
+   region.addChanges(painted, next, STRIP, true);
+   region.addHatched(painted, STRIP);
+   RVRect rectExposed = STRIP;
+   rectExposed.nLeft = STRIP.nRight + dx;
+   region.add(rectExposed);
+   region.clip(WIDTH, HEIGHT);
+   painted.swap(next);
+   render(backend, painted);
+
+   for (size_t i = 0; i < region.getSize(); i++)
+   {
+      const RVRect& rect = region.getRect(i);
+      for (int y = rect.nTop; y < rect.nBottom; y++)
+      {
+         for (int x = rect.nLeft; x < rect.nRight; x++)
+         {
+            frame[y * WIDTH + x] = backend.getPixel(x, y);
+         }
+      }
+   }
+
+   int nWrong = 0;
+   for (int i = 0; i < WIDTH * HEIGHT; i++)
+   {
+      nWrong += (frame[i] != backend.getPixels()[i]) ? 1 : 0;
+   }
+   return nWrong;
+}
+
+/** Lays out the same frame in both lists of the plug-in and checks they bound it alike (the GDI pens of the 3 px
+    lines paint up to the margin of their style) */
+static void testSwappedBounds()
+{
+   RVDisplayList painted;
+   RVDisplayList next;
+   setStyles(painted);
+   next.setStyles(painted);
+   layout(painted, 0);
+   layout(next, 0);
+   RV_CHECK_EQUAL(painted.getSize(), next.getSize());
+   for (size_t i = 0; (i < painted.getSize()) && (i < next.getSize()); i++)
+   {
+      RVRect a = painted.getBounds(i);
+      RVRect b = next.getBounds(i);
+      RV_CHECK((a.nLeft == b.nLeft) && (a.nTop == b.nTop) && (a.nRight == b.nRight) && (a.nBottom == b.nBottom));
+   }
+}
+
+int main()
+{
+   testSwappedBounds();
+   for (int nMove = 1; nMove <= 12; nMove++)
+   {
+      RV_CHECK_EQUAL(0, countWrongPixels(0, nMove));
+      RV_CHECK_EQUAL(0, countWrongPixels(37, nMove));
+   }
+   return RV_TEST_RESULT();
+}
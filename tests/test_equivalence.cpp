@@ -0,0 +1,634 @@
+/**
+ * @file    test_equivalence.cpp
+ * @brief   Checks the fused scan of RVRoadModelBuilder against the three passes it replaced.
+ * @version 0.1
+ * @date    16.10.2026.
+ *
+ * RVReferenceModel is the extraction of the plug-in before the builder: getStartNbOfLanes(), getPathInfos() and
+ * getTSAreas(), each looping over all the Horizon attributes. They are ported from CAHRoadView to RVHorizonSource,
+ * the per-type switch of getTSAreas() written one line per sign. Both are run on synthetic Horizons while the car
+ * drives on, the builder by full rebuilds and by incremental updates: the signs, the areas and the Traffic Sign
+ * areas must be identical.
+ */
+
+#include "RVTypes.h"
+#include "RVRoadModelBuilder.h"
+#include "RVSyntheticHorizon.h"
+#include "RVTest.h"
+
+#include <algorithm>
+
+class RVReferenceModel
+{
+public: // Constructor/Destructor
+
+   RVReferenceModel()
+   {
+      m_nStartNbOfLanes = 1;
+      m_nMaxLanes = 1;
+      m_bIsStartInTunnel = false;
+      m_bIsStartInRoundabout = false;
+   };
+
+
+public: // AH Listener
+
+   /** As onPositionChangedMsg() */
+   void update(RVHorizonSource& source)
+   {
+      m_tsAreas.clear();
+      getPathInfos(source);
+      getTSAreas(source);
+   };
+
+
+public: // Data Members
+
+   std::vector<RVSign>  m_signs;
+   std::vector<RVAreas> m_areas;
+   std::vector<RVAreas> m_tsAreas;
+   int                  m_nStartNbOfLanes;
+   int                  m_nMaxLanes;
+   bool                 m_bIsStartInTunnel;
+   bool                 m_bIsStartInRoundabout;
+
+
+private: // Worker methods
+
+   void getPathInfos(RVHorizonSource& source)
+   {
+      bool bRightSideDrive = true;
+      std::vector<Uint32> mpp;
+      source.getMostProbablePath(mpp);
+      if (mpp.size() > 0)
+      {
+         bRightSideDrive = source.isRightSideDrive(mpp.at(0));
+      }
+
+      Uint32 n = source.getAttributeCount();
+
+      m_signs.clear();
+      m_areas.clear();
+
+      struct TrafficSignView::Hint hintLanes;
+      struct TrafficSignView::Hint hintCrossing;
+      hintLanes.sign                             = TrafficSign::tsInvalid;
+      hintLanes.param                            = 0;
+      hintCrossing.sign                          = TrafficSign::tsInvalid;
+      hintCrossing.param                         = 0;
+      float fSizeOfCrossing                      = 0.0;
+      RVSign::CrossingSideType nCrossingSide     = RVSign::CROSSING_UNKNOWN;
+      RVSign::ProhibitedSideType nProhibitedSide = RVSign::PROHIBITED_NONE;
+      Uint32 nLinkId                             = 0;
+      Sint32 nLinkLength                         = 0;
+
+      struct TrafficSignView::Hint hintAreas;
+      hintAreas.sign       = TrafficSign::tsInvalid;
+      hintAreas.param      = 0;
+
+      getStartNbOfLanes(source, mpp);
+
+      unsigned int nMaxLanes = 0;
+      Sint32 nAreaStart = 0;
+      Sint32 nAreaEnd = 0;
+      bool bIsStartInArea = false;
+      bool bFoundAreaContinuation = false;
+
+      unsigned int nPreviousNbOfLanes = m_nStartNbOfLanes;
+      unsigned int nLastFoundNbOfLanes = m_nStartNbOfLanes;
+
+      Sint32 nPreviousDist    = 0;
+
+      for (Uint32 i = 0;  i < n;  i++)
+      {
+         ADAS::HorizonAttribute ahat;
+         Float64  fProbability;
+         Sint32   nDistCM = source.getNearestAttribute(i, &fProbability, &ahat);
+         Sint32   nDist = nDistCM / 100;
+
+         if (isIdOnMPP(ahat.nLinkId, mpp) && (nDist > 0))
+         {
+            if ((nDist != nPreviousDist) && (nPreviousDist != 0.0))
+            {
+               if (bFoundAreaContinuation)
+               {
+                  bFoundAreaContinuation = false;
+               }
+               else
+               {
+                  if ((bIsStartInArea && (nAreaStart == 0)) || (nAreaStart != 0))
+                  {
+                     nAreaEnd = nPreviousDist;
+                     m_areas.push_back(RVAreas(hintAreas.sign, nAreaStart, nAreaEnd, nMaxLanes));
+                     nAreaStart = 0;
+                     nAreaEnd = 0;
+                     nMaxLanes = 0;
+                     bIsStartInArea = false;
+                  }
+               }
+               if (((hintLanes.sign != TrafficSign::tsInvalid) || (hintCrossing.sign != TrafficSign::tsInvalid)))
+               {
+                  if (hintLanes.param == 0)
+                  {
+                     hintLanes.param = nLastFoundNbOfLanes;
+                  }
+                  m_signs.push_back(RVSign(hintLanes.sign, hintLanes.param, hintCrossing.sign, fSizeOfCrossing, nPreviousDist, nCrossingSide, nProhibitedSide, nLinkId));
+                  if (TrafficSign::tsInvalid != hintLanes.sign) {
+                     m_tsAreas.push_back(RVAreas(hintLanes.sign, nPreviousDist, nPreviousDist, 0, hintLanes.param));
+                  }
+
+                  nLastFoundNbOfLanes = hintLanes.param;
+
+                  hintLanes.sign      = TrafficSign::tsInvalid;
+                  hintLanes.param     = 0;
+                  hintCrossing.sign   = TrafficSign::tsInvalid;
+                  fSizeOfCrossing     = 0.0;
+                  nCrossingSide       = RVSign::CROSSING_UNKNOWN;
+                  nProhibitedSide     = RVSign::PROHIBITED_NONE;
+               }
+            }
+
+            switch (ahat.type)
+            {
+               case ADAS::ahatNumberOfLanesFromSC:
+                  {
+                     unsigned int nNew = ahat.info & 0xFFFFL;
+                     hintLanes.sign = nNew == nPreviousNbOfLanes ? TrafficSign::tsInvalid :
+                                      nNew > nPreviousNbOfLanes ? (bRightSideDrive ? TrafficSign::tsLanesInc : TrafficSign::tsLanesIncRight)
+                                      : (bRightSideDrive ? TrafficSign::tsLanesDec : TrafficSign::tsLanesDecRight);
+                     hintLanes.param = nNew;
+
+                     nPreviousNbOfLanes = nNew;
+
+                     if (nNew > nMaxLanes)
+                     {
+                        nMaxLanes = nNew;
+                        m_nMaxLanes = nMaxLanes;
+                     }
+
+                     nLinkId = ahat.nLinkId;
+                     nLinkLength = ahat.nLengthCM / 100;
+
+                     break;
+                  };
+               case ADAS::ahatCrossingSame:
+                  hintCrossing.sign = TrafficSign::tsCrossing;
+                  fSizeOfCrossing = 1;
+                  nCrossingSide = getCrossingSide(source, ahat.nLinkId, mpp, &nProhibitedSide);
+                  nLinkId = ahat.nLinkId;
+                  break;
+
+               case ADAS::ahatCrossingSmall:
+                  hintCrossing.sign = TrafficSign::tsPriorityCrossing;
+                  fSizeOfCrossing = 0.5;
+                  nCrossingSide = getCrossingSide(source, ahat.nLinkId, mpp, &nProhibitedSide);
+                  nLinkId = ahat.nLinkId;
+                  break;
+
+               case ADAS::ahatCrossingBig:
+                  hintCrossing.sign = TrafficSign::tsGiveWay;
+                  fSizeOfCrossing = 1.5;
+                  nCrossingSide = getCrossingSide(source, ahat.nLinkId, mpp, &nProhibitedSide);
+                  nLinkId = ahat.nLinkId;
+                  break;
+
+               case ADAS::ahatTunnel:
+               case ADAS::ahatRoundabout:
+                  hintAreas.sign = ahat.type == ADAS::ahatTunnel ? TrafficSign::tsTunnel : TrafficSign::tsRoundabout;
+                  bIsStartInArea = ahat.type == ADAS::ahatTunnel ? m_bIsStartInTunnel : m_bIsStartInRoundabout;
+                  if (nAreaStart == 0.0)
+                  {
+                     if (!bIsStartInArea)
+                     {
+                        nAreaStart = nDist;
+                     }
+                  }
+                  bFoundAreaContinuation = true;
+                  break;
+            }
+
+            nPreviousDist = nDist;
+         }
+      }
+
+      if (((hintLanes.sign != TrafficSign::tsInvalid) || (hintCrossing.sign != TrafficSign::tsInvalid)))
+      {
+         if (hintLanes.param == 0)
+         {
+            hintLanes.param = nLastFoundNbOfLanes;
+         }
+         m_signs.push_back(RVSign(hintLanes.sign, hintLanes.param, hintCrossing.sign, fSizeOfCrossing, nPreviousDist, nCrossingSide, nProhibitedSide, nLinkId));
+         if (TrafficSign::tsInvalid != hintLanes.sign) {
+            m_tsAreas.push_back(RVAreas(hintLanes.sign, nPreviousDist, nPreviousDist, 0, hintLanes.param));
+         }
+      } else {
+         m_signs.push_back(RVSign(TrafficSign::tsInvalid, hintLanes.param, TrafficSign::tsInvalid, 0.0, nPreviousDist + nLinkLength, nCrossingSide, nProhibitedSide, nLinkId));
+      }
+      if (((nAreaStart != 0) || (bIsStartInArea && bFoundAreaContinuation && (nAreaStart == 0)) ) && (nAreaEnd == 0.0))
+      {
+         m_areas.push_back(RVAreas(hintAreas.sign, nAreaStart, nAreaEnd, nMaxLanes));
+      }
+
+      std::sort(m_signs.begin(), m_signs.end(), RVSign::compareByDistance);
+      std::sort(m_areas.begin(), m_areas.end());
+
+      m_tsAreas.insert(m_tsAreas.end(), m_areas.begin(), m_areas.end());
+   };
+
+   int getLanes(RVHorizonSource& source, ADAS::HorizonAttribute& ahat)
+   {
+      std::vector<ADAS::HorizonAttribute> attrs;
+      source.getLinkAttributes(ahat.nLinkId, attrs);
+      int nLanesCount = 0, nOneWayCount = 0, nOppositeCount = 0, nLanes = 0, nOpposite = 0;
+      for (size_t i = 0;  i < attrs.size();  i++)
+      {
+         if (attrs[i].type == ADAS::ahatADASNumberOfLanes)
+         {
+            nLanesCount++;
+            nLanes = attrs[i].info;
+         }
+         if (attrs[i].type == ADAS::ahatRightWay)
+         {
+            nOneWayCount++;
+         }
+         if (attrs[i].type == ADAS::ahatADASOppositeNumberOfLanes)
+         {
+            nOppositeCount++;
+            nOpposite = attrs[i].info;
+         }
+      }
+      if (1 != nLanesCount) {
+         return 1;
+      }
+      if (1 == nOneWayCount) {
+         return nLanes;
+      }
+      if (1 == nOppositeCount) {
+         nLanes += 64 * nOpposite;
+      }
+      return nLanes;
+   };
+
+   void getTSAreas(RVHorizonSource& source)
+   {
+      std::vector<Uint32> mpp;
+      source.getMostProbablePath(mpp);
+
+      Uint32 n = source.getAttributeCount();
+
+      for (Uint32 i = 0;  i < n;  i++)
+      {
+         ADAS::HorizonAttribute ahat;
+         Float64  fProbability;
+         Sint32   nDistCM = source.getNearestAttribute(i, &fProbability, &ahat);
+         Sint32   nDist = nDistCM / 100;
+
+         union ADAS::TrafficSignInfo tsi;
+         tsi.unit = ahat.info;
+
+         if (isIdOnMPP(ahat.nLinkId, mpp) && (nDist > 0))
+         {
+            int nAreaStart = nDist;
+            int nAreaEnd = nAreaStart;
+            int nDistanceOrDuration = 0;
+            bool bDuration = false;
+
+            if (tsi.bits.m_validityFlag == ADAS::TrafficSignValidityFlag::tsValidityStart)
+            {
+               nDistanceOrDuration = ahat.nLengthCM / 100;
+               bDuration = false;
+            }
+            if (tsi.bits.m_validityFlag == ADAS::TrafficSignValidityFlag::tsValidityDuration)
+            {
+               nAreaEnd += ahat.nLengthCM / 100;
+               nDistanceOrDuration = ahat.nLengthCM / 100;
+               bDuration = true;
+            }
+
+            TrafficSign::Sign sign = TrafficSign::tsInvalid;
+            int nNumber = 0;
+            bool bRealSign = true;
+            switch (ahat.type)
+            {
+               case ADAS::ahatTSPedestrianXing:          sign = TrafficSign::tsPedestrian;               break;
+               case ADAS::ahatTSPedestrianCrosswalk:
+                  m_tsAreas.push_back(RVAreas(TrafficSign::tsPedestrianCrossing, nAreaStart, nAreaEnd, m_nMaxLanes, 0, nDistanceOrDuration, bDuration, true));
+                  // Falls through: a Crosswalk also has a Traffic Light
+               case ADAS::ahatTSTrafficLight:
+                  m_tsAreas.push_back(RVAreas(TrafficSign::tsTrafficLight, nAreaStart, nAreaEnd, m_nMaxLanes, 0, 0, false, false));
+                  break;
+               case ADAS::ahatTSTrafficLightSign:        sign = TrafficSign::tsTrafficLight;             break;
+               case ADAS::ahatTSRightofWayRoad:          sign = TrafficSign::tsRightOfWay;               break;
+               case ADAS::ahatTSRightOfWayCrossing:      sign = TrafficSign::tsPriorityCrossing;         break;
+               case ADAS::ahatTSEndOfTown:               sign = TrafficSign::tsUrbanAreaEnd;             break;
+               case ADAS::ahatTSEqualIntersection:       sign = TrafficSign::tsCrossing;                 break;
+               case ADAS::ahatTSYield:                   sign = TrafficSign::tsGiveWay;                  break;
+               case ADAS::ahatTSStop:                    sign = TrafficSign::tsStop;                     break;
+               case ADAS::ahatTSWarning:                 sign = TrafficSign::tsWarning;                  break;
+               case ADAS::ahatTSSharpCurveLeft:          sign = TrafficSign::tsLeftTurn;                 break;
+               case ADAS::ahatTSSharpCurveRight:         sign = TrafficSign::tsRightTurn;                break;
+               case ADAS::ahatTSSCurveLeft:              sign = TrafficSign::tsSCurveLeft;               break;
+               case ADAS::ahatTSSCurveRight:             sign = TrafficSign::tsSCurveRight;              break;
+               case ADAS::ahatTSUnevenRoad:              sign = TrafficSign::tsUnevenRoad;               break;
+               case ADAS::ahatTSIcyRoad:                 sign = TrafficSign::tsIcyRoad;                  break;
+               case ADAS::ahatTSSlipperyRoad:            sign = TrafficSign::tsSlipperyRoad;             break;
+               case ADAS::ahatTSFallingRocks:            sign = TrafficSign::tsFallingRocks;             break;
+               case ADAS::ahatTSRoadNarrowingLeft:       sign = TrafficSign::tsRoadNarrowingLeft;        break;
+               case ADAS::ahatTSRoadNarrowingRight:      sign = TrafficSign::tsRoadNarrowingRight;       break;
+               case ADAS::ahatTSRoadNarrowingBothSides:  sign = TrafficSign::tsRoadNarrowingBothSides;   break;
+               case ADAS::ahatTSTrafficCongestion:       sign = TrafficSign::tsTrafficCongestion;        break;
+               case ADAS::ahatTSAnimals:                 sign = TrafficSign::tsAnimals;                  break;
+               case ADAS::ahatTSChildren:                sign = TrafficSign::tsChildren;                 break;
+               case ADAS::ahatTSOvertakeCC:              sign = ahat.bIsStart ? TrafficSign::tsOvertakeAllowed : TrafficSign::tsOvertakeProhibited;     break;
+               case ADAS::ahatTSOvertakeTC:              sign = ahat.bIsStart ? TrafficSign::tsOvertakeTCAllowed : TrafficSign::tsOvertakeTCProhibited; break;
+               case ADAS::ahatTSEndOfAllProhibitions:    sign = TrafficSign::tsEndOfAllProhibitions;     break;
+               case ADAS::ahatTSEndPriorityRoad:         sign = TrafficSign::tsEndPriorityRoad;          break;
+               case ADAS::ahatTSRailwayCrossingGates:    sign = TrafficSign::tsRailwayCrossingGates;     break;
+               case ADAS::ahatTSRailwayCrossingNoGates:  sign = TrafficSign::tsRailwayCrossingNoGates;   break;
+               case ADAS::ahatTSTramway:                 sign = TrafficSign::tsTramway;                  break;
+               case ADAS::ahatTSRailwayCrossing:         sign = TrafficSign::tsRailwayCrossing;          break;
+               case ADAS::ahatTSCompulsoryRoundabout:    sign = TrafficSign::tsCompulsoryRoundabout;     break;
+               case ADAS::ahatTSCrossWind:               sign = TrafficSign::tsCrossWind;                break;
+               case ADAS::ahatTSAccidentHazard:          sign = TrafficSign::tsAccidentHazard;           break;
+               case ADAS::ahatTSRiskOfGrounding:         sign = TrafficSign::tsRiskOfGrounding;          break;
+               case ADAS::ahatTSPriorityOncomingTraffic: sign = TrafficSign::tsPriorityOncomingTraffic;  break;
+               case ADAS::ahatTSYieldOncomingTraffic:    sign = TrafficSign::tsYieldOncomingTraffic;     break;
+               case ADAS::ahatTSSteepUphill:             sign = TrafficSign::tsSlope;     nNumber = tsi.bits.m_nNumber;   break;
+               case ADAS::ahatTSSteepDownhill:           sign = TrafficSign::tsSlopeNeg;  nNumber = tsi.bits.m_nNumber;   break;
+               case ADAS::ahatTSSpeedLimit:
+                  sign = ahat.bIsStart ? TrafficSign::tsSpeedLimit : TrafficSign::tsSpeedLimitEnd;
+                  nNumber = tsi.bits.m_nNumber;
+                  break;
+               case ADAS::ahatTSSignLanes:
+                  {
+                     sign = TrafficSign::tsLanes;
+                     int nCurLanes = getLanes(source, ahat);
+                     nNumber = (1 == (nCurLanes & 0x3f)) ? (2 + (nCurLanes & ~0x3f)) : nCurLanes - 1;
+                  }
+                  break;
+               case ADAS::ahatTSSignExtraLaneLeft:
+                  sign = TrafficSign::tsLanesInc;
+                  nNumber = (getLanes(source, ahat) & 0x3f) + 1;
+                  break;
+               case ADAS::ahatTSSignExtraLaneRight:
+                  sign = TrafficSign::tsLanesIncRight;
+                  nNumber = (getLanes(source, ahat) & 0x3f) + 1;
+                  break;
+               case ADAS::ahatTSSignLaneMergeLeft:
+                  {
+                     sign = TrafficSign::tsLanesDec;
+                     int nCurLanes = getLanes(source, ahat) & 0x3f;
+                     nNumber = (1 == nCurLanes) ? 1 : nCurLanes - 1;
+                  }
+                  break;
+               case ADAS::ahatTSSignLaneMergeRight:
+                  {
+                     sign = TrafficSign::tsLanesDecRight;
+                     int nCurLanes = getLanes(source, ahat) & 0x3f;
+                     nNumber = (1 == nCurLanes) ? 1 : nCurLanes - 1;
+                  }
+                  break;
+               case ADAS::ahatTSSignLaneMergeCenter:
+                  sign = TrafficSign::tsLanesDecCenter;
+                  nNumber = getLanes(source, ahat) - 1;
+                  break;
+               case ADAS::ahatCustom3:
+                  sign = TrafficSign::tsFree;
+                  bRealSign = false;
+                  break;
+               default:
+                  break;
+            }
+            if (sign != TrafficSign::tsInvalid)
+            {
+               m_tsAreas.push_back(RVAreas(sign, nAreaStart, nAreaEnd, m_nMaxLanes, nNumber, nDistanceOrDuration, bDuration, bRealSign));
+            }
+         }
+      }
+      std::sort(m_tsAreas.begin(), m_tsAreas.end());
+
+      int iSign = 0;
+      while (iSign < (int) m_tsAreas.size() - 1) {
+         if (m_tsAreas[iSign].getStart() == m_tsAreas[iSign + 1].getStart()
+            && m_tsAreas[iSign].getSign() == m_tsAreas[iSign + 1].getSign()) {
+               m_tsAreas.erase(m_tsAreas.begin() + iSign + 1);
+         } else {
+            iSign++;
+         }
+      }
+   };
+
+   void getStartNbOfLanes(RVHorizonSource& source, std::vector<Uint32>& mpp)
+   {
+      Uint32 n = source.getAttributeCount();
+      m_bIsStartInTunnel = false;
+      m_bIsStartInRoundabout = false;
+
+      for (int i = n - 1; i > 0; i--)
+      {
+         ADAS::HorizonAttribute ahat;
+         Float64          fProbability;
+         Sint32           nDistCM = source.getNearestAttribute(i, &fProbability, &ahat);
+
+         if (isIdOnMPP(ahat.nLinkId, mpp) && (fProbability != 0) && (nDistCM < 0))
+         {
+            switch(ahat.type)
+            {
+               case ADAS::ahatNumberOfLanesFromSC:
+                  m_nStartNbOfLanes = ahat.info & 0xFFFFL;
+                  break;
+               case ADAS::ahatTunnel:
+                  m_bIsStartInTunnel = true;
+                  break;
+               case ADAS::ahatRoundabout:
+                  m_bIsStartInRoundabout = true;
+                  break;
+            }
+         }
+      }
+   };
+
+   RVSign::CrossingSideType getCrossingSide(RVHorizonSource& source, Uint32 nCurrentLinkId, std::vector<Uint32>& mpp, RVSign::ProhibitedSideType* nProhibitedSide)
+   {
+      RVSign::CrossingSideType nCrossingSide = RVSign::CROSSING_UNKNOWN;
+      std::vector<RVBranch> branches;
+      source.getBranches(nCurrentLinkId, branches);
+
+      for (size_t i = 0; i < branches.size(); i++)
+      {
+         const RVBranch& child = branches[i];
+         if (!isIdOnMPP(child.nLinkId, mpp))
+         {
+            int nChildTurnAngle = child.nTurnAngleDegrees;
+            if (nChildTurnAngle < 0)
+            {
+               nCrossingSide = nCrossingSide == RVSign::CROSSING_LEFT ? RVSign::CROSSING_LEFT:
+                               nCrossingSide == RVSign::CROSSING_UNKNOWN ? RVSign::CROSSING_LEFT:
+                               nCrossingSide == RVSign::CROSSING_RIGHT ? RVSign::CROSSING_BOTH:
+                               RVSign::CROSSING_BOTH;
+               if (child.fProbability == 0.0)
+               {
+                  *nProhibitedSide = *nProhibitedSide == RVSign::PROHIBITED_RIGHT ? RVSign::PROHIBITED_BOTH:
+                                     *nProhibitedSide == RVSign::PROHIBITED_BOTH ? RVSign::PROHIBITED_BOTH:
+                                      RVSign::PROHIBITED_LEFT;
+               }
+            }
+            if (nChildTurnAngle > 0)
+            {
+               nCrossingSide = nCrossingSide == RVSign::CROSSING_LEFT ? RVSign::CROSSING_BOTH:
+                               nCrossingSide == RVSign::CROSSING_UNKNOWN ? RVSign::CROSSING_RIGHT:
+                               nCrossingSide == RVSign::CROSSING_RIGHT ? RVSign::CROSSING_RIGHT:
+                               RVSign::CROSSING_BOTH;
+               if (child.fProbability == 0.0)
+               {
+                  *nProhibitedSide = *nProhibitedSide == RVSign::PROHIBITED_LEFT ? RVSign::PROHIBITED_BOTH:
+                                     *nProhibitedSide == RVSign::PROHIBITED_BOTH ? RVSign::PROHIBITED_BOTH:
+                                      RVSign::PROHIBITED_RIGHT;
+               }
+            }
+         }
+      }
+      return nCrossingSide;
+   };
+
+   bool isIdOnMPP(Uint32 nLinkId, std::vector<Uint32>& mpp)
+   {
+      return std::find(mpp.begin(), mpp.end(), nLinkId) != mpp.end();
+   };
+};
+
+
+static bool isSameSign(const RVSign& a, const RVSign& b)
+{
+   return (a.getSignLanes() == b.getSignLanes()) && (a.getSignLanesParam() == b.getSignLanesParam())
+       && (a.getSignCrossing() == b.getSignCrossing()) && (a.getSizeOfCrossing() == b.getSizeOfCrossing())
+       && (a.getDistanceToSignM() == b.getDistanceToSignM()) && (a.getCrossingSide() == b.getCrossingSide())
+       && (a.getProhibitedSide() == b.getProhibitedSide()) && (a.getLinkId() == b.getLinkId());
+}
+
+static bool isSameArea(const RVAreas& a, const RVAreas& b)
+{
+   return (a.getSign() == b.getSign()) && (a.getStart() == b.getStart()) && (a.getEnd() == b.getEnd())
+       && (a.getWidth() == b.getWidth()) && (a.getNumber() == b.getNumber())
+       && (a.getDistanceOrDuration() == b.getDistanceOrDuration()) && (a.isDuration() == b.isDuration())
+       && (a.isRealSign() == b.isRealSign());
+}
+
+static bool isSameAreas(const std::vector<RVAreas>& a, const std::vector<RVAreas>& b)
+{
+   if (a.size() != b.size())
+   {
+      return false;
+   }
+   for (size_t i = 0;  i < a.size();  i++)
+   {
+      if (!isSameArea(a[i], b[i]))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+static bool isSameModel(const RVReferenceModel& reference, const RVRoadModel& model)
+{
+   if (reference.m_signs.size() != model.signs.size())
+   {
+      return false;
+   }
+   for (size_t i = 0;  i < model.signs.size();  i++)
+   {
+      if (!isSameSign(reference.m_signs[i], model.signs[i]))
+      {
+         return false;
+      }
+   }
+   return isSameAreas(reference.m_areas, model.areas) && isSameAreas(reference.m_tsAreas, model.tsAreas)
+       && (reference.m_nStartNbOfLanes == model.nStartNbOfLanes) && (reference.m_nMaxLanes == model.nMaxLanes)
+       && (reference.m_bIsStartInTunnel == model.bIsStartInTunnel) && (reference.m_bIsStartInRoundabout == model.bIsStartInRoundabout);
+}
+
+// Drives on through the Horizon and compares the models after each update
+static void checkDrive(const RVSyntheticHorizon::Params& params, int nUpdates)
+{
+   RVSyntheticHorizon horizon;
+   horizon.generate(params);
+   RVReferenceModel reference;
+   RVRoadModelBuilder full, incremental;
+   Uint32 nRandom = params.nSeed;
+   int nDifferences = 0;
+   size_t nSigns = 0, nTSAreas = 0;
+   for (int nUpdate = 0;  nUpdate < nUpdates;  nUpdate++)
+   {
+      reference.update(horizon);
+      full.scanHorizon(horizon, true);
+      incremental.scanHorizon(horizon, false);
+      nDifferences += isSameModel(reference, full.getModel()) ? 0 : 1;
+      nDifferences += isSameModel(reference, incremental.getModel()) ? 0 : 1;
+      nSigns += reference.m_signs.size();
+      nTSAreas += reference.m_tsAreas.size();
+
+      nRandom = nRandom * 1103515245 + 12345;
+      horizon.advance(200 + (Sint32) ((nRandom >> 8) % (2 * params.nLinkLengthCM)));
+   }
+   RV_CHECK_EQUAL(0, nDifferences);
+   RV_CHECK(incremental.getModel().stats.nIncrementalUpdates > 0);
+   RV_CHECK(nSigns > (size_t) nUpdates);
+   RV_CHECK(nTSAreas > (size_t) nUpdates);
+}
+
+static void testDefaultHorizons()
+{
+   for (Uint32 nSeed = 1;  nSeed <= 20;  nSeed++)
+   {
+      RVSyntheticHorizon::Params params;
+      params.nLinks = 40;
+      params.nSeed = nSeed;
+      checkDrive(params, 50);
+   }
+}
+
+static void testDenseHorizons()
+{
+   RVSyntheticHorizon::Params params;
+   params.nLinks = 60;
+   params.nSignsPerLink = 4;
+   params.nLaneChangePercent = 40;
+   params.nCrossingPercent = 70;
+   params.nProhibitedPercent = 40;
+   params.nTunnelPercent = 15;
+   params.nRoundaboutPercent = 15;
+   params.nBranches = 3;
+   for (Uint32 nSeed = 100;  nSeed < 110;  nSeed++)
+   {
+      params.nSeed = nSeed;
+      params.bRightSideDrive = (nSeed % 2) == 0;
+      checkDrive(params, 50);
+   }
+}
+
+// All the Traffic Sign types, with short links: signs at the same distance and duplicates
+static void testAllSignTypes()
+{
+   RVSyntheticHorizon::Params params;
+   params.nLinks = 30;
+   params.nLinkLengthCM = 800;
+   params.nSignsPerLink = 6;
+   for (int nType = ADAS::ahatTSPedestrianXing;  nType <= ADAS::ahatCustom3;  nType++)
+   {
+      params.signTypes.push_back(nType);
+   }
+   for (Uint32 nSeed = 200;  nSeed < 210;  nSeed++)
+   {
+      params.nSeed = nSeed;
+      checkDrive(params, 50);
+   }
+}
+
+int main()
+{
+   testDefaultHorizons();
+   testDenseHorizons();
+   testAllSignTypes();
+   return RV_TEST_RESULT();
+}
@@ -0,0 +1,89 @@
+/**
+ * @file    test_rebuild_scheduler.cpp
+ * @brief   Checks the coalescing of the AH messages into rebuilds by RVRebuildScheduler.
+ * @version 0.1
+ * @date    16.10.2026.
+ */
+
+#include "RVTypes.h"
+#include "RVRebuildScheduler.h"
+#include "RVTest.h"
+
+// With no limit, each message is rebuilt
+static void testNoLimit()
+{
+   RVRebuildScheduler scheduler;
+   for (Uint32 nMs = 0;  nMs < 10;  nMs++)
+   {
+      RV_CHECK(scheduler.onMessage(false, nMs));
+      RV_CHECK(!scheduler.beginRebuild(nMs));
+   }
+   RV_CHECK_EQUAL(10, scheduler.getMessages());
+   RV_CHECK_EQUAL(10, scheduler.getRebuilds());
+   RV_CHECK_EQUAL(0, scheduler.getCoalesced());
+}
+
+// A burst is merged into one rebuild, which is due after the interval even if no message comes any more (the
+// flush of the timer of the view)
+static void testBurst()
+{
+   RVRebuildScheduler scheduler;
+   scheduler.setMaxRate(10);
+   RV_CHECK(scheduler.onMessage(false, 1000));
+   scheduler.beginRebuild(1000);
+   RV_CHECK(!scheduler.isDue(1000));
+   RV_CHECK(!scheduler.onMessage(false, 1010));
+   for (Uint32 nMs = 1020;  nMs < 1050;  nMs += 10)
+   {
+      RV_CHECK(!scheduler.onMessage(false, nMs));
+   }
+   RV_CHECK(scheduler.isPending());
+   RV_CHECK(!scheduler.isDue(1099));
+   RV_CHECK(scheduler.isDue(1100));
+   RV_CHECK(!scheduler.beginRebuild(1100));
+   RV_CHECK(!scheduler.isPending());
+   RV_CHECK(!scheduler.isDue(1300));
+   RV_CHECK_EQUAL(5, scheduler.getMessages());
+   RV_CHECK_EQUAL(2, scheduler.getRebuilds());
+   RV_CHECK_EQUAL(3, scheduler.getCoalesced());     // The 4 messages of the burst made one rebuild
+
+   // A message after a quiet period is rebuilt at once, and is not coalesced
+   RV_CHECK(scheduler.onMessage(false, 1400));
+   scheduler.beginRebuild(1400);
+   RV_CHECK_EQUAL(3, scheduler.getCoalesced());
+}
+
+// A Clear message merged into a burst makes the rebuild a full one
+static void testFullRebuildWins()
+{
+   RVRebuildScheduler scheduler;
+   scheduler.setMaxRate(10);
+   scheduler.onMessage(false, 0);
+   scheduler.beginRebuild(0);
+   scheduler.onMessage(false, 10);
+   scheduler.onMessage(true, 20);
+   scheduler.onMessage(false, 30);
+   RV_CHECK(scheduler.beginRebuild(100));
+   scheduler.onMessage(false, 210);
+   RV_CHECK(!scheduler.beginRebuild(210));
+}
+
+// The tick count wraps around after 49.7 days
+static void testWrapAround()
+{
+   RVRebuildScheduler scheduler;
+   scheduler.setMaxRate(10);
+   scheduler.onMessage(false, 0xFFFFFFF0);
+   scheduler.beginRebuild(0xFFFFFFF0);
+   RV_CHECK(!scheduler.onMessage(false, 0x10));
+   RV_CHECK(scheduler.isDue(0x54));
+}
+
+int main()
+{
+   testNoLimit();
+   testBurst();
+   testFullRebuildWins();
+   testWrapAround();
+   return RV_TEST_RESULT();
+}
@@ -0,0 +1,176 @@
+/**
+ * @file    test_recorder.cpp
+ * @brief   Checks that RVHorizonReplay reads back what RVHorizonRecorder wrote, also after a crash.
+ * @version 0.1
+ * @date    16.10.2026.
+ */
+
+#include "RVTypes.h"
+#include "RVHorizonRecorder.h"
+#include "RVHorizonReplay.h"
+#include "RVSyntheticHorizon.h"
+#include "RVTest.h"
+
+#include <vector>
+
+static const char* PATH = "test_recorder.rvhr";
+
+/** Records nRecords position messages of the car driving on */
+static void record(RVHorizonRecorder& recorder, RVSyntheticHorizon& horizon, int nRecords)
+{
+   for (int i = 0;  i < nRecords;  i++)
+   {
+      recorder.record(RVHorizonSnapshot::MSG_POSITION_CHANGED, 0, 1000 + i, horizon);
+      horizon.advance(2000);
+   }
+}
+
+static long getFileSize()
+{
+   FILE* pFile = fopen(PATH, "rb");
+   if (pFile == NULL)
+   {
+      return -1;
+   }
+   fseek(pFile, 0, SEEK_END);
+   long nSize = ftell(pFile);
+   fclose(pFile);
+   return nSize;
+}
+
+static void writeFile(const void* pData, size_t nSize)
+{
+   FILE* pFile = fopen(PATH, "wb");
+   fwrite(pData, 1, nSize, pFile);
+   fclose(pFile);
+}
+
+/** Returns the records of the file, -1 if it cannot be replayed */
+static int countRecords()
+{
+   RVHorizonReplay replay;
+   if (!replay.open(PATH))
+   {
+      return -1;
+   }
+   while (replay.next())
+   {
+   }
+   return (int) replay.getRecords();
+}
+
+// The replay answers as the recorded source did
+static void testReplay()
+{
+   remove(PATH);
+   RVSyntheticHorizon::Params params;
+   RVSyntheticHorizon horizon;
+   horizon.generate(params);
+   RVSyntheticHorizon expected;
+   expected.generate(params);
+
+   RVHorizonRecorder recorder;
+   RV_CHECK(recorder.open(PATH));
+   record(recorder, horizon, 10);
+   recorder.close();
+
+   RVHorizonReplay replay;
+   RV_CHECK(replay.open(PATH));
+   std::vector<Uint32> mppReplay;
+   std::vector<Uint32> mppExpected;
+   for (int i = 0;  i < 10;  i++, expected.advance(2000))
+   {
+      RV_CHECK(replay.next());
+      RV_CHECK_EQUAL(expected.getAttributeCount(), replay.getAttributeCount());
+      replay.getMostProbablePath(mppReplay);
+      expected.getMostProbablePath(mppExpected);
+      RV_CHECK(mppReplay == mppExpected);
+   }
+   RV_CHECK(!replay.next());
+}
+
+// Each record is in the file once record() returns
+static void testFlush()
+{
+   remove(PATH);
+   RVSyntheticHorizon::Params params;
+   RVSyntheticHorizon horizon;
+   horizon.generate(params);
+   RVHorizonRecorder recorder;
+   RV_CHECK(recorder.open(PATH));
+   record(recorder, horizon, 3);
+   RV_CHECK_EQUAL(recorder.getBytes(), getFileSize());
+   RV_CHECK_EQUAL(3, countRecords());
+}
+
+// A record cut by a crash is dropped: the records of the next session follow the last complete one
+static void testTornRecord()
+{
+   remove(PATH);
+   RVSyntheticHorizon::Params params;
+   RVSyntheticHorizon horizon;
+   horizon.generate(params);
+   {
+      RVHorizonRecorder recorder;
+      RV_CHECK(recorder.open(PATH));
+      record(recorder, horizon, 5);
+   }
+   long nComplete = getFileSize();
+   {
+      RVHorizonRecorder recorder;
+      RV_CHECK(recorder.open(PATH));
+      record(recorder, horizon, 1);
+   }
+
+   // Cut in the middle of the last record, then in its size prefix
+   for (long nCut = 1;  nCut <= 2;  nCut++)
+   {
+      long nSize = (nCut == 1) ? (nComplete + getFileSize()) / 2 : nComplete + 1;
+      std::vector<char> data(nSize);
+      FILE* pFile = fopen(PATH, "rb");
+      RV_CHECK(fread(&data[0], 1, nSize, pFile) == (size_t) nSize);
+      fclose(pFile);
+      writeFile(&data[0], nSize);
+      RV_CHECK_EQUAL(5, countRecords());
+
+      RVHorizonRecorder recorder;
+      RV_CHECK(recorder.open(PATH));
+      RV_CHECK_EQUAL(nComplete, getFileSize());
+      record(recorder, horizon, 3);
+      recorder.close();
+      RV_CHECK_EQUAL(8, countRecords());
+
+      // Back to the 5 records plus a torn one
+      writeFile(&data[0], nSize);
+   }
+}
+
+// A cut header is written again, another file is left alone
+static void testHeader()
+{
+   RVSyntheticHorizon::Params params;
+   RVSyntheticHorizon horizon;
+   horizon.generate(params);
+
+   writeFile("RVH", 3);
+   RVHorizonRecorder recorder;
+   RV_CHECK(recorder.open(PATH));
+   record(recorder, horizon, 2);
+   recorder.close();
+   RV_CHECK_EQUAL(2, countRecords());
+
+   writeFile("Hello", 5);
+   RV_CHECK(!recorder.open(PATH));
+   RV_CHECK(!recorder.isOpen());
+   RV_CHECK_EQUAL(5, getFileSize());
+}
+
+int main()
+{
+   testReplay();
+   testFlush();
+   testTornRecord();
+   testHeader();
+   remove(PATH);
+   return RV_TEST_RESULT();
+}